@@ -13,6 +13,12 @@
 #include "CFDP/Checksum/Checksum.hpp"
 #include "Fw/Types/Assert.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 static U32 min(const U32 a, const U32 b) {
     return (a < b) ? a : b;
 }
@@ -46,33 +52,67 @@ U32 Checksum ::getValue() const {
     return this->m_value;
 }
 
-void Checksum ::update(const U8* const data, const U32 offset, const U32 length) {
+void Checksum ::update(const U8* const data, const FwFileOffsetType offset, const U32 length) {
     U32 index = 0;
 
+    // Only the position of the data within its word depends on the offset, so the checksum is the same for any
+    // width of file offset
+    const U32 offsetMod4 = static_cast<U32>(offset % 4);
+
     // Add the first word unaligned if necessary
-    const U32 offsetMod4 = offset % 4;
     if (offsetMod4 != 0) {
         const U8 wordLength = static_cast<U8>(min(length, 4 - offsetMod4));
-        this->addWordUnaligned(&data[index], static_cast<U8>(offset + index), wordLength);
+        this->addWordUnaligned(&data[index], static_cast<U8>(offsetMod4 + index), wordLength);
         index += wordLength;
     }
 
     // Add the middle words aligned
-    for (; index + 4 <= length; index += 4) {
-        addWordAligned(&data[index]);
-    }
+    const U32 words = (length - index) / 4;
+    this->addWordsAligned(&data[index], words);
+    index += 4 * words;
 
     // Add the last word unaligned if necessary
     if (index < length) {
         const U8 wordLength = static_cast<U8>(length - index);
-        this->addWordUnaligned(&data[index], static_cast<U8>(offset + index), wordLength);
+        this->addWordUnaligned(&data[index], static_cast<U8>(offsetMod4 + index), wordLength);
     }
 }
 
-void Checksum ::addWordAligned(const U8* const word) {
-    for (U8 i = 0; i < 4; ++i) {
-        addByteAtOffset(word[i], i);
+void Checksum ::addWordsAligned(const U8* const words, const U32 count) {
+    // The checksum is the sum modulo 2^32 of the big endian words, so the words may be added in any grouping
+    U32 sum = 0;
+    U32 word = 0;
+#if defined(__SSE2__)
+    // Swap each word to its big endian value and add it to four 32-bit lanes, which wrap like the checksum
+    const __m128i lowBytes = _mm_set1_epi32(0x00FF00FF);
+    __m128i sums = _mm_setzero_si128();
+    for (; word + 4 <= count; word += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&words[4 * word]));
+        // Swap the bytes of each 16-bit half, then swap the halves
+        block = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(block, 8), lowBytes),
+                             _mm_andnot_si128(lowBytes, _mm_slli_epi16(block, 8)));
+        block = _mm_or_si128(_mm_srli_epi32(block, 16), _mm_slli_epi32(block, 16));
+        sums = _mm_add_epi32(sums, block);
+    }
+    U32 lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__ARM_NEON)
+    // Swap each word to its big endian value and accumulate pairs of words into 64-bit lanes
+    uint64x2_t sums = vdupq_n_u64(0);
+    for (; word + 4 <= count; word += 4) {
+        const uint8x16_t block = vld1q_u8(&words[4 * word]);
+        sums = vpadalq_u32(sums, vreinterpretq_u32_u8(vrev32q_u8(block)));
+    }
+    sum += static_cast<U32>(vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1));
+#endif
+    // Add the remaining words, loaded big endian
+    for (; word < count; word++) {
+        const U8* const bytes = &words[4 * word];
+        sum += (static_cast<U32>(bytes[0]) << 24) | (static_cast<U32>(bytes[1]) << 16) |
+               (static_cast<U32>(bytes[2]) << 8) | static_cast<U32>(bytes[3]);
     }
+    this->m_value += sum;
 }
 
 void Checksum ::addWordUnaligned(const U8* word, const U8 position, const U8 length) {
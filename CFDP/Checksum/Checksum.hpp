@@ -94,9 +94,9 @@ class Checksum {
     //!            file. Typically, therefore, `data` will be a pointer to the
     //!            byte given by the offset, e.g. `&file_buffer[offset]`.
     //!
-    void update(const U8* const data,  //!< Beginning of the data over which to update.
-                const U32 offset,      //!< Offset into the file at which the data begins.
-                const U32 length       //!< Length of the update data in bytes.
+    void update(const U8* const data,           //!< Beginning of the data over which to update.
+                const FwFileOffsetType offset,  //!< Offset into the file at which the data begins.
+                const U32 length                //!< Length of the update data in bytes.
     );
 
     //! Get the checksum value
@@ -107,8 +107,9 @@ class Checksum {
     // Private instance methods
     // ----------------------------------------------------------------------
 
-    //! Add a four-byte aligned word to the checksum value
-    void addWordAligned(const U8* const word  //! The word
+    //! Add consecutive four-byte aligned words to the checksum value
+    void addWordsAligned(const U8* const words,  //! The words
+                         const U32 count         //! The number of words
     );
 
     //! Add a four-byte unaligned word to the checksum value
@@ -5,6 +5,12 @@
 #include "gtest/gtest.h"
 
 #include "CFDP/Checksum/Checksum.hpp"
+#include "STest/Random/Random.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <vector>
 
 using namespace CFDP;
 
@@ -48,6 +54,108 @@ TEST(Checksum, ThreePackets) {
     ASSERT_EQ(expectedValue, checksum.getValue());
 }
 
+namespace {
+
+//! Reference checksum: add each byte at its position in the big endian window of its file offset
+U32 referenceChecksum(const U8* data, U32 offset, U32 length) {
+    U32 value = 0;
+    for (U32 i = 0; i < length; i++) {
+        value += static_cast<U32>(data[i]) << (8 * (3 - ((offset + i) % 4)));
+    }
+    return value;
+}
+
+std::vector<U8> randomData(U32 size) {
+    std::vector<U8> random(size);
+    for (U32 i = 0; i < size; i++) {
+        random[i] = static_cast<U8>(STest::Random::lowerUpper(0, 0xFF));
+    }
+    return random;
+}
+
+//! Size of a file downlink packet
+const U32 PACKET_CHUNK = 512;
+
+//! File contents that are cheap to generate at benchmark sizes
+std::vector<U8> fileData(U32 size) {
+    std::vector<U8> file(size);
+    for (U32 i = 0; i < size; i++) {
+        file[i] = static_cast<U8>(i * 2654435761U >> 24);
+    }
+    return file;
+}
+
+//! Checksum a file in chunks the size of a file downlink packet
+Checksum checksumChunks(const std::vector<U8>& file) {
+    Checksum checksum;
+    for (U32 offset = 0; offset < file.size(); offset += PACKET_CHUNK) {
+        checksum.update(&file[offset], offset, PACKET_CHUNK);
+    }
+    return checksum;
+}
+
+}  // namespace
+
+TEST(Checksum, MatchesReference) {
+    // Cover every length and file offset alignment around the word and vector block sizes
+    const std::vector<U8> random = randomData(300);
+    for (U32 length = 0; length <= 280; length++) {
+        for (U32 offset = 0; offset < 16; offset++) {
+            Checksum checksum;
+            checksum.update(&random[offset], offset, length);
+            ASSERT_EQ(referenceChecksum(&random[offset], offset, length), checksum.getValue())
+                << length << " " << offset;
+        }
+    }
+    // Random pieces of a file give the same checksum as a single update
+    const std::vector<U8> file = randomData(64 * 1024);
+    Checksum whole;
+    whole.update(file.data(), 0, static_cast<U32>(file.size()));
+    ASSERT_EQ(referenceChecksum(file.data(), 0, static_cast<U32>(file.size())), whole.getValue());
+    Checksum pieces;
+    U32 offset = 0;
+    while (offset < file.size()) {
+        const U32 pick = STest::Random::lowerUpper(1, 1000);
+        const U32 length = FW_MIN(static_cast<U32>(file.size()) - offset, pick);
+        pieces.update(&file[offset], offset, length);
+        offset += length;
+    }
+    ASSERT_EQ(whole, pieces);
+}
+
+TEST(Checksum, LargeOffsets) {
+    // The checksum depends only on the offset modulo 4, so data at the largest file offsets sums as near the start
+    const std::vector<U8> random = randomData(64);
+    const FwFileOffsetType last = std::numeric_limits<FwFileOffsetType>::max();
+    for (U32 offset = 0; offset < 4; offset++) {
+        const FwFileOffsetType large = last - (last % 4) - 4 + offset;
+        Checksum near;
+        near.update(random.data(), offset, 60);
+        Checksum far;
+        far.update(random.data(), large, 60);
+        ASSERT_EQ(near, far) << offset;
+    }
+}
+
+TEST(Checksum, PacketChunks) {
+    // A file checksummed in chunks the size of a file downlink packet matches the reference
+    const std::vector<U8> file = fileData(1024 * 1024);
+    const Checksum checksum = checksumChunks(file);
+    ASSERT_EQ(referenceChecksum(file.data(), 0, static_cast<U32>(file.size())), checksum.getValue());
+}
+
+// Throughput benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(Checksum, DISABLED_Throughput) {
+    const U32 FILE_SIZE = 256 * 1024 * 1024;
+    const std::vector<U8> file = fileData(FILE_SIZE);
+    const auto start = std::chrono::steady_clock::now();
+    const Checksum checksum = checksumChunks(file);
+    const std::chrono::duration<F64> elapsed = std::chrono::steady_clock::now() - start;
+    (void)printf("Checksum: %u MB in %u byte chunks at %.1f MB/s\n", FILE_SIZE / (1024 * 1024), PACKET_CHUNK,
+                 static_cast<F64>(FILE_SIZE) / elapsed.count() / 1.0e6);
+    ASSERT_EQ(referenceChecksum(file.data(), 0, FILE_SIZE), checksum.getValue());
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
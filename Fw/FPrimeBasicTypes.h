@@ -42,6 +42,7 @@ extern "C" {
 #include <config/FwDpPriorityTypeAliasAc.h>
 #include <config/FwEnumStoreTypeAliasAc.h>
 #include <config/FwEventIdTypeAliasAc.h>
+#include <config/FwFileOffsetTypeAliasAc.h>
 #include <config/FwIdTypeAliasAc.h>
 #include <config/FwOpcodeTypeAliasAc.h>
 #include <config/FwPacketDescriptorTypeAliasAc.h>
@@ -108,5 +108,8 @@ static_assert(std::numeric_limits<FwSignedSizeType>::is_signed, "FwSignedSizeTyp
 static_assert(std::numeric_limits<FwSizeType>::max() >= std::numeric_limits<U32>::max(),
               "FwSizeType must be at least as large as U32");
 static_assert(sizeof(FwSizeType) == sizeof(FwSignedSizeType), "FwSizeType must be the same size as FwSignedSizeType");
+static_assert(not std::numeric_limits<FwFileOffsetType>::is_signed, "FwFileOffsetType must be unsigned");
+static_assert(std::numeric_limits<FwFileOffsetType>::max() >= std::numeric_limits<U32>::max(),
+              "FwFileOffsetType must be at least as large as U32");
 
 #endif  // FW_TYPES_HPP
@@ -16,7 +16,7 @@
 namespace Fw {
 
 void FilePacket::DataPacket ::initialize(const U32 sequenceIndex,
-                                         const U32 byteOffset,
+                                         const FwFileOffsetType byteOffset,
                                          const U16 dataSize,
                                          const U8* const data) {
     this->m_header.initialize(FilePacket::T_DATA, sequenceIndex);
@@ -126,7 +126,7 @@ union FilePacket {
         Header m_header;
 
         //! The file size
-        U32 m_fileSize;
+        FwFileOffsetType m_fileSize;
 
         //! The source path
         PathName m_sourcePath;
@@ -136,7 +136,7 @@ union FilePacket {
 
       public:
         //! Initialize a StartPacket with sequence number 0
-        void initialize(const U32 fileSize,                //!< The file size
+        void initialize(const FwFileOffsetType fileSize,   //!< The file size
                         const char* const sourcePath,      //!< The source path
                         const char* const destinationPath  //!< The destination path
         );
@@ -157,7 +157,7 @@ union FilePacket {
         const PathName& getSourcePath() const { return this->m_sourcePath; };
 
         //! Get the file size
-        U32 getFileSize() const { return this->m_fileSize; };
+        FwFileOffsetType getFileSize() const { return this->m_fileSize; };
 
       private:
         //! Initialize this StartPacket from a SerialBuffer
@@ -178,7 +178,7 @@ union FilePacket {
         Header m_header;
 
         //! The byte offset of the packet data into the destination file
-        U32 m_byteOffset;
+        FwFileOffsetType m_byteOffset;
 
         //! The size of the file data in the packet
         U16 m_dataSize;
@@ -188,13 +188,13 @@ union FilePacket {
 
       public:
         //! header size
-        enum { HEADERSIZE = Header::HEADERSIZE + sizeof(U32) + sizeof(U16) };
+        enum { HEADERSIZE = Header::HEADERSIZE + sizeof(FwFileOffsetType) + sizeof(U16) };
 
         //! Initialize a data packet
-        void initialize(const U32 sequenceIndex,  //!< The sequence index
-                        const U32 byteOffset,     //!< The byte offset
-                        const U16 dataSize,       //!< The data size
-                        const U8* const data      //!< The file data
+        void initialize(const U32 sequenceIndex,            //!< The sequence index
+                        const FwFileOffsetType byteOffset,  //!< The byte offset
+                        const U16 dataSize,                 //!< The data size
+                        const U8* const data                //!< The file data
         );
 
         //! Compute the buffer size needed to hold this DataPacket
@@ -207,7 +207,7 @@ union FilePacket {
         const FilePacket::Header& asHeader() const { return this->m_header; };
 
         //! Get the byte offset
-        U32 getByteOffset() const { return this->m_byteOffset; };
+        FwFileOffsetType getByteOffset() const { return this->m_byteOffset; };
 
         //! Get the data size
         U32 getDataSize() const { return this->m_dataSize; };
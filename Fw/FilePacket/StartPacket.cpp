@@ -15,7 +15,7 @@
 
 namespace Fw {
 
-void FilePacket::StartPacket ::initialize(const U32 fileSize,
+void FilePacket::StartPacket ::initialize(const FwFileOffsetType fileSize,
                                           const char* const sourcePath,
                                           const char* const destinationPath) {
     this->m_header.initialize(FilePacket::T_START, 0);
@@ -9,6 +9,8 @@
 #include <Fw/FilePacket/GTest/FilePackets.hpp>
 #include <Fw/Types/Assert.hpp>
 
+#include <limits>
+
 namespace Fw {
 
 class FilePacketTester {
@@ -103,6 +105,31 @@ TEST(FilePacket, DataPacket) {
     GTest::FilePackets::DataPacket::compare(expected, actualDataPacket);
 }
 
+// Serialize and deserialize the largest file size and byte offset of the configured offset type
+TEST(FilePacket, LargeOffsets) {
+    const FwFileOffsetType largest = std::numeric_limits<FwFileOffsetType>::max();
+    FilePacket::StartPacket expectedStart;
+    expectedStart.initialize(largest, "source", "dest");
+    U8 startBytes[64];
+    Buffer startBuffer(startBytes, expectedStart.bufferSize());
+    ASSERT_EQ(expectedStart.toBuffer(startBuffer), FW_SERIALIZE_OK);
+    FilePacket actualStart;
+    ASSERT_EQ(actualStart.fromBuffer(startBuffer), FW_SERIALIZE_OK);
+    GTest::FilePackets::StartPacket::compare(expectedStart, actualStart.asStartPacket());
+
+    FilePacket::DataPacket expectedData;
+    const U16 dataSize = 4;
+    U8 data[dataSize] = {1, 2, 3, 4};
+    expectedData.initialize(7, largest - dataSize, dataSize, data);
+    ASSERT_EQ(expectedData.bufferSize(), static_cast<U32>(FilePacket::DataPacket::HEADERSIZE) + dataSize);
+    U8 dataBytes[64];
+    Buffer dataBuffer(dataBytes, expectedData.bufferSize());
+    ASSERT_EQ(expectedData.toBuffer(dataBuffer), FW_SERIALIZE_OK);
+    FilePacket actualData;
+    ASSERT_EQ(actualData.fromBuffer(dataBuffer), FW_SERIALIZE_OK);
+    GTest::FilePackets::DataPacket::compare(expectedData, actualData.asDataPacket());
+}
+
 // Serialize and deserialize an end packet
 TEST(FilePacket, EndPacket) {
     FilePacket::EndPacket expected;
@@ -0,0 +1,107 @@
+// ======================================================================
+// \title  BufferedFile.cpp
+// \brief  Os::BufferedFile implementation
+// ======================================================================
+
+#include "Os/BufferedFile.hpp"
+#include <cstring>
+#include "Fw/Types/Assert.hpp"
+
+namespace Os {
+
+constexpr FwSizeType BufferedFile::CAPACITY;
+static_assert(BufferedFile::CAPACITY > 0, "FW_FILE_WRITE_BUFFER_SIZE must be positive");
+
+BufferedFile ::BufferedFile() : m_file(), m_blockSize(CAPACITY), m_used(0), m_wait(File::WaitType::NO_WAIT) {}
+
+BufferedFile ::~BufferedFile() {
+    (void)this->close();
+}
+
+void BufferedFile ::setBlockSize(const FwSizeType blockSize) {
+    FW_ASSERT(blockSize <= CAPACITY, static_cast<FwAssertArgType>(blockSize));
+    FW_ASSERT(this->m_used == 0, static_cast<FwAssertArgType>(this->m_used));
+    this->m_blockSize = blockSize;
+}
+
+FwSizeType BufferedFile ::getBlockSize() const {
+    return this->m_blockSize;
+}
+
+FwSizeType BufferedFile ::getBufferedSize() const {
+    return this->m_used;
+}
+
+File::Status BufferedFile ::open(const char* const path, const File::Mode mode) {
+    const File::Status status = this->m_file.open(path, mode);
+    if (status == File::OP_OK) {
+        this->m_used = 0;
+        this->m_wait = File::WaitType::NO_WAIT;
+    }
+    return status;
+}
+
+bool BufferedFile ::isOpen() const {
+    return this->m_file.isOpen();
+}
+
+File::Status BufferedFile ::write(const U8* const data, FwSizeType& size, const File::WaitType wait) {
+    FW_ASSERT(data != nullptr);
+    const FwSizeType requested = size;
+    size = 0;
+    if (not this->m_file.isOpen()) {
+        return File::NOT_OPENED;
+    }
+    // Make room for the data, or write out the buffered bytes ahead of data too large to buffer
+    if (requested > this->m_blockSize - this->m_used) {
+        const File::Status status = this->writeBlock();
+        if (status != File::OP_OK) {
+            return status;
+        }
+    }
+    if (requested >= this->m_blockSize) {
+        size = requested;
+        return this->m_file.write(data, size, wait);
+    }
+    (void)::memcpy(&this->m_buffer[this->m_used], data, static_cast<size_t>(requested));
+    this->m_used += requested;
+    if (wait == File::WaitType::WAIT) {
+        this->m_wait = File::WaitType::WAIT;
+    }
+    size = requested;
+    return File::OP_OK;
+}
+
+File::Status BufferedFile ::flush() {
+    File::Status status = this->writeBlock();
+    if (status == File::OP_OK) {
+        status = this->m_file.flush();
+    }
+    return status;
+}
+
+File::Status BufferedFile ::close() {
+    File::Status status = File::OP_OK;
+    if (this->m_file.isOpen()) {
+        status = this->writeBlock();
+        this->m_file.close();
+    }
+    return status;
+}
+
+File::Status BufferedFile ::writeBlock() {
+    File::Status status = File::OP_OK;
+    if (this->m_used > 0) {
+        FwSizeType size = this->m_used;
+        status = this->m_file.write(this->m_buffer, size, this->m_wait);
+        // A write that stops short without an error has run out of space
+        if ((status == File::OP_OK) && (size != this->m_used)) {
+            status = File::NO_SPACE;
+        }
+        this->m_used = 0;
+        this->m_wait = File::WaitType::NO_WAIT;
+    }
+    return status;
+}
+
+}  // namespace Os
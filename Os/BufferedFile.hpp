@@ -0,0 +1,101 @@
+// ======================================================================
+// \title  BufferedFile.hpp
+// \brief  A file that gathers small writes into blocks
+// ======================================================================
+
+#ifndef OS_BufferedFile_HPP
+#define OS_BufferedFile_HPP
+
+#include <Fw/FPrimeBasicTypes.hpp>
+#include "Os/File.hpp"
+
+namespace Os {
+
+//! \class BufferedFile
+//! \brief A file opened for writing that gathers small writes into blocks
+//!
+//! Writers that produce many small records, such as a length prefix followed by a packet, would otherwise make one
+//! Os::File::write call per record. BufferedFile copies such writes into a block of up to FW_FILE_WRITE_BUFFER_SIZE
+//! bytes and writes the block to the file when the next write does not fit, on flush, and on close. Writes at least
+//! as large as the block go straight to the file after any buffered bytes.
+//!
+//! A write reports success once its data is in the block. When a block later fails to reach the file its bytes are
+//! lost and the failure is reported by the write, writeBlock, flush, or close that wrote the block. Buffered bytes do
+//! not survive a reset, so writers call writeBlock at the end of each record, or on their own policy, to bound what
+//! a reset loses.
+class BufferedFile {
+  public:
+    //! Size of the block storage
+    static constexpr FwSizeType CAPACITY = FW_FILE_WRITE_BUFFER_SIZE;
+
+    //! Construct a closed buffered file using the full block storage
+    BufferedFile();
+
+    //! Destroy the buffered file, writing any buffered bytes and closing the file
+    ~BufferedFile();
+
+  public:
+    //! Set the block size. A block size of zero passes each write straight to the file. Must be called while no
+    //! bytes are buffered.
+    void setBlockSize(const FwSizeType blockSize  //!< The block size, at most CAPACITY
+    );
+
+    //! Get the block size
+    //! \return The block size
+    FwSizeType getBlockSize() const;
+
+    //! Get the number of bytes buffered but not yet written to the file
+    //! \return The number of bytes buffered
+    FwSizeType getBufferedSize() const;
+
+  public:
+    //! Open the file. Opening a file that is already open fails as for Os::File.
+    //! \return The status of the open
+    File::Status open(const char* const path,  //!< The path of the file
+                      const File::Mode mode    //!< The mode, normally OPEN_WRITE or OPEN_CREATE
+    );
+
+    //! Check whether the file is open
+    //! \return true if the file is open
+    bool isOpen() const;
+
+    //! Write data to the file through the block. WAIT is honored when the block holding the data is written.
+    //! \return OP_OK when all of the data was accepted, otherwise the status of the failed file write
+    File::Status write(const U8* const data,      //!< The data to write
+                       FwSizeType& size,          //!< The size to write; updated to the size accepted
+                       const File::WaitType wait  //!< Whether to wait for the data to reach storage
+    );
+
+    //! Write the buffered bytes to the file without flushing the file to storage. A WAIT request of a buffered write
+    //! is honored. The bytes are discarded whether or not the write succeeds.
+    //! \return The status of the write
+    File::Status writeBlock();
+
+    //! Write the buffered bytes to the file and flush the file to storage
+    //! \return The status of the write or of the flush
+    File::Status flush();
+
+    //! Write the buffered bytes to the file and close it. Closing a file that is not open does nothing.
+    //! \return The status of writing the buffered bytes
+    File::Status close();
+
+  private:
+    //! The file written
+    File m_file;
+
+    //! The block size
+    FwSizeType m_blockSize;
+
+    //! The number of bytes buffered
+    FwSizeType m_used;
+
+    //! Whether a write of the buffered bytes asked to wait for storage
+    File::WaitType m_wait;
+
+    //! The block storage
+    U8 m_buffer[CAPACITY];
+};
+
+}  // namespace Os
+
+#endif
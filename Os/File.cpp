@@ -5,11 +5,49 @@
 #include <Fw/Types/Assert.hpp>
 #include <Os/File.hpp>
 
-extern "C" {
-#include <Utils/Hash/libcrc/lib_crc.h>  // borrow CRC
-}
+#include <Utils/Hash/libcrc/CRC32Engine.hpp>  // borrow CRC
 namespace Os {
 
+FileInterface::Status FileInterface::readAt(U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) {
+    FwSizeType original = 0;
+    if (offset > static_cast<FwSizeType>(std::numeric_limits<FwSignedSizeType>::max())) {
+        size = 0;
+        return Status::BAD_SIZE;
+    }
+    Status status = this->position(original);
+    if (status == Status::OP_OK) {
+        status = this->seek(static_cast<FwSignedSizeType>(offset), SeekType::ABSOLUTE);
+    }
+    if (status != Status::OP_OK) {
+        size = 0;
+        return status;
+    }
+    status = this->read(buffer, size, wait);
+    // Restore the file pointer, keeping the read status when both fail
+    const Status restore = this->seek(static_cast<FwSignedSizeType>(original), SeekType::ABSOLUTE);
+    return (status == Status::OP_OK) ? restore : status;
+}
+
+FileInterface::Status FileInterface::writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) {
+    FwSizeType original = 0;
+    if (offset > static_cast<FwSizeType>(std::numeric_limits<FwSignedSizeType>::max())) {
+        size = 0;
+        return Status::BAD_SIZE;
+    }
+    Status status = this->position(original);
+    if (status == Status::OP_OK) {
+        status = this->seek(static_cast<FwSignedSizeType>(offset), SeekType::ABSOLUTE);
+    }
+    if (status != Status::OP_OK) {
+        size = 0;
+        return status;
+    }
+    status = this->write(buffer, size, wait);
+    // Restore the file pointer, keeping the write status when both fail
+    const Status restore = this->seek(static_cast<FwSignedSizeType>(original), SeekType::ABSOLUTE);
+    return (status == Status::OP_OK) ? restore : status;
+}
+
 File::File() : m_crc_buffer(), m_handle_storage(), m_delegate(*FileInterface::getDelegate(m_handle_storage)) {
     FW_ASSERT(&this->m_delegate == reinterpret_cast<FileInterface*>(&this->m_handle_storage[0]));
 }
@@ -203,6 +241,44 @@ File::Status File::write(const U8* buffer, FwSizeType& size, File::WaitType wait
     return this->m_delegate.write(buffer, size, wait);
 }
 
+File::Status File::readAt(U8* buffer, FwSizeType& size, FwSizeType offset) {
+    return this->readAt(buffer, size, offset, WaitType::WAIT);
+}
+
+File::Status File::readAt(U8* buffer, FwSizeType& size, FwSizeType offset, File::WaitType wait) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<FileInterface*>(&this->m_handle_storage[0]));
+    FW_ASSERT(buffer != nullptr);
+    FW_ASSERT(this->m_mode < Mode::MAX_OPEN_MODE);
+    // Check that the file is open before attempting operation
+    if (OPEN_NO_MODE == this->m_mode) {
+        size = 0;
+        return File::Status::NOT_OPENED;
+    } else if (OPEN_READ != this->m_mode) {
+        size = 0;
+        return File::Status::INVALID_MODE;
+    }
+    return this->m_delegate.readAt(buffer, size, offset, wait);
+}
+
+File::Status File::writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset) {
+    return this->writeAt(buffer, size, offset, WaitType::WAIT);
+}
+
+File::Status File::writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset, File::WaitType wait) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<FileInterface*>(&this->m_handle_storage[0]));
+    FW_ASSERT(buffer != nullptr);
+    FW_ASSERT(this->m_mode < Mode::MAX_OPEN_MODE);
+    // Check that the file is open before attempting operation. Appending files cannot be written at an offset.
+    if (OPEN_NO_MODE == this->m_mode) {
+        size = 0;
+        return File::Status::NOT_OPENED;
+    } else if ((OPEN_READ == this->m_mode) || (OPEN_APPEND == this->m_mode)) {
+        size = 0;
+        return File::Status::INVALID_MODE;
+    }
+    return this->m_delegate.writeAt(buffer, size, offset, wait);
+}
+
 FileHandle* File::getHandle() {
     FW_ASSERT(&this->m_delegate == reinterpret_cast<FileInterface*>(&this->m_handle_storage[0]));
     return this->m_delegate.getHandle();
@@ -237,9 +313,8 @@ File::Status File::incrementalCrc(FwSizeType& size) {
         // Read data without waiting for additional data to be available
         status = this->read(this->m_crc_buffer, size, File::WaitType::NO_WAIT);
         if (OP_OK == status) {
-            for (FwSizeType i = 0; i < size && i < FW_FILE_CHUNK_SIZE; i++) {
-                this->m_crc = static_cast<U32>(update_crc_32(this->m_crc, static_cast<CHAR>(this->m_crc_buffer[i])));
-            }
+            // Size was checked against the buffer size above and read never reads more than requested
+            this->m_crc = Utils::CRC32Engine::update(this->m_crc, this->m_crc_buffer, size);
         }
     }
     return status;
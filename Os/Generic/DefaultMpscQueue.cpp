@@ -0,0 +1,13 @@
+// ======================================================================
+// \title Os/Generic/DefaultMpscQueue.cpp
+// \brief sets default Os::Queue to generic lock-free MPSC queue implementation via linker
+// ======================================================================
+#include "Os/Delegate.hpp"
+#include "Os/Generic/MpscQueue.hpp"
+#include "Os/Queue.hpp"
+
+namespace Os {
+QueueInterface* QueueInterface::getDelegate(QueueHandleStorage& aligned_new_memory) {
+    return Os::Delegate::makeDelegate<QueueInterface, Os::Generic::MpscQueue, QueueHandleStorage>(aligned_new_memory);
+}
+}  // namespace Os
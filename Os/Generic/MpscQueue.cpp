@@ -0,0 +1,465 @@
+// ======================================================================
+// \title Os/Generic/MpscQueue.cpp
+// \brief lock-free multi-producer single-consumer queue implementation for Os::Queue
+// ======================================================================
+#include "Os/Generic/MpscQueue.hpp"
+#include <cstring>
+#include "Fw/LanguageHelpers.hpp"
+#include "Fw/Types/Assert.hpp"
+#include "Fw/Types/MemAllocator.hpp"
+#include "config/MemoryAllocatorTypeEnumAc.hpp"
+
+namespace Os {
+namespace Generic {
+
+const FwQueuePriorityType MpscQueue::PRIORITY;
+
+MpscQueue::~MpscQueue() {}
+
+QueueInterface::Status MpscQueue::create(FwEnumStoreType id,
+                                         const Fw::ConstStringBase& name,
+                                         FwSizeType depth,
+                                         FwSizeType messageSize) {
+    const FwEnumStoreType identifier = id;
+    QueueInterface::Status status = Os::QueueInterface::Status::OP_OK;
+    // Ensure we are created exactly once
+    FW_ASSERT(this->m_handle.m_slots == nullptr);
+    FW_ASSERT(this->m_handle.m_data == nullptr);
+    FW_ASSERT(this->m_delegate == nullptr);
+
+    // Round the slot count up to a power of two so positions map to slots with a mask
+    FwSizeType slotCount = 1;
+    while (slotCount < depth) {
+        FW_ASSERT(slotCount <= (std::numeric_limits<FwSizeType>::max() / 2), static_cast<FwAssertArgType>(depth));
+        slotCount *= 2;
+    }
+
+    // Get the memory allocator configured for queues
+    Fw::MemAllocator& allocator = Fw::MemAllocatorRegistry::getInstance().getAnAllocator(
+        Fw::MemoryAllocation::MemoryAllocatorType::OS_GENERIC_PRIORITY_QUEUE);
+
+    void* allocation = nullptr;
+    FwSizeType size = 0;
+    MpscQueueSlot* slots = nullptr;
+    U8* data = nullptr;
+
+    // Allocate slot bookkeeping and construct it when valid
+    size = slotCount * sizeof(MpscQueueSlot);
+    allocation = allocator.allocate(identifier, size, alignof(MpscQueueSlot));
+    if (allocation == nullptr) {
+        status = QueueInterface::Status::ALLOCATION_FAILED;
+    } else if (size < (slotCount * sizeof(MpscQueueSlot))) {
+        allocator.deallocate(identifier, allocation);
+        status = QueueInterface::Status::ALLOCATION_FAILED;
+    } else {
+        slots = Fw::arrayPlacementNew<MpscQueueSlot>(Fw::ByteArray(static_cast<U8*>(allocation), size), slotCount);
+    }
+    // Allocate data, followed by one pending count per delegate queue index
+    if (status == QueueInterface::Status::OP_OK) {
+        size = (slotCount * messageSize) + depth;
+        allocation = allocator.allocate(identifier, size, alignof(U8));
+        if (allocation == nullptr) {
+            allocator.deallocate(identifier, slots);
+            status = QueueInterface::Status::ALLOCATION_FAILED;
+        } else if (size < ((slotCount * messageSize) + depth)) {
+            allocator.deallocate(identifier, slots);
+            allocator.deallocate(identifier, allocation);
+            status = QueueInterface::Status::ALLOCATION_FAILED;
+        } else {
+            data = static_cast<U8*>(allocation);
+        }
+    }
+    // Allocate and create the queue for other priorities
+    PriorityQueue* delegate = nullptr;
+    if (status == QueueInterface::Status::OP_OK) {
+        size = sizeof(PriorityQueue);
+        allocation = allocator.allocate(identifier, size, alignof(PriorityQueue));
+        if (allocation == nullptr) {
+            status = QueueInterface::Status::ALLOCATION_FAILED;
+        } else if (size < sizeof(PriorityQueue)) {
+            allocator.deallocate(identifier, allocation);
+            status = QueueInterface::Status::ALLOCATION_FAILED;
+        } else {
+            delegate = Fw::arrayPlacementNew<PriorityQueue>(Fw::ByteArray(static_cast<U8*>(allocation), size), 1);
+            status = delegate->create(id, name, depth, messageSize);
+            if (status != QueueInterface::Status::OP_OK) {
+                Fw::arrayPlacementDestruct(delegate, 1);
+                allocator.deallocate(identifier, delegate);
+            }
+        }
+        if (status != QueueInterface::Status::OP_OK) {
+            allocator.deallocate(identifier, slots);
+            allocator.deallocate(identifier, data);
+        }
+    }
+    // Set up structures when all allocations succeeded
+    if (status == QueueInterface::Status::OP_OK) {
+        for (FwSizeType i = 0; i < slotCount; i++) {
+            // slot i is free for position i
+            slots[i].m_sequence.store(i, std::memory_order_relaxed);
+            slots[i].m_size = 0;
+            slots[i].m_index = 0;
+        }
+        for (FwSizeType i = 0; i < depth; i++) {
+            data[(slotCount * messageSize) + i] = 0;
+        }
+        this->m_handle.m_id = id;
+        this->m_handle.m_slots = slots;
+        this->m_handle.m_data = data;
+        this->m_handle.m_pending = data + (slotCount * messageSize);
+        this->m_delegate = delegate;
+        this->m_handle.m_depth = depth;
+        this->m_handle.m_mask = slotCount - 1;
+        this->m_handle.m_maxSize = messageSize;
+        this->m_handle.m_enqueuePosition.store(0, std::memory_order_relaxed);
+        this->m_handle.m_dequeuePosition = 0;
+        this->m_handle.m_count.store(0, std::memory_order_relaxed);
+        this->m_handle.m_highMark.store(0, std::memory_order_relaxed);
+        this->m_handle.m_delegated.store(0, std::memory_order_relaxed);
+        this->m_handle.m_urgent.store(0, std::memory_order_relaxed);
+        this->m_handle.m_peeked = false;
+        this->m_handle.m_peekedDelegated = false;
+        // Publish the setup to tasks started after create returns
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    return status;
+}
+
+void MpscQueue::teardown() {
+    this->teardownInternal();
+}
+
+void MpscQueue::teardownInternal() {
+    if (this->m_handle.m_data != nullptr) {
+        const FwEnumStoreType identifier = this->m_handle.m_id;
+        Fw::MemAllocator& allocator = Fw::MemAllocatorRegistry::getInstance().getAnAllocator(
+            Fw::MemoryAllocation::MemoryAllocatorType::OS_GENERIC_PRIORITY_QUEUE);
+        allocator.deallocate(identifier, this->m_handle.m_data);
+        allocator.deallocate(identifier, this->m_handle.m_slots);
+        this->m_delegate->teardown();
+        Fw::arrayPlacementDestruct(this->m_delegate, 1);
+        allocator.deallocate(identifier, this->m_delegate);
+
+        // Set these pointers to nullptr
+        this->m_handle.m_data = nullptr;
+        this->m_handle.m_pending = nullptr;
+        this->m_handle.m_slots = nullptr;
+        this->m_delegate = nullptr;
+    }
+}
+
+QueueInterface::Status MpscQueue::reserveRoom(QueueInterface::BlockingType blockType) {
+    FwSizeType count = this->m_handle.m_count.load(std::memory_order_relaxed);
+    while (true) {
+        if (count < this->m_handle.m_depth) {
+            if (this->m_handle.m_count.compare_exchange_weak(count, count + 1, std::memory_order_acquire,
+                                                             std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (blockType == BlockingType::NONBLOCKING) {
+            return QueueInterface::Status::FULL;
+        } else {
+            // Register as waiting before the final check so that the receiver either sees the registration or this
+            // task sees the freed space
+            Os::ScopeLock lock(this->m_handle.m_wait_lock);
+            this->m_handle.m_sendersWaiting.fetch_add(1, std::memory_order_seq_cst);
+            while (this->m_handle.m_count.load(std::memory_order_seq_cst) >= this->m_handle.m_depth) {
+                this->m_handle.m_full.wait(this->m_handle.m_wait_lock);
+            }
+            this->m_handle.m_sendersWaiting.fetch_sub(1, std::memory_order_relaxed);
+            count = this->m_handle.m_count.load(std::memory_order_relaxed);
+        }
+    }
+    // Raise the high water mark to include this message
+    FwSizeType highMark = this->m_handle.m_highMark.load(std::memory_order_relaxed);
+    while ((count + 1 > highMark) and
+           (not this->m_handle.m_highMark.compare_exchange_weak(highMark, count + 1, std::memory_order_relaxed))) {
+    }
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status MpscQueue::reserve(QueueInterface::BlockingType blockType,
+                                          U8*& slot,
+                                          FwSizeType& capacity,
+                                          FwSizeType& token) {
+    const QueueInterface::Status status = this->reserveRoom(blockType);
+    if (status != QueueInterface::Status::OP_OK) {
+        return status;
+    }
+    const FwSizeType position = this->m_handle.m_enqueuePosition.fetch_add(1, std::memory_order_relaxed);
+    const FwSizeType index = position & this->m_handle.m_mask;
+    // Room is reserved, so the receiver has already read the previous message in this slot. The acquire load pairs
+    // with the receiver's release of the slot; it succeeds on the first pass unless the receiver is mid-release.
+    while (this->m_handle.m_slots[index].m_sequence.load(std::memory_order_acquire) != position) {
+    }
+    slot = this->m_handle.m_data + (index * this->m_handle.m_maxSize);
+    capacity = this->m_handle.m_maxSize;
+    token = position;
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status MpscQueue::commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) {
+    if (size > this->m_handle.m_maxSize) {
+        return QueueInterface::Status::SIZE_MISMATCH;
+    }
+    MpscQueueSlot& slot = this->m_handle.m_slots[token & this->m_handle.m_mask];
+    FW_ASSERT(slot.m_sequence.load(std::memory_order_relaxed) == token, static_cast<FwAssertArgType>(token));
+    if (priority == PRIORITY) {
+        slot.m_size = size;
+    } else {
+        // Move the message to the delegate queue and publish the slot for the receiver to skip
+        slot.m_index =
+            this->delegate(this->m_handle.m_data + ((token & this->m_handle.m_mask) * this->m_handle.m_maxSize), size,
+                           priority, true);
+        slot.m_size = DELEGATED;
+    }
+    this->publishSlot(token);
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status MpscQueue::abort(FwSizeType token) {
+    MpscQueueSlot& slot = this->m_handle.m_slots[token & this->m_handle.m_mask];
+    FW_ASSERT(slot.m_sequence.load(std::memory_order_relaxed) == token, static_cast<FwAssertArgType>(token));
+    // Publish the slot empty for the receiver to skip, which frees its room
+    slot.m_size = ABORTED;
+    this->publishSlot(token);
+    return QueueInterface::Status::OP_OK;
+}
+
+void MpscQueue::publishSlot(FwSizeType token) {
+    this->m_handle.m_slots[token & this->m_handle.m_mask].m_sequence.store(token + 1, std::memory_order_release);
+
+    // Wake the receiver only when it is parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->m_handle.m_receiverWaiting.load(std::memory_order_relaxed)) {
+        Os::ScopeLock lock(this->m_handle.m_wait_lock);
+        this->m_handle.m_empty.notify();
+    }
+}
+
+QueueInterface::Status MpscQueue::send(const U8* buffer,
+                                       FwSizeType size,
+                                       FwQueuePriorityType priority,
+                                       QueueInterface::BlockingType blockType) {
+    // Check arguments before reserving so that a reservation is always committed
+    if (size > this->m_handle.m_maxSize) {
+        return QueueInterface::Status::SIZE_MISMATCH;
+    }
+    if (priority != PRIORITY) {
+        const QueueInterface::Status status = this->reserveRoom(blockType);
+        if (status == QueueInterface::Status::OP_OK) {
+            (void)this->delegate(buffer, size, priority, false);
+        }
+        return status;
+    }
+    U8* slot = nullptr;
+    FwSizeType capacity = 0;
+    FwSizeType token = 0;
+    const QueueInterface::Status status = this->reserve(blockType, slot, capacity, token);
+    if (status != QueueInterface::Status::OP_OK) {
+        return status;
+    }
+    (void)::memcpy(slot, buffer, static_cast<size_t>(size));
+    return this->commit(token, size, priority);
+}
+
+FwSizeType MpscQueue::delegate(const U8* buffer, FwSizeType size, FwQueuePriorityType priority, bool fromSlot) {
+    // The delegate queue is updated and counted under the wait lock so the receiver sees both together
+    Os::ScopeLock lock(this->m_handle.m_wait_lock);
+    // Room was reserved in m_count, which bounds the messages of both queues, so the reservation must work
+    U8* storage = nullptr;
+    FwSizeType capacity = 0;
+    FwSizeType index = 0;
+    QueueInterface::Status status =
+        this->m_delegate->reserve(QueueInterface::BlockingType::NONBLOCKING, storage, capacity, index);
+    FW_ASSERT(status == QueueInterface::Status::OP_OK, static_cast<FwAssertArgType>(status));
+    FW_ASSERT(size <= capacity, static_cast<FwAssertArgType>(size), static_cast<FwAssertArgType>(capacity));
+    (void)::memcpy(storage, buffer, static_cast<size_t>(size));
+    // A message moved out of a slot keeps its room until the slot is skipped as well as the message released
+    this->m_handle.m_pending[index] = fromSlot ? 2 : 1;
+    status = this->m_delegate->commit(index, size, priority);
+    FW_ASSERT(status == QueueInterface::Status::OP_OK, static_cast<FwAssertArgType>(status));
+    if (priority > PRIORITY) {
+        this->m_handle.m_urgent.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->m_handle.m_delegated.fetch_add(1, std::memory_order_release);
+    if (this->m_handle.m_receiverWaiting.load(std::memory_order_relaxed)) {
+        this->m_handle.m_empty.notify();
+    }
+    return index;
+}
+
+void MpscQueue::finishDelegated(FwSizeType index) {
+    FW_ASSERT(index < this->m_handle.m_depth, static_cast<FwAssertArgType>(index));
+    FW_ASSERT(this->m_handle.m_pending[index] > 0);
+    this->m_handle.m_pending[index]--;
+    if (this->m_handle.m_pending[index] == 0) {
+        this->m_delegate->returnSlot(index);
+        this->freeRoom();
+    }
+}
+
+void MpscQueue::peekDelegated() {
+    Os::ScopeLock lock(this->m_handle.m_wait_lock);
+    // A message moved out of a slot may still be pending when the next one is peeked, so messages are taken out of
+    // the delegate queue rather than peeked
+    const QueueInterface::Status status =
+        this->m_delegate->take(QueueInterface::BlockingType::NONBLOCKING, this->m_handle.m_peekedMessage,
+                               this->m_handle.m_peekedSize, this->m_handle.m_peekedPriority,
+                               this->m_handle.m_peekedToken);
+    FW_ASSERT(status == QueueInterface::Status::OP_OK, static_cast<FwAssertArgType>(status));
+    if (this->m_handle.m_peekedPriority > PRIORITY) {
+        this->m_handle.m_urgent.fetch_sub(1, std::memory_order_relaxed);
+    }
+    this->m_handle.m_delegated.fetch_sub(1, std::memory_order_relaxed);
+    this->m_handle.m_peekedDelegated = true;
+}
+
+QueueInterface::Status MpscQueue::peekNext(QueueInterface::BlockingType blockType) {
+    while (true) {
+        const FwSizeType position = this->m_handle.m_dequeuePosition;
+        const FwSizeType index = position & this->m_handle.m_mask;
+        MpscQueueSlot& slot = this->m_handle.m_slots[index];
+        const bool published = slot.m_sequence.load(std::memory_order_acquire) == position + 1;
+
+        // Skip the slots of messages committed with another priority and of aborted reservations
+        if (published && ((slot.m_size == DELEGATED) || (slot.m_size == ABORTED))) {
+            this->skipEmptySlots();
+            continue;
+        }
+        // Delegated messages above PRIORITY come first, and those below it once the slots are empty
+        if ((this->m_handle.m_urgent.load(std::memory_order_acquire) > 0) ||
+            ((not published) && (this->m_handle.m_delegated.load(std::memory_order_acquire) > 0))) {
+            this->peekDelegated();
+            return QueueInterface::Status::OP_OK;
+        }
+        if (published) {
+            this->m_handle.m_peekedMessage = this->m_handle.m_data + (index * this->m_handle.m_maxSize);
+            this->m_handle.m_peekedSize = slot.m_size;
+            this->m_handle.m_peekedPriority = PRIORITY;
+            this->m_handle.m_peekedToken = position;
+            this->m_handle.m_peekedDelegated = false;
+            return QueueInterface::Status::OP_OK;
+        }
+        if (blockType == BlockingType::NONBLOCKING) {
+            return QueueInterface::Status::EMPTY;
+        }
+        // Register as waiting before the final check so that a sender either sees the registration or this task
+        // sees the published or delegated message
+        Os::ScopeLock lock(this->m_handle.m_wait_lock);
+        this->m_handle.m_receiverWaiting.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while ((slot.m_sequence.load(std::memory_order_acquire) != position + 1) &&
+               (this->m_handle.m_delegated.load(std::memory_order_relaxed) == 0)) {
+            this->m_handle.m_empty.wait(this->m_handle.m_wait_lock);
+        }
+        this->m_handle.m_receiverWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+QueueInterface::Status MpscQueue::peek(QueueInterface::BlockingType blockType,
+                                       U8*& message,
+                                       FwSizeType& actualSize,
+                                       FwQueuePriorityType& priority,
+                                       FwSizeType& token) {
+    // A message peeked and not yet released stays the next message
+    if (not this->m_handle.m_peeked) {
+        const QueueInterface::Status status = this->peekNext(blockType);
+        if (status != QueueInterface::Status::OP_OK) {
+            return status;
+        }
+        this->m_handle.m_peeked = true;
+    }
+    message = this->m_handle.m_peekedMessage;
+    actualSize = this->m_handle.m_peekedSize;
+    priority = this->m_handle.m_peekedPriority;
+    token = this->m_handle.m_peekedToken;
+    return QueueInterface::Status::OP_OK;
+}
+
+void MpscQueue::releaseSlot(FwSizeType position) {
+    this->m_handle.m_dequeuePosition = position + 1;
+    // Release the slot to the sender of the position one lap later
+    this->m_handle.m_slots[position & this->m_handle.m_mask].m_sequence.store(position + this->m_handle.m_mask + 1,
+                                                                             std::memory_order_release);
+}
+
+void MpscQueue::skipEmptySlots() {
+    while (true) {
+        const FwSizeType position = this->m_handle.m_dequeuePosition;
+        MpscQueueSlot& slot = this->m_handle.m_slots[position & this->m_handle.m_mask];
+        if ((slot.m_sequence.load(std::memory_order_acquire) != position + 1) ||
+            ((slot.m_size != DELEGATED) && (slot.m_size != ABORTED))) {
+            break;
+        }
+        // Read the slot before it is handed back to the senders
+        const bool delegated = slot.m_size == DELEGATED;
+        const FwSizeType index = slot.m_index;
+        this->releaseSlot(position);
+        if (delegated) {
+            this->finishDelegated(index);
+        } else {
+            this->freeRoom();
+        }
+    }
+}
+
+void MpscQueue::freeRoom() {
+    this->m_handle.m_count.fetch_sub(1, std::memory_order_release);
+
+    // Wake a sender only when one is parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->m_handle.m_sendersWaiting.load(std::memory_order_relaxed) > 0) {
+        Os::ScopeLock lock(this->m_handle.m_wait_lock);
+        this->m_handle.m_full.notify();
+    }
+}
+
+QueueInterface::Status MpscQueue::release(FwSizeType token) {
+    // Messages are released one at a time, in the order they were peeked
+    FW_ASSERT(this->m_handle.m_peeked);
+    FW_ASSERT(token == this->m_handle.m_peekedToken, static_cast<FwAssertArgType>(token),
+              static_cast<FwAssertArgType>(this->m_handle.m_peekedToken));
+    this->m_handle.m_peeked = false;
+    if (this->m_handle.m_peekedDelegated) {
+        this->finishDelegated(token);
+    } else {
+        this->releaseSlot(token);
+        this->freeRoom();
+    }
+    // Skip the empty slots now, so that they do not hold room until the next receive
+    this->skipEmptySlots();
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status MpscQueue::receive(U8* destination,
+                                          FwSizeType capacity,
+                                          QueueInterface::BlockingType blockType,
+                                          FwSizeType& actualSize,
+                                          FwQueuePriorityType& priority) {
+    U8* message = nullptr;
+    FwSizeType token = 0;
+    const QueueInterface::Status status = this->peek(blockType, message, actualSize, priority, token);
+    if (status != QueueInterface::Status::OP_OK) {
+        return status;
+    }
+    FW_ASSERT(actualSize <= capacity, static_cast<FwAssertArgType>(actualSize),
+              static_cast<FwAssertArgType>(capacity));
+    (void)::memcpy(destination, message, static_cast<size_t>(actualSize));
+    return this->release(token);
+}
+
+FwSizeType MpscQueue::getMessagesAvailable() const {
+    return this->m_handle.m_count.load(std::memory_order_relaxed);
+}
+
+FwSizeType MpscQueue::getMessageHighWaterMark() const {
+    return this->m_handle.m_highMark.load(std::memory_order_relaxed);
+}
+
+QueueHandle* MpscQueue::getHandle() {
+    return &this->m_handle;
+}
+
+}  // namespace Generic
+}  // namespace Os
@@ -0,0 +1,271 @@
+// ======================================================================
+// \title Os/Generic/MpscQueue.hpp
+// \brief lock-free multi-producer single-consumer queue implementation definitions for Os::Queue
+// ======================================================================
+#include <atomic>
+#include <limits>
+#include "Os/Condition.hpp"
+#include "Os/Generic/PriorityQueue.hpp"
+#include "Os/Mutex.hpp"
+#include "Os/Queue.hpp"
+#ifndef OS_GENERIC_MPSCQUEUE_HPP
+#define OS_GENERIC_MPSCQUEUE_HPP
+
+namespace Os {
+namespace Generic {
+
+//! \brief bookkeeping for one message slot of the MPSC queue
+struct MpscQueueSlot {
+    //! Slot state. A value of `p` means the slot is free for the sender of position `p`; `p + 1` means the message
+    //! at position `p` has been published. The receiver frees the slot for the position one lap later.
+    std::atomic<FwSizeType> m_sequence;
+    FwSizeType m_size;   //!< Size of the message in this slot
+    FwSizeType m_index;  //!< Delegate queue index of a message moved out of this slot
+};
+
+//! \brief critical data stored for the MPSC queue
+//!
+//! Messages are stored in a ring of slots. The slot count is the queue depth rounded up to a power of two so that
+//! the free-running positions can be mapped to slots with a mask. A sender first reserves room by incrementing
+//! `m_count`, which never exceeds the depth, then claims the next enqueue position, copies the message into the
+//! slot and publishes the slot by storing its sequence. The single receiver consumes positions in order and hands
+//! each slot back by storing its sequence for the next lap. Messages of other priorities are counted in `m_count` the
+//! same way but are stored in the delegate priority queue.
+struct MpscQueueHandle : public QueueHandle {
+    MpscQueueSlot* m_slots = nullptr;              //!< Slot bookkeeping, one per slot
+    U8* m_data = nullptr;                          //!< Message data, m_maxSize bytes per slot
+    U8* m_pending = nullptr;                       //!< Per delegate index, events left before its room is freed
+    FwSizeType m_depth = 0;                        //!< Maximum number of messages in the queue
+    FwSizeType m_mask = 0;                         //!< Slot count - 1
+    FwSizeType m_maxSize = 0;                      //!< Maximum size allowed of a message
+    std::atomic<FwSizeType> m_enqueuePosition{0};  //!< Next position claimed by a sender
+    FwSizeType m_dequeuePosition = 0;              //!< Next position read by the receiver
+    std::atomic<FwSizeType> m_count{0};            //!< Messages reserved by senders and not yet received
+    std::atomic<FwSizeType> m_highMark{0};         //!< Message count high water mark
+    std::atomic<bool> m_receiverWaiting{false};    //!< Receiver is blocked on m_empty
+    std::atomic<FwSizeType> m_sendersWaiting{0};   //!< Number of senders blocked on m_full
+    std::atomic<FwSizeType> m_delegated{0};        //!< Messages in the delegate queue and not yet peeked
+    std::atomic<FwSizeType> m_urgent{0};           //!< Delegated messages above PRIORITY and not yet peeked
+    bool m_peeked = false;                         //!< A message is peeked and not yet released
+    bool m_peekedDelegated = false;                //!< The peeked message came from the delegate queue
+    U8* m_peekedMessage = nullptr;                 //!< Data of the peeked message
+    FwSizeType m_peekedSize = 0;                   //!< Size of the peeked message
+    FwQueuePriorityType m_peekedPriority = 0;      //!< Priority of the peeked message
+    FwSizeType m_peekedToken = 0;                  //!< Token of the peeked message
+    Os::Mutex m_wait_lock;                         //!< Lock used to block and wake tasks and to delegate messages
+    Os::ConditionVariable m_full;                  //!< Queue full condition variable to support blocking
+    Os::ConditionVariable m_empty;                 //!< Queue empty condition variable to support blocking
+    FwEnumStoreType m_id = 0;                      //!< Identifier for the queue, used for memory allocation
+};
+
+//! \brief generic lock-free multi-producer single-consumer queue implementation
+//!
+//! An implementation of Os::QueueInterface for queues with one receiving task, such as the queue of an active
+//! component, whose messages mostly have the same priority. Sending and receiving messages of priority PRIORITY
+//! (zero), the priority used for ports without an explicit priority, do not take a lock. Os::Mutex and
+//! Os::ConditionVariable are used only when a task blocks on a full or empty queue, and senders and the receiver
+//! only touch them when the other side is blocked.
+//!
+//! Messages of any other priority are delegated to a generic PriorityQueue of the same depth and message size, which
+//! takes a lock. Messages above PRIORITY are received before those of PRIORITY, and messages below it after, so the
+//! queue orders messages as the priority queue would.
+//!
+//! \warning Only one task may receive from the queue.
+//! \warning This queue is not ISR safe when blocking
+//! \warning allocates memory through the memory allocator registry
+class MpscQueue : public Os::QueueInterface {
+  public:
+    //! \brief the single priority supported by this queue
+    static const FwQueuePriorityType PRIORITY = 0;
+
+    //! \brief default queue interface constructor
+    MpscQueue() = default;
+
+    //! \brief default queue destructor
+    virtual ~MpscQueue();
+
+    //! \brief copy constructor is forbidden
+    MpscQueue(const QueueInterface& other) = delete;
+
+    //! \brief copy constructor is forbidden
+    MpscQueue(const QueueInterface* other) = delete;
+
+    //! \brief assignment operator is forbidden
+    MpscQueue& operator=(const QueueInterface& other) override = delete;
+
+    //! \brief create queue storage
+    //!
+    //! Creates a queue ensuring sufficient storage to hold `depth` messages of `messageSize` size each, in the
+    //! lock-free slots and in the delegate queue for other priorities.
+    //!
+    //! \warning allocates memory through the memory allocator registry
+    //!
+    //! \param id: identifier for the queue, used for memory allocation
+    //! \param name: name of queue
+    //! \param depth: depth of queue in number of messages
+    //! \param messageSize: size of an individual message
+    //! \return: status of the creation
+    Status create(FwEnumStoreType id,
+                  const Fw::ConstStringBase& name,
+                  FwSizeType depth,
+                  FwSizeType messageSize) override;
+
+    //! \brief teardown the queue
+    //!
+    //! Allow for queues to deallocate resources as part of system shutdown.
+    void teardown() override;
+
+    //! \brief teardown the queue
+    //!
+    //! Note: this is a helper to allow this to be called from the destructor.
+    void teardownInternal();
+
+    //! \brief send a message into the queue
+    //!
+    //! Send a message into the queue, without locking when `priority` is PRIORITY. When `blockType` is set to
+    //! BLOCKING, this call will block on queue full. Otherwise, this will return an error status on queue full. May
+    //! be called from any number of tasks.
+    //!
+    //! \param buffer: message data
+    //! \param size: size of message data
+    //! \param priority: priority of the message
+    //! \param blockType: BLOCKING to block for space or NONBLOCKING to return error when queue is full
+    //! \return: status of the send
+    Status send(const U8* buffer, FwSizeType size, FwQueuePriorityType priority, BlockingType blockType) override;
+
+    //! \brief receive a message from the queue
+    //!
+    //! Receive the highest priority message from the queue, and the oldest of those, without locking unless a message
+    //! was delegated. When `blockType` is set to BLOCKING, this call will block on queue empty. Otherwise, this will
+    //! return an error status on queue empty. May only be called from a single task.
+    //!
+    //! \param destination: destination for message data
+    //! \param capacity: maximum size of message data
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param actualSize: (output) actual size of message read
+    //! \param priority: (output) priority of message read
+    //! \return: status of the receive
+    Status receive(U8* destination,
+                   FwSizeType capacity,
+                   BlockingType blockType,
+                   FwSizeType& actualSize,
+                   FwQueuePriorityType& priority) override;
+
+    //! \brief reserve a message slot in the queue for in-place writing
+    //!
+    //! Reserve room and claim the next slot position without locking. Messages are received in the order their
+    //! slots were reserved, so the receiver waits on a reserved slot until it is committed. May be called from any
+    //! number of tasks.
+    //!
+    //! \param blockType: BLOCKING to block for space or NONBLOCKING to return error when queue is full
+    //! \param slot: (output) message storage to write into
+    //! \param capacity: (output) size of the message storage
+    //! \param token: (output) reservation token to pass to commit or abort
+    //! \return: status of the reservation
+    Status reserve(BlockingType blockType, U8*& slot, FwSizeType& capacity, FwSizeType& token) override;
+
+    //! \brief commit a reserved message slot into the queue
+    //!
+    //! Publish the slot to the receiver. A message of a priority other than PRIORITY is copied to the delegate queue
+    //! and its slot is published empty. On SIZE_MISMATCH the reservation stays open and must still be committed or
+    //! aborted.
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \param size: size of the message written into the slot
+    //! \param priority: priority of the message
+    //! \return: status of the commit
+    Status commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) override;
+
+    //! \brief abort a reservation without sending a message
+    //!
+    //! Publish the slot empty. The receiver skips it and frees its room. May be called from any number of tasks.
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \return: status of the abort
+    Status abort(FwSizeType token) override;
+
+    //! \brief read the next message to receive in place
+    //!
+    //! The message stays the next message of the queue until release: peeking again returns it with the same token,
+    //! and receive returns and releases it. May only be called from the receiving task.
+    //!
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param message: (output) message data to read from
+    //! \param actualSize: (output) size of the message
+    //! \param priority: (output) priority of the message
+    //! \param token: (output) token to pass to release
+    //! \return: status of the peek
+    Status peek(BlockingType blockType,
+                U8*& message,
+                FwSizeType& actualSize,
+                FwQueuePriorityType& priority,
+                FwSizeType& token) override;
+
+    //! \brief release the peeked message slot back to the senders
+    //!
+    //! May only be called from the receiving task.
+    //!
+    //! \param token: token returned by peek
+    //! \return: status of the release
+    Status release(FwSizeType token) override;
+
+    //! \brief get number of messages available
+    //!
+    //! Includes messages whose senders have reserved space but not finished copying.
+    //! \return number of messages available
+    FwSizeType getMessagesAvailable() const override;
+
+    //! \brief get maximum messages stored at any given time
+    //!
+    //! \return queue message high-water mark
+    FwSizeType getMessageHighWaterMark() const override;
+
+    QueueHandle* getHandle() override;
+
+    MpscQueueHandle m_handle;
+
+  private:
+    //! \brief reserve room for one message, blocking if requested
+    //! \return OP_OK when room was reserved, FULL otherwise
+    Status reserveRoom(BlockingType blockType);
+
+    //! \brief store a message of a priority other than PRIORITY in the delegate queue, after room was reserved
+    //! \param fromSlot: whether the message was moved out of a slot, which must also be skipped to free its room
+    //! \return the delegate queue index of the message
+    FwSizeType delegate(const U8* buffer, FwSizeType size, FwQueuePriorityType priority, bool fromSlot);
+
+    //! \brief count one event of a delegated message, and free its index and room after the last one
+    void finishDelegated(FwSizeType index);
+
+    //! \brief publish a committed or aborted slot to the receiver and wake it if blocked
+    void publishSlot(FwSizeType token);
+
+    //! \brief skip the published slots of delegated messages and aborted reservations at the dequeue position
+    void skipEmptySlots();
+
+    //! \brief release the room of one message and wake a blocked sender
+    void freeRoom();
+
+    //! \brief take the next message out of the delegate queue, which must hold one, and record it as peeked
+    void peekDelegated();
+
+    //! \brief find the next message to receive and record it as peeked
+    //! \return OP_OK when a message was found, EMPTY otherwise
+    Status peekNext(BlockingType blockType);
+
+    //! \brief hand the slot at the dequeue position back to the senders
+    void releaseSlot(FwSizeType position);
+
+    //! \brief slot size marking a message committed with another priority and moved to the delegate queue
+    static constexpr FwSizeType DELEGATED = std::numeric_limits<FwSizeType>::max();
+
+    //! \brief slot size marking an aborted reservation
+    static constexpr FwSizeType ABORTED = std::numeric_limits<FwSizeType>::max() - 1;
+
+    //! \brief queue for messages of priorities other than PRIORITY, allocated in create to keep the handle small
+    PriorityQueue* m_delegate = nullptr;
+};
+}  // namespace Generic
+}  // namespace Os
+
+#endif  // OS_GENERIC_MPSCQUEUE_HPP
@@ -12,6 +12,33 @@
 namespace Os {
 namespace Generic {
 
+bool PriorityQueueHandle ::isFull() {
+    return (this->m_heap.getSize() + this->m_inFlight) >= this->m_depth;
+}
+
+QueueInterface::Status PriorityQueueHandle ::take_index(QueueInterface::BlockingType blockType,
+                                                       FwSizeType& index,
+                                                       FwQueuePriorityType& priority) {
+    if (this->m_heap.isEmpty() and blockType == QueueInterface::BlockingType::NONBLOCKING) {
+        return QueueInterface::Status::EMPTY;
+    }
+    // Loop and lock while empty
+    while (this->m_heap.isEmpty()) {
+        this->m_empty.wait(this->m_data_lock);
+    }
+    // Message must exist, so pop must pass
+    FW_ASSERT(this->m_heap.pop(priority, index));
+    this->m_inFlight++;
+    return QueueInterface::Status::OP_OK;
+}
+
+void PriorityQueueHandle ::return_in_flight(FwSizeType index) {
+    FW_ASSERT(index < this->m_depth, static_cast<FwAssertArgType>(index));
+    FW_ASSERT(this->m_inFlight > 0);
+    this->m_inFlight--;
+    this->return_index(index);
+}
+
 FwSizeType PriorityQueueHandle ::find_index() {
     FwSizeType index = this->m_indices[this->m_startIndex % this->m_depth];
     this->m_startIndex = (this->m_startIndex + 1) % this->m_depth;
@@ -146,6 +173,8 @@ QueueInterface::Status PriorityQueue::create(FwEnumStoreType id,
         this->m_handle.m_stopIndex = 0;
         this->m_handle.m_depth = depth;
         this->m_handle.m_highMark = 0;
+        this->m_handle.m_inFlight = 0;
+        this->m_handle.m_peeked = false;
     }
     return status;
 }
@@ -183,11 +212,11 @@ QueueInterface::Status PriorityQueue::send(const U8* buffer,
     // Artificial block scope for scope lock ensuring an unlock in all cases and ensuring an unlock before notify
     {
         Os::ScopeLock lock(this->m_handle.m_data_lock);
-        if (this->m_handle.m_heap.isFull() and blockType == BlockingType::NONBLOCKING) {
+        if (this->m_handle.isFull() and blockType == BlockingType::NONBLOCKING) {
             return QueueInterface::Status::FULL;
         }
         // Will loop and block until full is false
-        while (this->m_handle.m_heap.isFull()) {
+        while (this->m_handle.isFull()) {
             this->m_handle.m_full.wait(this->m_handle.m_data_lock);
         }
         FwSizeType index = this->m_handle.find_index();
@@ -209,28 +238,136 @@ QueueInterface::Status PriorityQueue::receive(U8* destination,
                                               FwQueuePriorityType& priority) {
     {
         Os::ScopeLock lock(this->m_handle.m_data_lock);
-        if (this->m_handle.m_heap.isEmpty() and blockType == BlockingType::NONBLOCKING) {
-            return QueueInterface::Status::EMPTY;
-        }
-        // Loop and lock while empty
-        while (this->m_handle.m_heap.isEmpty()) {
-            this->m_handle.m_empty.wait(this->m_handle.m_data_lock);
-        }
-
         FwSizeType index;
-        // Message must exist, so pop must pass and size must be valid
-        FW_ASSERT(this->m_handle.m_heap.pop(priority, index));
+        if (this->m_handle.m_peeked) {
+            // A peeked message is still the next message
+            this->m_handle.m_peeked = false;
+            index = this->m_handle.m_peekedIndex;
+            priority = this->m_handle.m_peekedPriority;
+        } else {
+            const QueueInterface::Status status = this->m_handle.take_index(blockType, index, priority);
+            if (status != QueueInterface::Status::OP_OK) {
+                return status;
+            }
+        }
+        // Size must be valid
         actualSize = this->m_handle.m_sizes[index];
         FW_ASSERT(actualSize <= capacity);
         this->m_handle.load_data(index, destination, actualSize);
-        this->m_handle.return_index(index);
+        this->m_handle.return_in_flight(index);
     }
     this->m_handle.m_full.notify();
     return QueueInterface::Status::OP_OK;
 }
 
+QueueInterface::Status PriorityQueue::reserve(QueueInterface::BlockingType blockType,
+                                              U8*& slot,
+                                              FwSizeType& capacity,
+                                              FwSizeType& token) {
+    Os::ScopeLock lock(this->m_handle.m_data_lock);
+    if (this->m_handle.isFull() and blockType == BlockingType::NONBLOCKING) {
+        return QueueInterface::Status::FULL;
+    }
+    // Will loop and block until full is false
+    while (this->m_handle.isFull()) {
+        this->m_handle.m_full.wait(this->m_handle.m_data_lock);
+    }
+    token = this->m_handle.find_index();
+    this->m_handle.m_inFlight++;
+    this->m_handle.m_highMark = FW_MAX(this->m_handle.m_highMark, this->getMessagesAvailable());
+    slot = this->m_handle.m_data + (this->m_handle.m_maxSize * token);
+    capacity = this->m_handle.m_maxSize;
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status PriorityQueue::commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) {
+    // Check for sizing problem before locking
+    if (size > this->m_handle.m_maxSize) {
+        return QueueInterface::Status::SIZE_MISMATCH;
+    }
+    FW_ASSERT(token < this->m_handle.m_depth, static_cast<FwAssertArgType>(token));
+    // Artificial block scope for scope lock ensuring an unlock before notify
+    {
+        Os::ScopeLock lock(this->m_handle.m_data_lock);
+        FW_ASSERT(this->m_handle.m_inFlight > 0);
+        this->m_handle.m_inFlight--;
+        // Slot was reserved, so push must work
+        FW_ASSERT(this->m_handle.m_heap.push(priority, token));
+        this->m_handle.m_sizes[token] = size;
+    }
+    this->m_handle.m_empty.notify();
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status PriorityQueue::abort(FwSizeType token) {
+    {
+        Os::ScopeLock lock(this->m_handle.m_data_lock);
+        this->m_handle.return_in_flight(token);
+    }
+    this->m_handle.m_full.notify();
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status PriorityQueue::peek(QueueInterface::BlockingType blockType,
+                                           U8*& message,
+                                           FwSizeType& actualSize,
+                                           FwQueuePriorityType& priority,
+                                           FwSizeType& token) {
+    Os::ScopeLock lock(this->m_handle.m_data_lock);
+    // A message peeked and not yet released stays the next message
+    if (not this->m_handle.m_peeked) {
+        const QueueInterface::Status status =
+            this->m_handle.take_index(blockType, this->m_handle.m_peekedIndex, this->m_handle.m_peekedPriority);
+        if (status != QueueInterface::Status::OP_OK) {
+            return status;
+        }
+        this->m_handle.m_peeked = true;
+    }
+    token = this->m_handle.m_peekedIndex;
+    priority = this->m_handle.m_peekedPriority;
+    actualSize = this->m_handle.m_sizes[token];
+    message = this->m_handle.m_data + (this->m_handle.m_maxSize * token);
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status PriorityQueue::release(FwSizeType token) {
+    {
+        Os::ScopeLock lock(this->m_handle.m_data_lock);
+        FW_ASSERT(this->m_handle.m_peeked);
+        FW_ASSERT(token == this->m_handle.m_peekedIndex, static_cast<FwAssertArgType>(token),
+                  static_cast<FwAssertArgType>(this->m_handle.m_peekedIndex));
+        this->m_handle.m_peeked = false;
+        this->m_handle.return_in_flight(token);
+    }
+    this->m_handle.m_full.notify();
+    return QueueInterface::Status::OP_OK;
+}
+
+QueueInterface::Status PriorityQueue::take(QueueInterface::BlockingType blockType,
+                                           U8*& message,
+                                           FwSizeType& actualSize,
+                                           FwQueuePriorityType& priority,
+                                           FwSizeType& index) {
+    Os::ScopeLock lock(this->m_handle.m_data_lock);
+    const QueueInterface::Status status = this->m_handle.take_index(blockType, index, priority);
+    if (status != QueueInterface::Status::OP_OK) {
+        return status;
+    }
+    actualSize = this->m_handle.m_sizes[index];
+    message = this->m_handle.m_data + (this->m_handle.m_maxSize * index);
+    return QueueInterface::Status::OP_OK;
+}
+
+void PriorityQueue::returnSlot(FwSizeType index) {
+    {
+        Os::ScopeLock lock(this->m_handle.m_data_lock);
+        this->m_handle.return_in_flight(index);
+    }
+    this->m_handle.m_full.notify();
+}
+
 FwSizeType PriorityQueue::getMessagesAvailable() const {
-    return this->m_handle.m_heap.getSize();
+    return this->m_handle.m_heap.getSize() + this->m_handle.m_inFlight;
 }
 
 FwSizeType PriorityQueue::getMessageHighWaterMark() const {
@@ -19,20 +19,36 @@ namespace Generic {
 //! These indices are ordered by a max heap data structure projecting priority on to the otherwise unordered data. Both
 //! the data region and index list have queue depth number of entries.
 struct PriorityQueueHandle : public QueueHandle {
-    Types::MaxHeap m_heap;            //!< MaxHeap data store for tracking priority
-    U8* m_heap_pointer;               //!< Pointer to the MaxHeap data store
-    U8* m_data = nullptr;             //!< Pointer to data allocation
-    FwSizeType* m_indices = nullptr;  //!< List of indices into data
-    FwSizeType* m_sizes = nullptr;    //!< Size store for each method
-    FwSizeType m_depth = 0;           //!< Depth of the queue
-    FwSizeType m_startIndex = 0;      //!< Start index of the circular data structure
-    FwSizeType m_stopIndex = 0;       //!< End index of the circular data structure
-    FwSizeType m_maxSize = 0;         //!< Maximum size allowed of a message
-    FwSizeType m_highMark = 0;        //!< Message count high water mark
-    Os::Mutex m_data_lock;            //!< Lock against data manipulation
-    Os::ConditionVariable m_full;     //!< Queue full condition variable to support blocking
-    Os::ConditionVariable m_empty;    //!< Queue empty condition variable to support blocking
-    FwEnumStoreType m_id;             //!< Identifier for the queue, used for memory allocation
+    Types::MaxHeap m_heap;                     //!< MaxHeap data store for tracking priority
+    U8* m_heap_pointer;                        //!< Pointer to the MaxHeap data store
+    U8* m_data = nullptr;                      //!< Pointer to data allocation
+    FwSizeType* m_indices = nullptr;           //!< List of indices into data
+    FwSizeType* m_sizes = nullptr;             //!< Size store for each method
+    FwSizeType m_depth = 0;                    //!< Depth of the queue
+    FwSizeType m_startIndex = 0;               //!< Start index of the circular data structure
+    FwSizeType m_stopIndex = 0;                //!< End index of the circular data structure
+    FwSizeType m_maxSize = 0;                  //!< Maximum size allowed of a message
+    FwSizeType m_highMark = 0;                 //!< Message count high water mark
+    FwSizeType m_inFlight = 0;                 //!< Slots reserved or taken out of the heap, not yet returned
+    bool m_peeked = false;                     //!< A message is peeked and not yet released
+    FwSizeType m_peekedIndex = 0;              //!< Index of the peeked message
+    FwQueuePriorityType m_peekedPriority = 0;  //!< Priority of the peeked message
+    Os::Mutex m_data_lock;                     //!< Lock against data manipulation
+    Os::ConditionVariable m_full;              //!< Queue full condition variable to support blocking
+    Os::ConditionVariable m_empty;             //!< Queue empty condition variable to support blocking
+    FwEnumStoreType m_id;                      //!< Identifier for the queue, used for memory allocation
+
+    //!\brief check whether every slot is in the heap or in flight
+    bool isFull();
+
+    //!\brief take the highest priority index out of the heap, waiting for one if requested. Call with m_data_lock held.
+    //!\return OP_OK when a message was taken, EMPTY otherwise
+    QueueInterface::Status take_index(QueueInterface::BlockingType blockType,
+                                      FwSizeType& index,
+                                      FwQueuePriorityType& priority);
+
+    //!\brief return a taken or reserved index to the circular data structure. Call with m_data_lock held.
+    void return_in_flight(FwSizeType index);
 
     //!\brief find an available index to store data from the list
     FwSizeType find_index();
@@ -140,8 +156,101 @@ class PriorityQueue : public Os::QueueInterface {
                    FwSizeType& actualSize,
                    FwQueuePriorityType& priority) override;
 
+    //! \brief reserve a message slot in the queue for in-place writing
+    //!
+    //! Take a free slot out of the circular index list without placing it in the heap. The slot is pushed onto the
+    //! heap with its priority by commit.
+    //!
+    //! \warning This method will block if the queue is full and blockType is set to BLOCKING
+    //! \warning This method is not ISR safe
+    //!
+    //! \param blockType: BLOCKING to block for space or NONBLOCKING to return error when queue is full
+    //! \param slot: (output) message storage to write into
+    //! \param capacity: (output) size of the message storage
+    //! \param token: (output) reservation token to pass to commit
+    //! \return: status of the reservation
+    Status reserve(BlockingType blockType, U8*& slot, FwSizeType& capacity, FwSizeType& token) override;
+
+    //! \brief commit a reserved message slot into the queue
+    //!
+    //! \warning This method is not ISR safe
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \param size: size of the message written into the slot
+    //! \param priority: priority of the message
+    //! \return: status of the commit
+    Status commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) override;
+
+    //! \brief abort a reservation without sending a message
+    //!
+    //! Return the reserved slot to the circular index list.
+    //!
+    //! \warning This method is not ISR safe
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \return: status of the abort
+    Status abort(FwSizeType token) override;
+
+    //! \brief read the next message from the queue in place
+    //!
+    //! Take the highest priority message out of the heap and record it as peeked, unless a message is already peeked,
+    //! in which case that message is returned again. The slot is returned to the circular index list by release or by
+    //! the next receive.
+    //!
+    //! \warning This method will block if the queue is empty and blockType is set to BLOCKING
+    //! \warning This method is not ISR safe
+    //!
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param message: (output) message data to read from
+    //! \param actualSize: (output) size of the message
+    //! \param priority: (output) priority of the message
+    //! \param token: (output) token to pass to release
+    //! \return: status of the peek
+    Status peek(BlockingType blockType,
+                U8*& message,
+                FwSizeType& actualSize,
+                FwQueuePriorityType& priority,
+                FwSizeType& token) override;
+
+    //! \brief release a peeked message slot back to the queue
+    //!
+    //! \warning This method is not ISR safe
+    //!
+    //! \param token: token returned by peek
+    //! \return: status of the release
+    Status release(FwSizeType token) override;
+
+    //! \brief take the highest priority message out of the heap for in-place reading
+    //!
+    //! Like peek, except that any number of messages may be taken at once, each is removed from the messages to
+    //! receive, and each is returned with returnSlot in any order. Used by MpscQueue to hold several delegated
+    //! messages.
+    //!
+    //! \warning This method will block if the queue is empty and blockType is set to BLOCKING
+    //! \warning This method is not ISR safe
+    //!
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param message: (output) message data to read from
+    //! \param actualSize: (output) size of the message
+    //! \param priority: (output) priority of the message
+    //! \param index: (output) index to pass to returnSlot
+    //! \return: status of the take
+    Status take(BlockingType blockType,
+                U8*& message,
+                FwSizeType& actualSize,
+                FwQueuePriorityType& priority,
+                FwSizeType& index);
+
+    //! \brief return the slot of a taken message to the circular index list
+    //!
+    //! \warning This method is not ISR safe
+    //!
+    //! \param index: index returned by take
+    void returnSlot(FwSizeType index);
+
     //! \brief get number of messages available
     //!
+    //! Includes messages reserved and not yet committed, and messages peeked or taken and not yet released.
     //! \return number of messages available
     FwSizeType getMessagesAvailable() const override;
 
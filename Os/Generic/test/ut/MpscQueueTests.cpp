@@ -0,0 +1,219 @@
+// ======================================================================
+// \title Os/Generic/test/ut/MpscQueueTests.cpp
+// \brief tests using generic MPSC implementation for Os::Queue interface testing
+// ======================================================================
+#include <gtest/gtest.h>
+#include <cstring>
+#include "Fw/Types/String.hpp"
+#include "Os/Generic/MpscQueue.hpp"
+#include "Os/Queue.hpp"
+#include "Os/Task.hpp"
+#include "STest/Random/Random.hpp"
+
+namespace {
+
+constexpr FwSizeType MPSC_SENDERS = 4;
+constexpr U32 MPSC_MESSAGES_PER_SENDER = 20000;
+constexpr FwSizeType MPSC_DEPTH = 10;
+
+//! Message sent by each sender: the sender number and a per-sender sequence number
+struct MpscMessage {
+    U32 sender;
+    U32 sequence;
+};
+
+struct MpscSenderData {
+    Os::Queue* queue;
+    U32 sender;
+};
+
+void mpscSender(void* arg) {
+    MpscSenderData& data = *static_cast<MpscSenderData*>(arg);
+    for (U32 sequence = 0; sequence < MPSC_MESSAGES_PER_SENDER; sequence++) {
+        MpscMessage message = {data.sender, sequence};
+        ASSERT_EQ(Os::Queue::Status::OP_OK,
+                  data.queue->send(reinterpret_cast<const U8*>(&message), sizeof message,
+                                   Os::Generic::MpscQueue::PRIORITY, Os::Queue::BlockingType::BLOCKING));
+    }
+}
+
+}  // namespace
+
+// Messages from concurrent senders arrive complete and in per-sender order
+TEST(MpscQueue, ConcurrentSenders) {
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("MpscQueue"), MPSC_DEPTH, sizeof(MpscMessage)));
+
+    MpscSenderData data[MPSC_SENDERS];
+    Os::Task tasks[MPSC_SENDERS];
+    for (FwSizeType i = 0; i < MPSC_SENDERS; i++) {
+        data[i].queue = &queue;
+        data[i].sender = static_cast<U32>(i);
+        Os::Task::Arguments arguments(Fw::String("MpscSender"), mpscSender, &data[i]);
+        ASSERT_EQ(Os::Task::OP_OK, tasks[i].start(arguments));
+    }
+
+    U32 expected[MPSC_SENDERS] = {};
+    for (U32 received = 0; received < MPSC_SENDERS * MPSC_MESSAGES_PER_SENDER; received++) {
+        MpscMessage message = {0, 0};
+        FwSizeType size = 0;
+        FwQueuePriorityType priority = 0;
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.receive(reinterpret_cast<U8*>(&message), sizeof message,
+                                                          Os::Queue::BlockingType::BLOCKING, size, priority));
+        ASSERT_EQ(sizeof message, size);
+        ASSERT_EQ(Os::Generic::MpscQueue::PRIORITY, priority);
+        ASSERT_LT(message.sender, MPSC_SENDERS);
+        ASSERT_EQ(expected[message.sender], message.sequence);
+        expected[message.sender]++;
+    }
+    for (FwSizeType i = 0; i < MPSC_SENDERS; i++) {
+        ASSERT_EQ(Os::Task::OP_OK, tasks[i].join());
+    }
+    ASSERT_EQ(0, queue.getMessagesAvailable());
+    ASSERT_LE(queue.getMessageHighWaterMark(), MPSC_DEPTH);
+}
+
+// Messages of other priorities are received in priority order ahead of those of the lock-free priority, and share
+// its depth
+TEST(MpscQueue, Priorities) {
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("MpscQueue"), MPSC_DEPTH, sizeof(U32)));
+    const FwQueuePriorityType priorities[] = {0, 1, 0, 5, 3, 0, 5};
+    for (U32 value = 0; value < FW_NUM_ARRAY_ELEMENTS(priorities); value++) {
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.send(reinterpret_cast<const U8*>(&value), sizeof value,
+                                                       priorities[value], Os::Queue::BlockingType::NONBLOCKING));
+    }
+    // A reserved slot committed with another priority is received in its priority order
+    U8* slot = nullptr;
+    FwSizeType capacity = 0;
+    FwSizeType token = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(Os::Queue::BlockingType::NONBLOCKING, slot, capacity, token));
+    const U32 reserved = 7;
+    ASSERT_GE(capacity, sizeof reserved);
+    (void)::memcpy(slot, &reserved, sizeof reserved);
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(token, sizeof reserved, 2));
+    ASSERT_EQ(8, queue.getMessagesAvailable());
+
+    const U32 expectedValues[] = {3, 6, 4, 7, 1, 0, 2, 5};
+    const FwQueuePriorityType expectedPriorities[] = {5, 5, 3, 2, 1, 0, 0, 0};
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(expectedValues); i++) {
+        U32 value = 0;
+        FwSizeType size = 0;
+        FwQueuePriorityType priority = 0;
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.receive(reinterpret_cast<U8*>(&value), sizeof value,
+                                                          Os::Queue::BlockingType::NONBLOCKING, size, priority));
+        ASSERT_EQ(expectedValues[i], value);
+        ASSERT_EQ(expectedPriorities[i], priority);
+    }
+    ASSERT_EQ(0, queue.getMessagesAvailable());
+
+    // Both kinds of messages count against the depth
+    for (U32 value = 0; value < MPSC_DEPTH; value++) {
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.send(reinterpret_cast<const U8*>(&value), sizeof value,
+                                                       static_cast<FwQueuePriorityType>(value % 2),
+                                                       Os::Queue::BlockingType::NONBLOCKING));
+    }
+    const U32 value = 0;
+    for (FwQueuePriorityType priority = 0; priority < 2; priority++) {
+        ASSERT_EQ(Os::Queue::Status::FULL, queue.send(reinterpret_cast<const U8*>(&value), sizeof value, priority,
+                                                      Os::Queue::BlockingType::NONBLOCKING));
+    }
+    ASSERT_EQ(MPSC_DEPTH, queue.getMessagesAvailable());
+}
+
+// Messages serialized into reserved slots are received in reservation order, and a peeked message stays at the head
+// of the queue until released
+TEST(MpscQueue, ReserveCommitPeekRelease) {
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("MpscQueue"), MPSC_DEPTH, sizeof(U32)));
+
+    // Commit out of reservation order; the receiver still sees reservation order
+    Fw::ExternalSerializeBuffer first;
+    Fw::ExternalSerializeBuffer second;
+    FwSizeType firstToken = 0;
+    FwSizeType secondToken = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(first, Os::Queue::BlockingType::NONBLOCKING, firstToken));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(second, Os::Queue::BlockingType::NONBLOCKING, secondToken));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, second.serializeFrom(static_cast<U32>(2)));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(second, secondToken, Os::Generic::MpscQueue::PRIORITY));
+
+    Fw::ExternalSerializeBuffer message;
+    FwQueuePriorityType priority = 0;
+    FwSizeType token = 0;
+    ASSERT_EQ(Os::Queue::Status::EMPTY, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, first.serializeFrom(static_cast<U32>(1)));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(first, firstToken, Os::Generic::MpscQueue::PRIORITY));
+
+    for (U32 expected = 1; expected <= 2; expected++) {
+        // Peeking twice without a release sees the same message
+        for (U32 pass = 0; pass < 2; pass++) {
+            ASSERT_EQ(Os::Queue::Status::OP_OK,
+                      queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+            U32 value = 0;
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.deserializeTo(value));
+            ASSERT_EQ(expected, value);
+            ASSERT_EQ(Os::Generic::MpscQueue::PRIORITY, priority);
+        }
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.release(token));
+    }
+    ASSERT_EQ(0, queue.getMessagesAvailable());
+    ASSERT_EQ(Os::Queue::Status::EMPTY, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+}
+
+// Aborted reservations are skipped by the receiver, which frees their room, and a receive while a message is peeked
+// returns the peeked message
+TEST(MpscQueue, AbortAndReceivePeeked) {
+    const FwSizeType depth = 3;
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("MpscQueue"), depth, sizeof(U32)));
+
+    // Reserve every slot, abort the first, and commit the others with both priorities
+    Fw::ExternalSerializeBuffer aborted;
+    Fw::ExternalSerializeBuffer urgent;
+    Fw::ExternalSerializeBuffer normal;
+    FwSizeType abortedToken = 0;
+    FwSizeType urgentToken = 0;
+    FwSizeType normalToken = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(aborted, Os::Queue::BlockingType::NONBLOCKING, abortedToken));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(normal, Os::Queue::BlockingType::NONBLOCKING, normalToken));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(urgent, Os::Queue::BlockingType::NONBLOCKING, urgentToken));
+    ASSERT_EQ(Os::Queue::Status::FULL, queue.reserve(aborted, Os::Queue::BlockingType::NONBLOCKING, abortedToken));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.abort(abortedToken));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, normal.serializeFrom(static_cast<U32>(1)));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(normal, normalToken, Os::Generic::MpscQueue::PRIORITY));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, urgent.serializeFrom(static_cast<U32>(2)));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(urgent, urgentToken, Os::Generic::MpscQueue::PRIORITY + 1));
+
+    // The aborted slot holds its room until the receiver reaches it
+    ASSERT_EQ(depth, queue.getMessagesAvailable());
+    Fw::ExternalSerializeBuffer message;
+    FwQueuePriorityType priority = 0;
+    FwSizeType token = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+    ASSERT_EQ(depth - 1, queue.getMessagesAvailable());
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(aborted, Os::Queue::BlockingType::NONBLOCKING, abortedToken));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.abort(abortedToken));
+
+    // The urgent message is peeked again with the same token, then received
+    FwSizeType peeked = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, peeked));
+    ASSERT_EQ(token, peeked);
+    U8 storage[sizeof(U32)];
+    Fw::ExternalSerializeBuffer received(storage, sizeof storage);
+    U32 value = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.receive(received, Os::Queue::BlockingType::NONBLOCKING, priority));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, received.deserializeTo(value));
+    ASSERT_EQ(2, value);
+    ASSERT_EQ(Os::Generic::MpscQueue::PRIORITY + 1, priority);
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.receive(received, Os::Queue::BlockingType::NONBLOCKING, priority));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, received.deserializeTo(value));
+    ASSERT_EQ(1, value);
+    ASSERT_EQ(Os::Queue::Status::EMPTY, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+    ASSERT_EQ(0, queue.getMessagesAvailable());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
@@ -3,9 +3,111 @@
 // \brief tests using generic priority implementation for Os::Queue interface testing
 // ======================================================================
 #include <gtest/gtest.h>
+#include "Fw/Types/String.hpp"
 #include "Os/Generic/PriorityQueue.hpp"
+#include "Os/Queue.hpp"
 #include "STest/Random/Random.hpp"
 
+// Messages serialized into reserved slots are received in priority order and slots count against the depth until
+// released
+TEST(PriorityQueue, ReserveCommitPeekRelease) {
+    const FwSizeType depth = 3;
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("PriorityQueue"), depth, sizeof(U32)));
+
+    // Fill the queue in place with priorities 0, 2, 1; an open reservation holds its slot
+    Fw::ExternalSerializeBuffer message;
+    FwSizeType tokens[depth];
+    for (U32 i = 0; i < depth; i++) {
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(message, Os::Queue::BlockingType::NONBLOCKING, tokens[i]));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.serializeFrom(i));
+        ASSERT_EQ(Os::Queue::Status::OP_OK,
+                  queue.commit(message, tokens[i], static_cast<FwQueuePriorityType>((i * 2) % depth)));
+    }
+    ASSERT_EQ(depth, queue.getMessagesAvailable());
+    ASSERT_EQ(Os::Queue::Status::FULL, queue.reserve(message, Os::Queue::BlockingType::NONBLOCKING, tokens[0]));
+
+    // A peeked message counts as available and holds its slot until released
+    const U32 expected[depth] = {1, 2, 0};
+    for (U32 i = 0; i < depth; i++) {
+        FwQueuePriorityType priority = 0;
+        FwSizeType token = 0;
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+        U32 value = 0;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.deserializeTo(value));
+        ASSERT_EQ(expected[i], value);
+        ASSERT_EQ(static_cast<FwQueuePriorityType>((value * 2) % depth), priority);
+        ASSERT_EQ(depth - i, queue.getMessagesAvailable());
+        if (i == 0) {
+            FwSizeType reserved = 0;
+            ASSERT_EQ(Os::Queue::Status::FULL, queue.reserve(message, Os::Queue::BlockingType::NONBLOCKING, reserved));
+        }
+        ASSERT_EQ(Os::Queue::Status::OP_OK, queue.release(token));
+    }
+    FwQueuePriorityType priority = 0;
+    FwSizeType token = 0;
+    ASSERT_EQ(Os::Queue::Status::EMPTY, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+    ASSERT_EQ(depth, queue.getMessageHighWaterMark());
+}
+
+// An aborted reservation frees its slot without a message, and a peeked message stays the next message until released
+TEST(PriorityQueue, AbortAndRepeatedPeek) {
+    const FwSizeType depth = 2;
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("PriorityQueue"), depth, sizeof(U32)));
+
+    // Fill the queue with reservations, then abort one to make room again
+    Fw::ExternalSerializeBuffer message;
+    FwSizeType aborted = 0;
+    FwSizeType low = 0;
+    FwSizeType high = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(message, Os::Queue::BlockingType::NONBLOCKING, aborted));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(message, Os::Queue::BlockingType::NONBLOCKING, low));
+    ASSERT_EQ(depth, queue.getMessagesAvailable());
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.abort(aborted));
+    ASSERT_EQ(depth - 1, queue.getMessagesAvailable());
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.serializeFrom(static_cast<U32>(1)));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(message, low, 0));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.reserve(message, Os::Queue::BlockingType::NONBLOCKING, high));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.serializeFrom(static_cast<U32>(2)));
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.commit(message, high, 1));
+
+    // Peeking twice without a release sees the same message and token
+    FwQueuePriorityType priority = 0;
+    FwSizeType token = 0;
+    for (U32 pass = 0; pass < 2; pass++) {
+        FwSizeType peeked = 0;
+        ASSERT_EQ(Os::Queue::Status::OP_OK,
+                  queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, peeked));
+        U32 value = 0;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.deserializeTo(value));
+        ASSERT_EQ(2, value);
+        ASSERT_EQ(1, priority);
+        if (pass > 0) {
+            ASSERT_EQ(token, peeked);
+        }
+        token = peeked;
+        ASSERT_EQ(depth, queue.getMessagesAvailable());
+    }
+
+    // Receiving returns and releases the peeked message
+    U8 storage[sizeof(U32)];
+    Fw::ExternalSerializeBuffer received(storage, sizeof storage);
+    U32 value = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.receive(received, Os::Queue::BlockingType::NONBLOCKING, priority));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, received.deserializeTo(value));
+    ASSERT_EQ(2, value);
+    ASSERT_EQ(1, priority);
+    ASSERT_EQ(depth - 1, queue.getMessagesAvailable());
+
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, message.deserializeTo(value));
+    ASSERT_EQ(1, value);
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.release(token));
+    ASSERT_EQ(0, queue.getMessagesAvailable());
+    ASSERT_EQ(Os::Queue::Status::EMPTY, queue.peek(message, Os::Queue::BlockingType::NONBLOCKING, priority, token));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     STest::Random::seed();
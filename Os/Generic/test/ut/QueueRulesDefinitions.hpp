@@ -5,10 +5,12 @@
 #ifndef OS_STUB_TEST_UT_QUEUE_RULES_DEFINITIONS
 #define OS_STUB_TEST_UT_QUEUE_RULES_DEFINITIONS
 #include <deque>
+#include <limits>
 #include <queue>
 #include "Fw/FPrimeBasicTypes.hpp"
 using PriorityCompare = std::less<FwQueuePriorityType>;
 constexpr FwSizeType QUEUE_MESSAGE_SIZE_UPPER_BOUND = 1024;
 constexpr FwSizeType QUEUE_DEPTH_UPPER_BOUND = 100;
+constexpr U32 QUEUE_PRIORITY_UPPER_BOUND = std::numeric_limits<I8>::max();
 constexpr bool TESTS_SUPPORT_BLOCKING = true;
 #endif  // OS_STUB_TEST_UT_QUEUE_RULES_DEFINITIONS
@@ -319,6 +319,90 @@ PosixFile::Status PosixFile::write(const U8* buffer, FwSizeType& size, PosixFile
     return status;
 }
 
+PosixFile::Status PosixFile::readAt(U8* buffer, FwSizeType& size, FwSizeType offset, PosixFile::WaitType wait) {
+    Status status = OP_OK;
+    FwSizeType accumulated = 0;
+    // POSIX APIs are implementation dependent when dealing with sizes larger than the signed return value
+    // thus we ensure a clear decision: BAD_SIZE. The same holds for offsets past the end of off_t.
+    if ((size > SSIZE_T_MAX_LIMIT) || (offset > OFF_T_MAX_LIMIT) || (size > (OFF_T_MAX_LIMIT - offset))) {
+        size = 0;
+        return BAD_SIZE;
+    }
+
+    while (accumulated < size) {
+        // char* for some posix implementations
+        ssize_t read_size =
+            ::pread(this->m_handle.m_file_descriptor, reinterpret_cast<CHAR*>(&buffer[accumulated]),
+                    static_cast<size_t>(size - accumulated), static_cast<off_t>(offset + accumulated));
+        if (PosixFileHandle::ERROR_RETURN_VALUE == read_size) {
+            int errno_store = errno;
+            // Interrupted w/o read, try again
+            if (EINTR == errno_store) {
+                continue;
+            }
+            status = Os::Posix::errno_to_file_status(errno_store);
+            break;
+        }
+        // End-of-file
+        else if (read_size == 0) {
+            break;
+        }
+        accumulated += static_cast<FwSizeType>(read_size);
+        // Stop looping when we had a good read and are not waiting
+        if (not wait) {
+            break;
+        }
+    }
+    size = accumulated;
+    return status;
+}
+
+PosixFile::Status PosixFile::writeAt(const U8* buffer,
+                                     FwSizeType& size,
+                                     FwSizeType offset,
+                                     PosixFile::WaitType wait) {
+    Status status = OP_OK;
+    FwSizeType accumulated = 0;
+    // POSIX APIs are implementation dependent when dealing with sizes larger than the signed return value
+    // thus we ensure a clear decision: BAD_SIZE. The same holds for offsets past the end of off_t.
+    if ((size > SSIZE_T_MAX_LIMIT) || (offset > OFF_T_MAX_LIMIT) || (size > (OFF_T_MAX_LIMIT - offset))) {
+        size = 0;
+        return BAD_SIZE;
+    }
+
+    while (accumulated < size) {
+        // char* for some posix implementations
+        ssize_t write_size =
+            ::pwrite(this->m_handle.m_file_descriptor, reinterpret_cast<const CHAR*>(&buffer[accumulated]),
+                     static_cast<size_t>(size - accumulated), static_cast<off_t>(offset + accumulated));
+        if (PosixFileHandle::ERROR_RETURN_VALUE == write_size || write_size < 0) {
+            int errno_store = errno;
+            // Interrupted w/o write, try again
+            if (EINTR == errno_store) {
+                continue;
+            }
+            status = Os::Posix::errno_to_file_status(errno_store);
+            break;
+        }
+        // No progress without an error, stop rather than spin
+        else if (write_size == 0) {
+            status = NO_SPACE;
+            break;
+        }
+        accumulated += static_cast<FwSizeType>(write_size);
+    }
+    size = accumulated;
+    // When waiting, sync to disk
+    if ((status == OP_OK) && wait) {
+        int fsync_return = ::fsync(this->m_handle.m_file_descriptor);
+        if (PosixFileHandle::ERROR_RETURN_VALUE == fsync_return) {
+            int errno_store = errno;
+            status = Os::Posix::errno_to_file_status(errno_store);
+        }
+    }
+    return status;
+}
+
 FileHandle* PosixFile::getHandle() {
     return &this->m_handle;
 }
@@ -86,6 +86,62 @@ QueueInterface::Status Queue::receive(U8* destination,
     return this->m_delegate.receive(destination, capacity, blockType, actualSize, priority);
 }
 
+QueueInterface::Status Queue::reserve(QueueInterface::BlockingType blockType,
+                                      U8*& slot,
+                                      FwSizeType& capacity,
+                                      FwSizeType& token) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<QueueInterface*>(&this->m_handle_storage[0]));
+    // Check if initialized
+    if (this->m_depth == 0 || this->m_size == 0) {
+        return QueueInterface::Status::UNINITIALIZED;
+    }
+    return this->m_delegate.reserve(blockType, slot, capacity, token);
+}
+
+QueueInterface::Status Queue::commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<QueueInterface*>(&this->m_handle_storage[0]));
+    // Check if initialized
+    if (this->m_depth == 0 || this->m_size == 0) {
+        return QueueInterface::Status::UNINITIALIZED;
+    }
+    // Check size before proceeding
+    else if (size > this->getMessageSize()) {
+        return QueueInterface::Status::SIZE_MISMATCH;
+    }
+    return this->m_delegate.commit(token, size, priority);
+}
+
+QueueInterface::Status Queue::abort(FwSizeType token) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<QueueInterface*>(&this->m_handle_storage[0]));
+    // Check if initialized
+    if (this->m_depth == 0 || this->m_size == 0) {
+        return QueueInterface::Status::UNINITIALIZED;
+    }
+    return this->m_delegate.abort(token);
+}
+
+QueueInterface::Status Queue::peek(QueueInterface::BlockingType blockType,
+                                   U8*& message,
+                                   FwSizeType& actualSize,
+                                   FwQueuePriorityType& priority,
+                                   FwSizeType& token) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<QueueInterface*>(&this->m_handle_storage[0]));
+    // Check if initialized
+    if (this->m_depth == 0 || this->m_size == 0) {
+        return QueueInterface::Status::UNINITIALIZED;
+    }
+    return this->m_delegate.peek(blockType, message, actualSize, priority, token);
+}
+
+QueueInterface::Status Queue::release(FwSizeType token) {
+    FW_ASSERT(&this->m_delegate == reinterpret_cast<QueueInterface*>(&this->m_handle_storage[0]));
+    // Check if initialized
+    if (this->m_depth == 0 || this->m_size == 0) {
+        return QueueInterface::Status::UNINITIALIZED;
+    }
+    return this->m_delegate.release(token);
+}
+
 FwSizeType Queue::getMessagesAvailable() const {
     FW_ASSERT(&this->m_delegate == reinterpret_cast<const QueueInterface*>(&this->m_handle_storage[0]));
     return this->m_delegate.getMessagesAvailable();
@@ -124,6 +180,43 @@ QueueInterface::Status Queue::receive(Fw::LinearBufferBase& destination,
     return status;
 }
 
+QueueInterface::Status Queue::reserve(Fw::ExternalSerializeBuffer& message,
+                                      QueueInterface::BlockingType blockType,
+                                      FwSizeType& token) {
+    U8* slot = nullptr;
+    FwSizeType capacity = 0;
+    QueueInterface::Status status = this->reserve(blockType, slot, capacity, token);
+    if (status == QueueInterface::Status::OP_OK) {
+        FW_ASSERT(slot != nullptr);
+        message.setExtBuffer(slot, static_cast<Fw::Serializable::SizeType>(capacity));
+    }
+    return status;
+}
+
+QueueInterface::Status Queue::commit(const Fw::ExternalSerializeBuffer& message,
+                                     FwSizeType token,
+                                     FwQueuePriorityType priority) {
+    return this->commit(token, message.getSize(), priority);
+}
+
+QueueInterface::Status Queue::peek(Fw::ExternalSerializeBuffer& message,
+                                   QueueInterface::BlockingType blockType,
+                                   FwQueuePriorityType& priority,
+                                   FwSizeType& token) {
+    U8* data = nullptr;
+    FwSizeType actualSize = 0;
+    QueueInterface::Status status = this->peek(blockType, data, actualSize, priority, token);
+    if (status == QueueInterface::Status::OP_OK) {
+        FW_ASSERT(data != nullptr);
+        message.setExtBuffer(data, static_cast<Fw::Serializable::SizeType>(actualSize));
+        Fw::SerializeStatus serializeStatus =
+            message.setBuffLen(static_cast<Fw::Serializable::SizeType>(actualSize));
+        FW_ASSERT(serializeStatus == Fw::SerializeStatus::FW_SERIALIZE_OK,
+                  static_cast<FwAssertArgType>(serializeStatus));
+    }
+    return status;
+}
+
 FwSizeType Queue::getDepth() const {
     return this->m_depth;
 }
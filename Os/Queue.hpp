@@ -124,6 +124,112 @@ class QueueInterface {
                            FwSizeType& actualSize,
                            FwQueuePriorityType& priority) = 0;
 
+    //! \brief reserve a message slot in the queue for in-place writing
+    //!
+    //! Reserve storage for one message so the sender can write (e.g. serialize) the message directly into the queue
+    //! instead of into a separate buffer that `send` then copies. When `blockType` is set to BLOCKING, this call will
+    //! block on queue full. Otherwise, this will return an error status on queue full. On success, `slot` points to
+    //! `capacity` bytes of message storage and `token` identifies the reservation.
+    //!
+    //! Every successful reservation must be followed by exactly one `commit` or `abort` with its token. The reserved
+    //! slot counts against the queue depth, and in `getMessagesAvailable`, from the reservation until the committed
+    //! message is received or the reservation is aborted.
+    //!
+    //! Note: the default implementation returns NOT_SUPPORTED.
+    //!
+    //! \param blockType: BLOCKING to block for space or NONBLOCKING to return error when queue is full
+    //! \param slot: (output) message storage to write into
+    //! \param capacity: (output) size of the message storage
+    //! \param token: (output) reservation token to pass to commit
+    //! \return: status of the reservation
+    virtual Status reserve(BlockingType blockType, U8*& slot, FwSizeType& capacity, FwSizeType& token) {
+        (void)blockType;
+        (void)slot;
+        (void)capacity;
+        (void)token;
+        return Status::NOT_SUPPORTED;
+    }
+
+    //! \brief commit a reserved message slot into the queue
+    //!
+    //! Make the message written into a reserved slot available to the receiver, as `send` would have. On
+    //! SIZE_MISMATCH the reservation stays open and must still be committed or aborted.
+    //!
+    //! Note: the default implementation returns NOT_SUPPORTED.
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \param size: size of the message written into the slot
+    //! \param priority: priority of the message
+    //! \return: status of the commit
+    virtual Status commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) {
+        (void)token;
+        (void)size;
+        (void)priority;
+        return Status::NOT_SUPPORTED;
+    }
+
+    //! \brief abort a reservation without sending a message
+    //!
+    //! Give a reserved slot back to the queue, for a sender that fails after reserving, e.g. when serialization fails.
+    //! No message is received from the slot. A queue that receives slots in reservation order may keep counting the
+    //! slot until the receiver reaches it.
+    //!
+    //! Note: the default implementation returns NOT_SUPPORTED.
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \return: status of the abort
+    virtual Status abort(FwSizeType token) {
+        (void)token;
+        return Status::NOT_SUPPORTED;
+    }
+
+    //! \brief read the next message from the queue in place
+    //!
+    //! Read the message `receive` would return, without copying it. On success, `message` points to `actualSize`
+    //! bytes of message data inside the queue, which stay valid and are not reused until `release` is called with
+    //! `token`. When `blockType` is set to BLOCKING, this call will block on queue empty. Otherwise, this will return
+    //! an error status on queue empty.
+    //!
+    //! At most one message is peeked at a time. The peeked message stays the next message of the queue until it is
+    //! released: peeking again returns the same message and token, and `receive` returns the peeked message and
+    //! releases it. It counts against the queue depth, and in `getMessagesAvailable`, until it is released. Peek and
+    //! release are meant for a single receiving task; tasks sharing a queue must not peek concurrently.
+    //!
+    //! Note: the default implementation returns NOT_SUPPORTED.
+    //!
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param message: (output) message data to read from
+    //! \param actualSize: (output) size of the message
+    //! \param priority: (output) priority of the message
+    //! \param token: (output) token to pass to release
+    //! \return: status of the peek
+    virtual Status peek(BlockingType blockType,
+                        U8*& message,
+                        FwSizeType& actualSize,
+                        FwQueuePriorityType& priority,
+                        FwSizeType& token) {
+        (void)blockType;
+        (void)message;
+        (void)actualSize;
+        (void)priority;
+        (void)token;
+        return Status::NOT_SUPPORTED;
+    }
+
+    //! \brief release a peeked message slot back to the queue
+    //!
+    //! Remove the peeked message from the queue, as `receive` would have. `token` must be the token returned by the
+    //! peek.
+    //!
+    //! Note: the default implementation returns NOT_SUPPORTED.
+    //!
+    //! \param token: token returned by peek
+    //! \return: status of the release
+    virtual Status release(FwSizeType token) {
+        (void)token;
+        return Status::NOT_SUPPORTED;
+    }
+
     //! \brief get number of messages available
     //!
     //! Returns the number of messages currently available in the queue.
@@ -241,6 +347,64 @@ class Queue final : public QueueInterface {
                    FwSizeType& actualSize,
                    FwQueuePriorityType& priority) override;
 
+    //! \brief reserve a message slot in the queue through delegate
+    //!
+    //! Reserve storage for one message to be written in place. See: QueueInterface::reserve. This method delegates to
+    //! the underlying implementation.
+    //!
+    //! \warning This method will block if the queue is full and blockType is set to BLOCKING
+    //!
+    //! \param blockType: BLOCKING to block for space or NONBLOCKING to return error when queue is full
+    //! \param slot: (output) message storage to write into
+    //! \param capacity: (output) size of the message storage
+    //! \param token: (output) reservation token to pass to commit
+    //! \return: status of the reservation
+    Status reserve(BlockingType blockType, U8*& slot, FwSizeType& capacity, FwSizeType& token) override;
+
+    //! \brief commit a reserved message slot into the queue through delegate
+    //!
+    //! See: QueueInterface::commit. This method delegates to the underlying implementation.
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \param size: size of the message written into the slot
+    //! \param priority: priority of the message
+    //! \return: status of the commit
+    Status commit(FwSizeType token, FwSizeType size, FwQueuePriorityType priority) override;
+
+    //! \brief abort a reservation without sending a message through delegate
+    //!
+    //! See: QueueInterface::abort. This method delegates to the underlying implementation.
+    //!
+    //! \param token: reservation token returned by reserve
+    //! \return: status of the abort
+    Status abort(FwSizeType token) override;
+
+    //! \brief read the next message from the queue in place through delegate
+    //!
+    //! See: QueueInterface::peek. This method delegates to the underlying implementation.
+    //!
+    //! \warning This method will block if the queue is empty and blockType is set to BLOCKING
+    //!
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param message: (output) message data to read from
+    //! \param actualSize: (output) size of the message
+    //! \param priority: (output) priority of the message
+    //! \param token: (output) token to pass to release
+    //! \return: status of the peek
+    Status peek(BlockingType blockType,
+                U8*& message,
+                FwSizeType& actualSize,
+                FwQueuePriorityType& priority,
+                FwSizeType& token) override;
+
+    //! \brief release a peeked message slot back to the queue through delegate
+    //!
+    //! See: QueueInterface::release. This method delegates to the underlying implementation.
+    //!
+    //! \param token: token returned by peek
+    //! \return: status of the release
+    Status release(FwSizeType token) override;
+
     //! \brief get number of messages available
     //!
     //! Returns the number of messages currently available in the queue. This method delegates to the underlying
@@ -285,6 +449,45 @@ class Queue final : public QueueInterface {
     //! \return status of the send
     Status receive(Fw::LinearBufferBase& destination, BlockingType blockType, FwQueuePriorityType& priority);
 
+    //! \brief reserve a message slot for serializing a message in place
+    //!
+    //! Reserve a message slot and point `message` at it, so the message can be serialized directly into the queue.
+    //! Follow with `commit(message, token, priority)`, or `abort(token)` if the message cannot be serialized. See:
+    //! QueueInterface::reserve
+    //!
+    //! \warning This method will block if the queue is full and blockType is set to BLOCKING
+    //!
+    //! \param message: (output) serialize buffer set to the reserved slot
+    //! \param blockType: BLOCKING to block for space or NONBLOCKING to return error when queue is full
+    //! \param token: (output) reservation token to pass to commit
+    //! \return status of the reservation
+    Status reserve(Fw::ExternalSerializeBuffer& message, BlockingType blockType, FwSizeType& token);
+
+    //! \brief commit a message serialized in place into a reserved slot
+    //!
+    //! \param message: serialize buffer set by reserve, holding the serialized message
+    //! \param token: reservation token returned by reserve
+    //! \param priority: priority of the message
+    //! \return status of the commit
+    Status commit(const Fw::ExternalSerializeBuffer& message, FwSizeType token, FwQueuePriorityType priority);
+
+    //! \brief read the next message for deserializing in place
+    //!
+    //! Read the next message and point `message` at it, so the message can be deserialized directly from the queue.
+    //! Follow with `release(token)`. See: QueueInterface::peek
+    //!
+    //! \warning This method will block if the queue is empty and blockType is set to BLOCKING
+    //!
+    //! \param message: (output) serialize buffer set to the message, ready for deserialization
+    //! \param blockType: BLOCKING to wait for message or NONBLOCKING to return error when queue is empty
+    //! \param priority: (output) priority of the message
+    //! \param token: (output) token to pass to release
+    //! \return status of the peek
+    Status peek(Fw::ExternalSerializeBuffer& message,
+                BlockingType blockType,
+                FwQueuePriorityType& priority,
+                FwSizeType& token);
+
     //! \brief get the queue's depth in messages
     FwSizeType getDepth() const;
 
@@ -50,6 +50,19 @@ StubFile::Status StubFile::write(const U8* buffer, FwSizeType& size, StubFile::W
     return status;
 }
 
+StubFile::Status StubFile::readAt(U8* buffer, FwSizeType& size, FwSizeType offset, StubFile::WaitType wait) {
+    Status status = Status::NOT_SUPPORTED;
+    return status;
+}
+
+StubFile::Status StubFile::writeAt(const U8* buffer,
+                                   FwSizeType& size,
+                                   FwSizeType offset,
+                                   StubFile::WaitType wait) {
+    Status status = Status::NOT_SUPPORTED;
+    return status;
+}
+
 FileHandle* StubFile::getHandle() {
     return &this->m_handle;
 }
@@ -129,6 +129,39 @@ FileInterface::Status TestFile::write(const U8* buffer, FwSizeType& size, WaitTy
     return StaticData::data.writeStatus;
 }
 
+FileInterface::Status TestFile::readAt(U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) {
+    StaticData::data.readBuffer = buffer;
+    StaticData::data.readSize = size;
+    StaticData::data.readOffset = offset;
+    StaticData::data.readWait = wait;
+    StaticData::data.lastCalled = StaticData::READ_AT_FN;
+    // Copy read data from the offset if set, leaving the file pointer unchanged
+    if (nullptr != StaticData::data.readResult) {
+        size = (offset >= StaticData::data.readResultSize) ? 0 : FW_MIN(size, StaticData::data.readResultSize - offset);
+        (void)::memcpy(buffer, StaticData::data.readResult + offset, static_cast<size_t>(size));
+    } else {
+        size = StaticData::data.readSizeResult;
+    }
+    return StaticData::data.readStatus;
+}
+
+FileInterface::Status TestFile::writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) {
+    StaticData::data.writeBuffer = buffer;
+    StaticData::data.writeSize = size;
+    StaticData::data.writeOffset = offset;
+    StaticData::data.writeWait = wait;
+    StaticData::data.lastCalled = StaticData::WRITE_AT_FN;
+    // Copy written data to the offset if set, leaving the file pointer unchanged
+    if (nullptr != StaticData::data.writeResult) {
+        size =
+            (offset >= StaticData::data.writeResultSize) ? 0 : FW_MIN(size, StaticData::data.writeResultSize - offset);
+        (void)::memcpy(StaticData::data.writeResult + offset, buffer, static_cast<size_t>(size));
+    } else {
+        size = StaticData::data.writeSizeResult;
+    }
+    return StaticData::data.writeStatus;
+}
+
 FileHandle* TestFile::getHandle() {
     return &this->m_handle;
 }
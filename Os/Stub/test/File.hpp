@@ -25,7 +25,9 @@ struct StaticData {
         SEEK_FN,
         FLUSH_FN,
         READ_FN,
-        WRITE_FN
+        WRITE_FN,
+        READ_AT_FN,
+        WRITE_AT_FN
     };
 
     //! Last function called
@@ -50,12 +52,16 @@ struct StaticData {
     FwSizeType readSize = std::numeric_limits<FwSizeType>::max();
     //! Wait of last read call
     Os::File::WaitType readWait = Os::File::WaitType::NO_WAIT;
+    //! Offset of last readAt call
+    FwSizeType readOffset = std::numeric_limits<FwSizeType>::max();
     //! Buffer of last write call
     const void* writeBuffer = nullptr;
     //! Size of last write call
     FwSizeType writeSize = std::numeric_limits<FwSizeType>::max();
     //! Wait of last write call
     Os::File::WaitType writeWait = Os::File::WaitType::NO_WAIT;
+    //! Offset of last writeAt call
+    FwSizeType writeOffset = std::numeric_limits<FwSizeType>::max();
 
     //! File pointer
     FwSizeType pointer = 0;
@@ -256,6 +262,47 @@ class TestFile : public FileInterface {
     //!
     Status write(const U8* buffer, FwSizeType& size, WaitType wait) override;
 
+    //! \brief read data from the given offset of this file into supplied buffer bounded by size
+    //!
+    //! Read data from this file starting at `offset` up to the `size` and store it in `buffer`, without using or
+    //! moving the file pointer. When `wait` is set to `WAIT`, this will block until the requested size has been read
+    //! or the end of the file has been reached. When `wait` is set to `NO_WAIT` it will return whatever data is
+    //! currently available.
+    //!
+    //! `size` will be updated to the count of bytes actually read. Status will reflect the success/failure of
+    //! the read operation.
+    //!
+    //! It is invalid to pass `nullptr` to this function call.
+    //! It is invalid to supply wait as a non-enumerated value.
+    //!
+    //! \param buffer: memory location to store data read from file
+    //! \param size: size of data to read
+    //! \param offset: offset from the beginning of the file to read from
+    //! \param wait: `WAIT` to wait for data, `NO_WAIT` to return what is currently available
+    //! \return OP_OK on success otherwise error status
+    //!
+    Status readAt(U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) override;
+
+    //! \brief write data from the supplied buffer to the given offset of this file bounded by size
+    //!
+    //! Write data to this file starting at `offset` up to the `size` from the `buffer`, without using or moving the
+    //! file pointer. When `wait` is set to `WAIT`, this will block until the requested size has been written
+    //! successfully to disk. When `wait` is set to `NO_WAIT` it will return once the data is sent to the OS.
+    //!
+    //! `size` will be updated to the count of bytes actually written. Status will reflect the success/failure of
+    //! the write operation.
+    //!
+    //! It is invalid to pass `nullptr` to this function call.
+    //! It is invalid to supply wait as a non-enumerated value.
+    //!
+    //! \param buffer: memory location of data to write to file
+    //! \param size: size of data to write
+    //! \param offset: offset from the beginning of the file to write to
+    //! \param wait: `WAIT` to wait for data to write to disk, `NO_WAIT` to return once data is sent to the OS
+    //! \return OP_OK on success otherwise error status
+    //!
+    Status writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) override;
+
     //! \brief returns the raw file handle
     //!
     //! Gets the raw file handle from the implementation. Note: users must include the implementation specific
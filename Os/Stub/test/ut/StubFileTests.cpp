@@ -193,6 +193,40 @@ TEST_F(Interface, Write) {
     ASSERT_EQ(Os::Stub::File::Test::StaticData::data.writeWait, Os::File::WaitType::WAIT);
 }
 
+// Ensure that Os::File properly routes readAt calls to the implementation
+TEST_F(Interface, ReadAt) {
+    U8 buffer[] = {0xab, 0xcd, 0xef};
+    FwSizeType size = static_cast<FwSizeType>(sizeof buffer);
+    FwSizeType original_size = size;
+    Os::File file;
+    Os::Stub::File::Test::StaticData::setNextStatus(Os::File::OP_OK);
+    ASSERT_EQ(file.open("/does/not/matter", Os::File::OPEN_READ, Os::File::OverwriteType::OVERWRITE), Os::File::OP_OK);
+    Os::Stub::File::Test::StaticData::setNextStatus(Os::File::OTHER_ERROR);
+    ASSERT_EQ(file.readAt(buffer, size, 42, Os::File::WaitType::WAIT), Os::File::Status::OTHER_ERROR);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.lastCalled, Os::Stub::File::Test::StaticData::READ_AT_FN);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.readBuffer, buffer);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.readSize, original_size);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.readOffset, 42);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.readWait, Os::File::WaitType::WAIT);
+}
+
+// Ensure that Os::File properly routes writeAt calls to the implementation
+TEST_F(Interface, WriteAt) {
+    U8 buffer[] = {0xab, 0xcd, 0xef};
+    FwSizeType size = static_cast<FwSizeType>(sizeof buffer);
+    FwSizeType original_size = size;
+    Os::File file;
+    Os::Stub::File::Test::StaticData::setNextStatus(Os::File::OP_OK);
+    ASSERT_EQ(file.open("/does/not/matter", Os::File::OPEN_WRITE, Os::File::OverwriteType::OVERWRITE), Os::File::OP_OK);
+    Os::Stub::File::Test::StaticData::setNextStatus(Os::File::OTHER_ERROR);
+    ASSERT_EQ(file.writeAt(buffer, size, 42, Os::File::WaitType::WAIT), Os::File::Status::OTHER_ERROR);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.lastCalled, Os::Stub::File::Test::StaticData::WRITE_AT_FN);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.writeBuffer, buffer);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.writeSize, original_size);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.writeOffset, 42);
+    ASSERT_EQ(Os::Stub::File::Test::StaticData::data.writeWait, Os::File::WaitType::WAIT);
+}
+
 int main(int argc, char** argv) {
     Os::init();
     ::testing::InitGoogleTest(&argc, argv);
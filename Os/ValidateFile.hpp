@@ -57,6 +57,11 @@ Status createValidation(const char* fileName,
                         const char* hashFileName);  //!< Create a validation of the file 'fileName' and store it in
                                                     //!< in a file 'hashFileName'
 
+// without reading the file
+Status writeValidation(const char* hashFileName,
+                       const Utils::HashBuffer& hashBuffer);  //!< Store the already computed hash of a file in a
+                                                              //!< file 'hashFileName'
+
 }  // namespace ValidateFile
 }  // namespace Os
 
@@ -221,4 +221,13 @@ ValidateFile::Status ValidateFile::createValidation(const char* fileName, const
     return createValidation(fileName, hashFileName, hashBuffer);
 }
 
+ValidateFile::Status ValidateFile::writeValidation(const char* hashFileName, const Utils::HashBuffer& hashBuffer) {
+    const File::Status status = writeHash(hashFileName, hashBuffer);
+    if (File::OP_OK != status) {
+        return translateStatus(status, HashFileType);
+    }
+
+    return ValidateFile::VALIDATION_OK;
+}
+
 }  // namespace Os
@@ -11,14 +11,23 @@
 // ======================================================================
 
 #include "Os/ValidatedFile.hpp"
-#include "Utils/Hash/Hash.hpp"
 
 namespace Os {
 
-ValidatedFile ::ValidatedFile(const char* const fileName) : m_fileName(fileName), m_hashFileName(""), m_hashBuffer() {
+ValidatedFile ::ValidatedFile()
+    : m_fileName(""), m_hashFileName(""), m_hashBuffer(), m_runningHash(), m_runningHashValid(false) {}
+
+ValidatedFile ::ValidatedFile(const char* const fileName)
+    : m_fileName(fileName), m_hashFileName(""), m_hashBuffer(), m_runningHash(), m_runningHashValid(false) {
     Utils::Hash::addFileExtension(this->m_fileName, this->m_hashFileName);
 }
 
+void ValidatedFile ::setFileName(const char* const fileName) {
+    this->m_fileName = fileName;
+    Utils::Hash::addFileExtension(this->m_fileName, this->m_hashFileName);
+    this->m_runningHashValid = false;
+}
+
 Os::ValidateFile::Status ValidatedFile ::validate() {
     const Os::ValidateFile::Status status =
         Os::ValidateFile::validate(this->m_fileName.toChar(), this->m_hashFileName.toChar(), this->m_hashBuffer);
@@ -31,6 +40,59 @@ Os::ValidateFile::Status ValidatedFile ::createHashFile() {
     return status;
 }
 
+void ValidatedFile ::startRunningHash() {
+    this->m_runningHash.init();
+    this->m_runningHashValid = true;
+}
+
+Os::File::Status ValidatedFile ::writeAndHash(Os::File& file,
+                                              const U8* const data,
+                                              FwSizeType& size,
+                                              Os::File::WaitType wait) {
+    const FwSizeType requested = size;
+    const Os::File::Status status = file.write(data, size, wait);
+    this->hashWrite(status, data, requested, size);
+    return status;
+}
+
+Os::File::Status ValidatedFile ::writeAndHash(Os::BufferedFile& file,
+                                              const U8* const data,
+                                              FwSizeType& size,
+                                              Os::File::WaitType wait) {
+    const FwSizeType requested = size;
+    const Os::File::Status status = file.write(data, size, wait);
+    this->hashWrite(status, data, requested, size);
+    return status;
+}
+
+void ValidatedFile ::hashWrite(const Os::File::Status status,
+                               const U8* const data,
+                               const FwSizeType requested,
+                               const FwSizeType size) {
+    if ((Os::File::OP_OK == status) && (size <= requested)) {
+        this->updateRunningHash(data, size);
+    } else {
+        this->m_runningHashValid = false;
+    }
+}
+
+void ValidatedFile ::updateRunningHash(const U8* const data, const FwSizeType size) {
+    this->m_runningHash.update(data, size);
+}
+
+void ValidatedFile ::invalidateRunningHash() {
+    this->m_runningHashValid = false;
+}
+
+Os::ValidateFile::Status ValidatedFile ::createHashFileFromRunningHash() {
+    if (not this->m_runningHashValid) {
+        return this->createHashFile();
+    }
+    this->m_runningHashValid = false;
+    this->m_runningHash.final(this->m_hashBuffer);
+    return Os::ValidateFile::writeValidation(this->m_hashFileName.toChar(), this->m_hashBuffer);
+}
+
 const Fw::ConstStringBase& ValidatedFile ::getFileName() const {
     return this->m_fileName;
 }
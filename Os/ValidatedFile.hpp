@@ -15,17 +15,32 @@
 
 #include <Fw/FPrimeBasicTypes.hpp>
 #include "Fw/Types/String.hpp"
+#include "Os/BufferedFile.hpp"
+#include "Os/File.hpp"
 #include "Os/ValidateFile.hpp"
+#include "Utils/Hash/Hash.hpp"
 
 namespace Os {
 
 //! A validated file
+//!
+//! The hash file can be created by reading back the finished file with createHashFile. A writer that produces the
+//! file from its beginning can instead start a running hash, write through this object so that the hash is
+//! updated as bytes are written, and create the hash file from the running hash without reading the file again.
 class ValidatedFile {
   public:
+    //! Construct a validated file with no file name
+    ValidatedFile();
+
     //! Construct a validated file
     ValidatedFile(const char* const fileName  //!< The file name
     );
 
+  public:
+    //! Set the file name, and the hash file name derived from it
+    void setFileName(const char* const fileName  //!< The file name
+    );
+
   public:
     //! Validate the file
     //! \return Status
@@ -35,6 +50,43 @@ class ValidatedFile {
     //! \return Status
     Os::ValidateFile::Status createHashFile();
 
+  public:
+    //! Start a running hash of the file, which is about to be written from its beginning
+    void startRunningHash();
+
+    //! Write data to the file and add the bytes written to the running hash. If the write fails, the bytes that
+    //! reached the file are unknown and createHashFileFromRunningHash will read the file back instead.
+    //! \return The status of the write
+    Os::File::Status writeAndHash(Os::File& file,           //!< The open file, named by getFileName
+                                  const U8* const data,     //!< The data to write
+                                  FwSizeType& size,         //!< The size to write; updated to the size written
+                                  Os::File::WaitType wait   //!< Whether to wait for the data to reach the disk
+    );
+
+    //! Write data to the file through its block buffer and add the bytes accepted to the running hash. If the write
+    //! fails, buffered bytes already hashed may have been lost and createHashFileFromRunningHash will read the file
+    //! back instead.
+    //! \return The status of the write
+    Os::File::Status writeAndHash(Os::BufferedFile& file,   //!< The open file, named by getFileName
+                                  const U8* const data,     //!< The data to write
+                                  FwSizeType& size,         //!< The size to write; updated to the size accepted
+                                  Os::File::WaitType wait   //!< Whether to wait for the data to reach the disk
+    );
+
+    //! Add data already written to the file to the running hash
+    void updateRunningHash(const U8* const data,  //!< The data written
+                           const FwSizeType size  //!< The size written
+    );
+
+    //! Record that the file no longer matches the running hash, for example after a failed write made outside of
+    //! this object. createHashFileFromRunningHash will read the file back instead.
+    void invalidateRunningHash();
+
+    //! Create the hash file from the running hash, or by reading the file when the running hash is not valid.
+    //! The running hash is finished, so startRunningHash must be called again for the next file.
+    //! \return Status
+    Os::ValidateFile::Status createHashFileFromRunningHash();
+
   public:
     //! Get the file name
     //! \return The file name
@@ -48,6 +100,14 @@ class ValidatedFile {
     //! \return The hash file buffer
     const Utils::HashBuffer& getHashBuffer() const;
 
+  private:
+    //! Add a write to the running hash, or invalidate the running hash if the write failed
+    void hashWrite(const Os::File::Status status,  //!< The status of the write
+                   const U8* const data,           //!< The data to write
+                   const FwSizeType requested,     //!< The size to write
+                   const FwSizeType size           //!< The size written
+    );
+
   private:
     //! The file name
     Fw::String m_fileName;
@@ -57,6 +117,12 @@ class ValidatedFile {
 
     //! The hash value after creating or loading a validation file
     Utils::HashBuffer m_hashBuffer;
+
+    //! The running hash of the data written
+    Utils::Hash m_runningHash;
+
+    //! Whether the running hash covers all data written since startRunningHash
+    bool m_runningHashValid;
 };
 
 }  // namespace Os
@@ -0,0 +1,185 @@
+#include <Fw/Types/Assert.hpp>
+#include <Os/BufferedFile.hpp>
+#include <Os/File.hpp>
+#include <Os/FileSystem.hpp>
+#include <Os/ValidatedFile.hpp>
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+//! Size of the packets written by the throughput test, a typical telemetry packet
+const FwSizeType PACKET_SIZE = 100;
+
+//! Number of packets written by the packet test in the default suite
+const U32 CHECK_PACKET_COUNT = 1000;
+
+//! Number of packets written by the opt-in throughput test
+const U32 PACKET_COUNT = 100000;
+
+//! Read a whole file and compare it to the expected data
+void checkContents(const char* fileName, const U8* expected, FwSizeType size) {
+    FwSizeType fileSize = 0;
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFileSize(fileName, fileSize));
+    ASSERT_EQ(size, fileSize);
+    Os::File file;
+    ASSERT_EQ(Os::File::OP_OK, file.open(fileName, Os::File::OPEN_READ));
+    U8 contents[2048];
+    ASSERT_LE(size, sizeof(contents));
+    FwSizeType read = size;
+    ASSERT_EQ(Os::File::OP_OK, file.read(contents, read));
+    ASSERT_EQ(size, read);
+    ASSERT_EQ(0, ::memcmp(contents, expected, static_cast<size_t>(size)));
+    file.close();
+}
+
+//! Write ComLogger style records, a two byte length followed by a packet, check the file size and return the
+//! packets per second
+F64 packetRate(const char* fileName, FwSizeType blockSize, U32 count) {
+    U8 packet[PACKET_SIZE];
+    for (FwSizeType i = 0; i < PACKET_SIZE; i++) {
+        packet[i] = static_cast<U8>(i);
+    }
+    const U8 length[2] = {0, static_cast<U8>(PACKET_SIZE)};
+
+    Os::BufferedFile file;
+    file.setBlockSize(blockSize);
+    EXPECT_EQ(Os::File::OP_OK, file.open(fileName, Os::File::OPEN_WRITE));
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 i = 0; i < count; i++) {
+        FwSizeType size = sizeof(length);
+        EXPECT_EQ(Os::File::OP_OK, file.write(length, size, Os::File::WaitType::NO_WAIT));
+        size = PACKET_SIZE;
+        EXPECT_EQ(Os::File::OP_OK, file.write(packet, size, Os::File::WaitType::NO_WAIT));
+    }
+    EXPECT_EQ(Os::File::OP_OK, file.close());
+    const std::chrono::duration<F64> elapsed = std::chrono::steady_clock::now() - start;
+
+    FwSizeType fileSize = 0;
+    EXPECT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFileSize(fileName, fileSize));
+    EXPECT_EQ(static_cast<FwSizeType>(count) * (sizeof(length) + PACKET_SIZE), fileSize);
+    EXPECT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile(fileName));
+    return static_cast<F64>(count) / elapsed.count();
+}
+
+}  // namespace
+
+void testBufferedFile() {
+    const char fileName[] = "buffered_file.dat";
+    U8 data[2048];
+    for (FwSizeType i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<U8>(i * 13);
+    }
+
+    // Writes to a file that is not open fail without buffering anything
+    Os::BufferedFile file;
+    ASSERT_EQ(Os::BufferedFile::CAPACITY, file.getBlockSize());
+    FwSizeType size = 10;
+    ASSERT_EQ(Os::File::NOT_OPENED, file.write(data, size, Os::File::WaitType::WAIT));
+    ASSERT_EQ(0U, size);
+    ASSERT_EQ(0U, file.getBufferedSize());
+
+    // Small writes are gathered until the block is full, and large writes pass through after the buffered bytes
+    file.setBlockSize(64);
+    ASSERT_EQ(Os::File::OP_OK, file.open(fileName, Os::File::OPEN_WRITE));
+    ASSERT_TRUE(file.isOpen());
+    const FwSizeType sizes[] = {2, 30, 2, 30, 2, 100, 64, 63, 1, 1, 500, 5};
+    FwSizeType offset = 0;
+    Os::ValidatedFile validatedFile(fileName);
+    validatedFile.startRunningHash();
+    for (const FwSizeType requested : sizes) {
+        const FwSizeType buffered = file.getBufferedSize();
+        size = requested;
+        ASSERT_EQ(Os::File::OP_OK, validatedFile.writeAndHash(file, &data[offset], size, Os::File::WaitType::WAIT));
+        ASSERT_EQ(requested, size);
+        offset += requested;
+        if (requested >= file.getBlockSize()) {
+            ASSERT_EQ(0U, file.getBufferedSize());
+        } else if (buffered + requested <= file.getBlockSize()) {
+            ASSERT_EQ(buffered + requested, file.getBufferedSize());
+        } else {
+            ASSERT_EQ(requested, file.getBufferedSize());
+        }
+        FwSizeType fileSize = 0;
+        ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFileSize(fileName, fileSize));
+        ASSERT_EQ(offset - file.getBufferedSize(), fileSize);
+    }
+
+    // Flush writes out the buffered bytes
+    ASSERT_NE(0U, file.getBufferedSize());
+    ASSERT_EQ(Os::File::OP_OK, file.flush());
+    ASSERT_EQ(0U, file.getBufferedSize());
+    checkContents(fileName, data, offset);
+
+    // Writing the block writes out the buffered bytes of a record without closing the file
+    size = 9;
+    ASSERT_EQ(Os::File::OP_OK, validatedFile.writeAndHash(file, &data[offset], size, Os::File::WaitType::WAIT));
+    offset += size;
+    ASSERT_EQ(size, file.getBufferedSize());
+    ASSERT_EQ(Os::File::OP_OK, file.writeBlock());
+    ASSERT_EQ(0U, file.getBufferedSize());
+    checkContents(fileName, data, offset);
+    ASSERT_EQ(Os::File::OP_OK, file.writeBlock());
+
+    // Close writes out the buffered bytes
+    size = 7;
+    ASSERT_EQ(Os::File::OP_OK, validatedFile.writeAndHash(file, &data[offset], size, Os::File::WaitType::WAIT));
+    offset += size;
+    ASSERT_EQ(Os::File::OP_OK, file.close());
+    ASSERT_FALSE(file.isOpen());
+    checkContents(fileName, data, offset);
+
+    // The running hash of the accepted bytes validates the file
+    ASSERT_EQ(Os::ValidateFile::VALIDATION_OK, validatedFile.createHashFileFromRunningHash());
+    ASSERT_EQ(Os::ValidateFile::VALIDATION_OK, validatedFile.validate());
+
+    // With a block size of zero every write goes to the file
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile(fileName));
+    file.setBlockSize(0);
+    ASSERT_EQ(Os::File::OP_OK, file.open(fileName, Os::File::OPEN_WRITE));
+    size = 3;
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size, Os::File::WaitType::NO_WAIT));
+    ASSERT_EQ(3U, size);
+    ASSERT_EQ(0U, file.getBufferedSize());
+    ASSERT_EQ(Os::File::OP_OK, file.close());
+    checkContents(fileName, data, 3);
+
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile(fileName));
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile(validatedFile.getHashFileName().toChar()));
+}
+
+void testBufferedFilePackets() {
+    const char fileName[] = "buffered_file_packets.dat";
+    (void)packetRate(fileName, 0, CHECK_PACKET_COUNT);
+    (void)packetRate(fileName, Os::BufferedFile::CAPACITY, CHECK_PACKET_COUNT);
+}
+
+void testBufferedFileThroughput() {
+    const char fileName[] = "buffered_file_throughput.dat";
+    const F64 unbufferedRate = packetRate(fileName, 0, PACKET_COUNT);
+    const F64 bufferedRate = packetRate(fileName, Os::BufferedFile::CAPACITY, PACKET_COUNT);
+    (void)printf("%u length prefixed %u byte packets: unbuffered %.0f packets/s, %u byte blocks %.0f packets/s\n",
+                 static_cast<unsigned int>(PACKET_COUNT), static_cast<unsigned int>(PACKET_SIZE), unbufferedRate,
+                 static_cast<unsigned int>(Os::BufferedFile::CAPACITY), bufferedRate);
+}
+
+extern "C" {
+void bufferedFileTest();
+void bufferedFilePacketsTest();
+void bufferedFileThroughputTest();
+}
+
+void bufferedFileTest() {
+    testBufferedFile();
+}
+
+void bufferedFilePacketsTest() {
+    testBufferedFilePackets();
+}
+
+void bufferedFileThroughputTest() {
+    testBufferedFileThroughput();
+}
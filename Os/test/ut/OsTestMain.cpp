@@ -3,6 +3,10 @@
 extern "C" {
 void intervalTimerTest();
 void validateFileTest(const char* filename);
+void validatedFileRunningHashTest();
+void bufferedFileTest();
+void bufferedFilePacketsTest();
+void bufferedFileThroughputTest();
 void mutexBasicLockableTest();
 }
 const char* filename;
@@ -18,6 +22,23 @@ TEST(Nominal, ValidateFileTest) {
     validateFileTest(filename);
 }
 
+TEST(Nominal, ValidatedFileRunningHashTest) {
+    validatedFileRunningHashTest();
+}
+
+TEST(Nominal, BufferedFileTest) {
+    bufferedFileTest();
+}
+
+TEST(Nominal, BufferedFilePacketsTest) {
+    bufferedFilePacketsTest();
+}
+
+// Throughput benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(Nominal, DISABLED_BufferedFileThroughputTest) {
+    bufferedFileThroughputTest();
+}
+
 TEST(Nominal, MutexBasicLockableTest) {
     mutexBasicLockableTest();
 }
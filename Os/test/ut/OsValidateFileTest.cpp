@@ -2,6 +2,7 @@
 #include <Os/File.hpp>
 #include <Os/FileSystem.hpp>
 #include <Os/ValidateFile.hpp>
+#include <Os/ValidatedFile.hpp>
 #include <Utils/Hash/HashBuffer.hpp>
 #include "gtest/gtest.h"
 
@@ -94,10 +95,56 @@ void testValidateFile(const char* fileName) {
     }
 }
 
+void testValidatedFileRunningHash() {
+    const char fileName[] = "running_hash.dat";
+    Os::ValidatedFile validatedFile(fileName);
+    U8 data[1000];
+    for (FwSizeType i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<U8>(i * 7);
+    }
+
+    // Write the file in chunks through the running hash
+    Os::File file;
+    ASSERT_EQ(Os::File::OP_OK, file.open(fileName, Os::File::OPEN_WRITE));
+    validatedFile.startRunningHash();
+    for (FwSizeType offset = 0; offset < sizeof(data); offset += 100) {
+        FwSizeType size = 100;
+        ASSERT_EQ(Os::File::OP_OK, validatedFile.writeAndHash(file, &data[offset], size, Os::File::WaitType::WAIT));
+        ASSERT_EQ(100U, size);
+    }
+    file.close();
+
+    // The hash file written from the running hash validates the file, and matches hashing the file contents
+    ASSERT_EQ(Os::ValidateFile::VALIDATION_OK, validatedFile.createHashFileFromRunningHash());
+    const Utils::HashBuffer runningHash = validatedFile.getHashBuffer();
+    ASSERT_EQ(Os::ValidateFile::VALIDATION_OK, validatedFile.validate());
+    ASSERT_EQ(runningHash, validatedFile.getHashBuffer());
+    Utils::HashBuffer computedHash;
+    Utils::Hash::hash(data, sizeof(data), computedHash);
+    ASSERT_EQ(computedHash, runningHash);
+
+    // After a failed write the running hash is not trusted, and the hash file is created by reading the file
+    ASSERT_EQ(Os::File::OP_OK, file.open(fileName, Os::File::OPEN_READ));
+    validatedFile.startRunningHash();
+    FwSizeType size = sizeof(data);
+    ASSERT_NE(Os::File::OP_OK, validatedFile.writeAndHash(file, data, size, Os::File::WaitType::WAIT));
+    file.close();
+    ASSERT_EQ(Os::ValidateFile::VALIDATION_OK, validatedFile.createHashFileFromRunningHash());
+    ASSERT_EQ(computedHash, validatedFile.getHashBuffer());
+
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile(fileName));
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile(validatedFile.getHashFileName().toChar()));
+}
+
 extern "C" {
 void validateFileTest(const char* filename);
+void validatedFileRunningHashTest();
 }
 
 void validateFileTest(const char* filename) {
     testValidateFile(filename);
 }
+
+void validatedFileRunningHashTest() {
+    testValidatedFileRunningHash();
+}
@@ -238,6 +238,27 @@ TEST_F(FunctionalIO, WriteReadSeek) {
     seek_rule.apply(*tester);
 }
 
+// Ensure positional writes and reads produce valid data without moving the file pointer
+TEST_F(FunctionalIO, WriteAtReadAt) {
+    Os::Test::FileTest::Tester::OpenFileCreate open_rule(false);
+    Os::Test::FileTest::Tester::Write write_rule;
+    Os::Test::FileTest::Tester::WriteAt write_at_rule;
+    Os::Test::FileTest::Tester::CloseFile close_rule;
+    Os::Test::FileTest::Tester::OpenForRead open_read;
+    Os::Test::FileTest::Tester::Read read_rule;
+    Os::Test::FileTest::Tester::ReadAt read_at_rule;
+
+    open_rule.apply(*tester);
+    write_rule.apply(*tester);
+    write_at_rule.apply(*tester);
+    write_rule.apply(*tester);
+    close_rule.apply(*tester);
+    open_read.apply(*tester);
+    read_at_rule.apply(*tester);
+    read_rule.apply(*tester);
+    read_at_rule.apply(*tester);
+}
+
 // Ensure a write followed by a full crc produces valid results
 TEST_F(FunctionalIO, WriteFullCrc) {
     Os::Test::FileTest::Tester::OpenFileCreate open_rule(false);
@@ -351,6 +372,8 @@ TEST_F(FunctionalIO, RandomizedTesting) {
     Os::Test::FileTest::Tester::CloseFile close_file_rule;
     Os::Test::FileTest::Tester::Read read_rule;
     Os::Test::FileTest::Tester::Write write_rule;
+    Os::Test::FileTest::Tester::ReadAt read_at_rule;
+    Os::Test::FileTest::Tester::WriteAt write_at_rule;
     Os::Test::FileTest::Tester::Seek seek_rule;
     Os::Test::FileTest::Tester::Preallocate preallocate_rule;
     Os::Test::FileTest::Tester::Flush flush_rule;
@@ -379,6 +402,8 @@ TEST_F(FunctionalIO, RandomizedTesting) {
                                                         &copy_construction,
                                                         &read_rule,
                                                         &write_rule,
+                                                        &read_at_rule,
+                                                        &write_at_rule,
                                                         &seek_rule,
                                                         &preallocate_rule,
                                                         &flush_rule,
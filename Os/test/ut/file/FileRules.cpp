@@ -57,6 +57,26 @@ void Os::Test::FileTest::Tester::shadow_write(const std::vector<U8>& write_data)
     ASSERT_EQ(size, original_size);
 }
 
+std::vector<U8> Os::Test::FileTest::Tester::shadow_read_at(FwSizeType size, FwSizeType offset) {
+    std::vector<U8> output;
+    output.resize(size);
+    Os::File::Status status = m_shadow.readAt(output.data(), size, offset, Os::File::WaitType::WAIT);
+    output.resize(size);
+    EXPECT_EQ(status, Os::File::Status::OP_OK);
+    return output;
+}
+
+void Os::Test::FileTest::Tester::shadow_write_at(const std::vector<U8>& write_data, FwSizeType offset) {
+    FwSizeType size = static_cast<FwSizeType>(write_data.size());
+    FwSizeType original_size = size;
+    Os::File::Status status = Os::File::OP_OK;
+    if (write_data.data() != nullptr) {
+        status = m_shadow.writeAt(write_data.data(), size, offset, Os::File::WaitType::WAIT);
+    }
+    ASSERT_EQ(status, Os::File::Status::OP_OK);
+    ASSERT_EQ(size, original_size);
+}
+
 void Os::Test::FileTest::Tester::shadow_seek(const FwSignedSizeType offset, const bool absolute) {
     Os::File::Status status =
         m_shadow.seek(offset, absolute ? Os::File::SeekType::ABSOLUTE : Os::File::SeekType::RELATIVE);
@@ -470,6 +490,87 @@ void Os::Test::FileTest::Tester::Write::action(Os::Test::FileTest::Tester& state
     state.assert_file_consistent();
 }
 
+// ------------------------------------------------------------------------------------------------------
+// Rule:  ReadAt
+//
+// ------------------------------------------------------------------------------------------------------
+
+Os::Test::FileTest::Tester::ReadAt::ReadAt() : STest::Rule<Os::Test::FileTest::Tester>("ReadAt") {}
+
+bool Os::Test::FileTest::Tester::ReadAt::precondition(const Os::Test::FileTest::Tester& state  //!< The test state
+) {
+    return Os::File::Mode::OPEN_READ == state.m_mode;
+}
+
+void Os::Test::FileTest::Tester::ReadAt::action(Os::Test::FileTest::Tester& state  //!< The test state
+) {
+    printf("--> Rule: %s \n", this->getName());
+    U8 buffer[FILE_DATA_MAXIMUM];
+    state.assert_file_consistent();
+    FileState original_file_state = state.current_file_state();
+    // Offsets may reach past the end of the file, where nothing is read
+    FwSizeType offset = static_cast<FwSizeType>(STest::Pick::lowerUpper(0, FILE_DATA_MAXIMUM));
+    FwSizeType size_desired = static_cast<FwSizeType>(STest::Pick::lowerUpper(0, FILE_DATA_MAXIMUM));
+    FwSizeType size_read = size_desired;
+    bool wait = static_cast<bool>(STest::Pick::lowerUpper(0, 1));
+    Os::File::Status status = state.m_file.readAt(buffer, size_read, offset,
+                                                  wait ? Os::File::WaitType::WAIT : Os::File::WaitType::NO_WAIT);
+    ASSERT_EQ(Os::File::Status::OP_OK, status);
+    std::vector<U8> read_data = state.shadow_read_at(size_desired, offset);
+    state.assert_file_read(read_data, buffer, size_read);
+    // Neither the file size nor the file pointer change during a positional read
+    FileState final_file_state = state.current_file_state();
+    ASSERT_EQ(final_file_state.size, original_file_state.size);
+    ASSERT_EQ(final_file_state.position, original_file_state.position);
+    state.assert_file_consistent();
+}
+
+// ------------------------------------------------------------------------------------------------------
+// Rule:  WriteAt
+//
+// ------------------------------------------------------------------------------------------------------
+
+Os::Test::FileTest::Tester::WriteAt::WriteAt() : STest::Rule<Os::Test::FileTest::Tester>("WriteAt") {}
+
+bool Os::Test::FileTest::Tester::WriteAt::precondition(const Os::Test::FileTest::Tester& state  //!< The test state
+) {
+    return Os::File::Mode::OPEN_CREATE <= state.m_mode;
+}
+
+void Os::Test::FileTest::Tester::WriteAt::action(Os::Test::FileTest::Tester& state  //!< The test state
+) {
+    printf("--> Rule: %s \n", this->getName());
+    U8 buffer[FILE_DATA_MAXIMUM];
+    state.assert_file_consistent();
+    FileState original_file_state = state.current_file_state();
+    // Offsets may reach past the end of the file, leaving a gap of zeros
+    FwSizeType offset = static_cast<FwSizeType>(STest::Pick::lowerUpper(0, FILE_DATA_MAXIMUM / 2));
+    FwSizeType size_desired = static_cast<FwSizeType>(STest::Pick::lowerUpper(0, FILE_DATA_MAXIMUM - offset));
+    FwSizeType size_written = size_desired;
+    bool wait = static_cast<bool>(STest::Pick::lowerUpper(0, 1));
+    for (FwSizeType i = 0; i < size_desired; i++) {
+        buffer[i] = static_cast<U8>(STest::Pick::lowerUpper(0, std::numeric_limits<U8>::max()));
+    }
+    std::vector<U8> write_data(buffer, buffer + size_desired);
+    Os::File::Status status = state.m_file.writeAt(buffer, size_written, offset,
+                                                   wait ? Os::File::WaitType::WAIT : Os::File::WaitType::NO_WAIT);
+    FileState final_file_state = state.current_file_state();
+    // Appending files refuse positional writes
+    if (Os::File::Mode::OPEN_APPEND == state.m_mode) {
+        ASSERT_EQ(Os::File::Status::INVALID_MODE, status);
+        ASSERT_EQ(0, size_written);
+        ASSERT_EQ(final_file_state.size, original_file_state.size);
+    } else {
+        ASSERT_EQ(Os::File::Status::OP_OK, status);
+        ASSERT_EQ(size_written, size_desired);
+        state.shadow_write_at(write_data, offset);
+        state.assert_file_write(write_data, size_written);
+    }
+    // The file pointer does not change during a positional write
+    ASSERT_EQ(final_file_state.position, original_file_state.position);
+    state.assert_file_consistent();
+}
+
 // ------------------------------------------------------------------------------------------------------
 // Rule:  Seek
 //
@@ -746,6 +847,9 @@ void Os::Test::FileTest::Tester::ReadInvalidModes::action(Os::Test::FileTest::Te
     Os::File::Status status =
         state.m_file.read(buffer, size, wait ? Os::File::WaitType::WAIT : Os::File::WaitType::NO_WAIT);
     state.assert_valid_mode_status(status);
+    size = sizeof buffer;
+    status = state.m_file.readAt(buffer, size, 0, wait ? Os::File::WaitType::WAIT : Os::File::WaitType::NO_WAIT);
+    state.assert_valid_mode_status(status);
 
     // Ensure no change in size or pointer
     FileState final_file_state = state.current_file_state();
@@ -781,6 +885,9 @@ void Os::Test::FileTest::Tester::WriteInvalidModes::action(Os::Test::FileTest::T
     Os::File::Status status =
         state.m_file.write(buffer, size, wait ? Os::File::WaitType::WAIT : Os::File::WaitType::NO_WAIT);
     state.assert_valid_mode_status(status);
+    size = sizeof buffer;
+    status = state.m_file.writeAt(buffer, size, 0, wait ? Os::File::WaitType::WAIT : Os::File::WaitType::NO_WAIT);
+    state.assert_valid_mode_status(status);
     // Ensure no change in size or pointer
     FileState final_file_state = state.current_file_state();
     ASSERT_EQ(final_file_state.size, original_file_state.size);
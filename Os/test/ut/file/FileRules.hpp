@@ -173,6 +173,56 @@ struct Write : public STest::Rule<Os::Test::FileTest::Tester> {
     );
 };
 
+// ------------------------------------------------------------------------------------------------------
+// Rule:  ReadAt
+//
+// ------------------------------------------------------------------------------------------------------
+struct ReadAt : public STest::Rule<Os::Test::FileTest::Tester> {
+    // ----------------------------------------------------------------------
+    // Construction
+    // ----------------------------------------------------------------------
+
+    //! Constructor
+    ReadAt();
+
+    // ----------------------------------------------------------------------
+    // Public member functions
+    // ----------------------------------------------------------------------
+
+    //! Precondition
+    bool precondition(const Os::Test::FileTest::Tester& state  //!< The test state
+    );
+
+    //! Action
+    void action(Os::Test::FileTest::Tester& state  //!< The test state
+    );
+};
+
+// ------------------------------------------------------------------------------------------------------
+// Rule:  WriteAt
+//
+// ------------------------------------------------------------------------------------------------------
+struct WriteAt : public STest::Rule<Os::Test::FileTest::Tester> {
+    // ----------------------------------------------------------------------
+    // Construction
+    // ----------------------------------------------------------------------
+
+    //! Constructor
+    WriteAt();
+
+    // ----------------------------------------------------------------------
+    // Public member functions
+    // ----------------------------------------------------------------------
+
+    //! Precondition
+    bool precondition(const Os::Test::FileTest::Tester& state  //!< The test state
+    );
+
+    //! Action
+    void action(Os::Test::FileTest::Tester& state  //!< The test state
+    );
+};
+
 // ------------------------------------------------------------------------------------------------------
 // Rule:  Seek
 //
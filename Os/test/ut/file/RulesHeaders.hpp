@@ -71,6 +71,15 @@ struct Tester {
     //!
     void shadow_write(const std::vector<U8>& data);
 
+    //! Perform the "readAt" action on the shadow state returning the read data.
+    //! \return data read
+    //!
+    std::vector<U8> shadow_read_at(FwSizeType size, FwSizeType offset);
+
+    //! Perform the "writeAt" action on the shadow state given the data.
+    //!
+    void shadow_write_at(const std::vector<U8>& data, FwSizeType offset);
+
     //! Perform the "seek" action on the shadow state given.
     //!
     void shadow_seek(const FwSignedSizeType offset, const bool absolute);
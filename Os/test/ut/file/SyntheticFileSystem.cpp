@@ -194,6 +194,36 @@ Os::File::Status SyntheticFile::write(const U8* buffer, FwSizeType& size, WaitTy
     return Os::File::Status::OP_OK;
 }
 
+Os::File::Status SyntheticFile::readAt(U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) {
+    FW_ASSERT(this->m_data != nullptr);
+    // Read from the offset and restore the pointer afterwards
+    const FwSizeType original_pointer = this->m_data->m_pointer;
+    if (Os::File::Mode::OPEN_NO_MODE != this->m_data->m_mode) {
+        this->m_data->m_pointer = offset;
+    }
+    const Os::File::Status status = this->read(buffer, size, wait);
+    this->m_data->m_pointer = original_pointer;
+    return status;
+}
+
+Os::File::Status SyntheticFile::writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset, WaitType wait) {
+    FW_ASSERT(this->m_data != nullptr);
+    FW_ASSERT(this->m_data->m_mode < Os::File::Mode::MAX_OPEN_MODE);
+    // Appends always write at the end of the file, so they cannot be written at an offset
+    if (Os::File::Mode::OPEN_APPEND == this->m_data->m_mode) {
+        size = 0;
+        return Os::File::Status::INVALID_MODE;
+    }
+    // Write to the offset and restore the pointer afterwards
+    const FwSizeType original_pointer = this->m_data->m_pointer;
+    if (Os::File::Mode::OPEN_NO_MODE != this->m_data->m_mode) {
+        this->m_data->m_pointer = offset;
+    }
+    const Os::File::Status status = this->write(buffer, size, wait);
+    this->m_data->m_pointer = original_pointer;
+    return status;
+}
+
 Os::File::Status SyntheticFile::seek(const FwSignedSizeType offset, const SeekType absolute) {
     FW_ASSERT(this->m_data != nullptr);
     Os::File::Status status = Os::File::Status::OP_OK;
@@ -86,6 +86,32 @@ class SyntheticFile : public FileInterface {
     //!
     Os::File::Status write(const U8* buffer, FwSizeType& size, File::WaitType wait) override;
 
+    //! \brief read data from the file at an offset
+    //!
+    //! Read from the synthetic file starting at offset and fill the buffer up-to size, leaving the pointer
+    //! unchanged. Fill size with the data that was read.
+    //!
+    //! \param buffer: buffer to fill
+    //! \param size: size of data to read
+    //! \param offset: offset to read from
+    //! \param bool: wait, unused
+    //! \return status of the read
+    //!
+    Os::File::Status readAt(U8* buffer, FwSizeType& size, FwSizeType offset, File::WaitType wait) override;
+
+    //! \brief write data to the file at an offset
+    //!
+    //! Write to the synthetic file starting at offset from the buffer of given size, leaving the pointer unchanged.
+    //! Fill size with the data that was written.
+    //!
+    //! \param buffer: buffer to write
+    //! \param size: size of data to write
+    //! \param offset: offset to write to
+    //! \param bool: wait, unused
+    //! \return status of the write
+    //!
+    Os::File::Status writeAt(const U8* buffer, FwSizeType& size, FwSizeType offset, File::WaitType wait) override;
+
     //! \brief seek pointer within file
     //!
     //! Seek the pointer within the file.
@@ -25,7 +25,7 @@ PickedMessage pick_message(FwSizeType max_size) {
 
     message.size = STest::Random::lowerUpper(1, max_size);
     // Force priority to be in a smaller range to produce more same-priority messages
-    message.priority = STest::Random::lowerUpper(0, std::numeric_limits<I8>::max());
+    message.priority = STest::Random::lowerUpper(0, QUEUE_PRIORITY_UPPER_BOUND);
 
     message.sent.reset(new U8[message.size]);
     for (FwSizeType i = 0; i < message.size; i++) {
@@ -15,8 +15,10 @@
 
 #include "Fw/Types/Assert.hpp"
 #include "Fw/Types/String.hpp"
+#include "Os/BufferedFile.hpp"
 #include "Os/File.hpp"
 #include "Os/Mutex.hpp"
+#include "Os/ValidatedFile.hpp"
 #include "Svc/BufferLogger/BufferLoggerComponentAc.hpp"
 #include "Utils/Hash/Hash.hpp"
 
@@ -112,11 +114,16 @@ class BufferLogger final : public BufferLoggerComponentBase {
                         const FwSizeType length  //!< The number of bytes to write
         );
 
+        //! Write the buffered size field and data out to the file
+        //! \return Success or failure
+        bool writeBlock();
+
         //! Write a hash file
         void writeHashFile();
 
-        //! Close the file
-        void close();
+        //! Close the file, writing out any buffered data
+        //! \return The status of writing the buffered data
+        Os::File::Status close();
 
       private:
         //! The enclosing BufferLogger instance
@@ -146,8 +153,11 @@ class BufferLogger final : public BufferLoggerComponentBase {
         // The current mode
         Mode::t m_mode;
 
-        //! The underlying Os::File representation
-        Os::File m_osFile;
+        //! The underlying file, which gathers each size field and buffer into one write
+        Os::BufferedFile m_osFile;
+
+        //! The running hash of the current file, written to the hash file on close
+        Os::ValidatedFile m_validatedFile;
 
         //! The number of bytes written to the current file
         FwSizeType m_bytesWritten;
@@ -29,10 +29,11 @@ BufferLogger::File ::File(BufferLogger& bufferLogger)
       m_maxSize(0),
       m_sizeOfSize(0),
       m_mode(Mode::CLOSED),
+      m_validatedFile(),
       m_bytesWritten(0) {}
 
 BufferLogger::File ::~File() {
-    this->close();
+    (void)this->close();
 }
 
 // ----------------------------------------------------------------------
@@ -84,8 +85,13 @@ void BufferLogger::File ::logBuffer(const U8* const data, const FwSizeType size)
 
 void BufferLogger::File ::closeAndEmitEvent() {
     if (this->m_mode == File::Mode::OPEN) {
-        this->close();
+        const FwSizeType bufferedSize = this->m_osFile.getBufferedSize();
+        const Os::File::Status status = this->close();
         Fw::LogStringArg logStringArg(this->m_name.toChar());
+        if (status != Os::File::OP_OK) {
+            this->m_bufferLogger.log_WARNING_HI_BL_LogFileWriteError(status, 0, static_cast<U32>(bufferedSize),
+                                                                     logStringArg);
+        }
         this->m_bufferLogger.log_DIAGNOSTIC_BL_LogFileClosed(logStringArg);
     }
 }
@@ -116,6 +122,9 @@ void BufferLogger::File ::open() {
         this->m_fileCounter++;
         // Reset bytes written
         this->m_bytesWritten = 0;
+        // Hash the file as it is written
+        this->m_validatedFile.setFileName(this->m_name.toChar());
+        this->m_validatedFile.startRunningHash();
         // Set mode
         this->m_mode = File::Mode::OPEN;
     } else {
@@ -129,7 +138,9 @@ bool BufferLogger::File ::writeBuffer(const U8* const data, const FwSizeType siz
     if (status) {
         status = this->writeBytes(data, size);
     }
-    return status;
+    // Write the record out now, so that a reset does not lose it
+    const bool blockStatus = this->writeBlock();
+    return status && blockStatus;
 }
 
 bool BufferLogger::File ::writeSize(const FwSizeType size) {
@@ -146,7 +157,8 @@ bool BufferLogger::File ::writeSize(const FwSizeType size) {
 
 bool BufferLogger::File ::writeBytes(const void* const data, const FwSizeType length) {
     FwSizeType size = length;
-    const Os::File::Status fileStatus = this->m_osFile.write(reinterpret_cast<const U8*>(data), size);
+    const Os::File::Status fileStatus = this->m_validatedFile.writeAndHash(
+        this->m_osFile, reinterpret_cast<const U8*>(data), size, Os::File::WaitType::WAIT);
     bool status;
     if (fileStatus == Os::File::OP_OK && static_cast<FwSizeType>(size) == length) {
         this->m_bytesWritten += length;
@@ -161,44 +173,58 @@ bool BufferLogger::File ::writeBytes(const void* const data, const FwSizeType le
     return status;
 }
 
+bool BufferLogger::File ::writeBlock() {
+    const FwSizeType bufferedSize = this->m_osFile.getBufferedSize();
+    const Os::File::Status fileStatus = this->m_osFile.writeBlock();
+    bool status = true;
+    if (fileStatus != Os::File::OP_OK) {
+        // The buffered bytes are lost, so the running hash no longer matches the file
+        this->m_validatedFile.invalidateRunningHash();
+        Fw::LogStringArg string(this->m_name.toChar());
+        this->m_bufferLogger.log_WARNING_HI_BL_LogFileWriteError(fileStatus, 0, static_cast<U32>(bufferedSize),
+                                                                 string);
+        status = false;
+    }
+    return status;
+}
+
 void BufferLogger::File ::writeHashFile() {
-    Os::ValidatedFile validatedFile(this->m_name.toChar());
-    const Os::ValidateFile::Status status = validatedFile.createHashFile();
+    // Write out the running hash of the log file
+    const Os::ValidateFile::Status status = this->m_validatedFile.createHashFileFromRunningHash();
     if (status != Os::ValidateFile::VALIDATION_OK) {
-        const Fw::ConstStringBase& hashFileName = validatedFile.getHashFileName();
+        const Fw::ConstStringBase& hashFileName = this->m_validatedFile.getHashFileName();
         Fw::LogStringArg logStringArg(hashFileName.toChar());
         this->m_bufferLogger.log_WARNING_HI_BL_LogFileValidationError(logStringArg, status);
     }
 }
 
 bool BufferLogger::File ::flush() {
-    return true;
-    // NOTE(if your fprime uses buffered file I/O, re-enable this)
-    /*bool status = true;
-    if(this->mode == File::Mode::OPEN)
-    {
-      const Os::File::Status fileStatus = this->osFile.flush();
-      if(fileStatus == Os::File::OP_OK)
-      {
-        status = true;
-      }
-      else
-      {
-        status = false;
-      }
+    bool status = true;
+    if (this->m_mode == File::Mode::OPEN) {
+        const Os::File::Status fileStatus = this->m_osFile.flush();
+        if (fileStatus != Os::File::OP_OK) {
+            // Buffered data may not have reached the file
+            this->m_validatedFile.invalidateRunningHash();
+            status = false;
+        }
     }
-    return status;*/
+    return status;
 }
 
-void BufferLogger::File ::close() {
+Os::File::Status BufferLogger::File ::close() {
+    Os::File::Status status = Os::File::OP_OK;
     if (this->m_mode == File::Mode::OPEN) {
-        // Close file
-        this->m_osFile.close();
+        // Close file, writing out the buffered data
+        status = this->m_osFile.close();
+        if (status != Os::File::OP_OK) {
+            this->m_validatedFile.invalidateRunningHash();
+        }
         // Write out the hash file to disk
         this->writeHashFile();
         // Update mode
         this->m_mode = File::Mode::CLOSED;
     }
+    return status;
 }
 
 }  // namespace Svc
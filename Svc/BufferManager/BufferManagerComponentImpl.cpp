@@ -19,6 +19,9 @@
 
 namespace Svc {
 
+static_assert(BUFFERMGR_MAX_NUM_BINS == BufferManagerBinCounts::SIZE,
+              "Per-bin telemetry must have one element for each bin");
+
 // ----------------------------------------------------------------------
 // Construction, initialization, and destruction
 // ----------------------------------------------------------------------
@@ -28,6 +31,7 @@ BufferManagerComponentImpl ::BufferManagerComponentImpl(const char* const compNa
       m_setup(false),
       m_cleaned(false),
       m_mgrId(0),
+      m_mode(LOCKED),
       m_buffers(nullptr),
       m_allocator(nullptr),
       m_memId(0),
@@ -35,7 +39,16 @@ BufferManagerComponentImpl ::BufferManagerComponentImpl(const char* const compNa
       m_highWater(0),
       m_currBuffs(0),
       m_noBuffs(0),
-      m_emptyBuffs(0) {}
+      m_emptyBuffs(0) {
+    for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+        this->m_binStates[bin].firstFree = NO_FREE_BUFFER;
+        this->m_binStates[bin].lastFree = NO_FREE_BUFFER;
+        this->m_binStates[bin].stackTop = NO_FREE_BUFFER;
+        this->m_binStates[bin].highWater = 0;
+        this->m_binStates[bin].currBuffs = 0;
+        this->m_binStates[bin].noBuffs = 0;
+    }
+}
 
 BufferManagerComponentImpl ::~BufferManagerComponentImpl() {
     if (m_setup) {
@@ -73,7 +86,7 @@ void BufferManagerComponentImpl ::bufferSendIn_handler(const FwIndexType portNum
     // buffers with their size reduced. the user is allowed to make buffers smaller.
     if (fwBuffer.getData() == nullptr && fwBuffer.getSize() == 0) {
         this->log_WARNING_HI_NullEmptyBuffer();
-        this->m_emptyBuffs++;
+        this->m_emptyBuffs.fetch_add(1, std::memory_order_relaxed);
         return;
     }
     // use the bufferID member field to find the original slot
@@ -85,8 +98,6 @@ void BufferManagerComponentImpl ::bufferSendIn_handler(const FwIndexType portNum
               static_cast<FwAssertArgType>(this->m_numStructs));
     FW_ASSERT(mgrId == this->m_mgrId, static_cast<FwAssertArgType>(mgrId), static_cast<FwAssertArgType>(id),
               static_cast<FwAssertArgType>(this->m_mgrId));
-    FW_ASSERT(true == this->m_buffers[id].allocated, static_cast<FwAssertArgType>(id),
-              static_cast<FwAssertArgType>(this->m_mgrId));
     FW_ASSERT(reinterpret_cast<U8*>(fwBuffer.getData()) >= this->m_buffers[id].memory, static_cast<FwAssertArgType>(id),
               static_cast<FwAssertArgType>(this->m_mgrId));
     FW_ASSERT(reinterpret_cast<U8*>(fwBuffer.getData()) < (this->m_buffers[id].memory + this->m_buffers[id].size),
@@ -94,42 +105,136 @@ void BufferManagerComponentImpl ::bufferSendIn_handler(const FwIndexType portNum
     // user can make smaller for their own purposes, but it shouldn't be bigger
     FW_ASSERT(fwBuffer.getSize() <= this->m_buffers[id].size, static_cast<FwAssertArgType>(id),
               static_cast<FwAssertArgType>(this->m_mgrId));
-    // clear the allocated flag
-    this->m_buffers[id].allocated = false;
-    this->m_currBuffs--;
+    // clear the allocated flag and make the buffer available again. Exchanging the flag lets only one of
+    // two tasks returning the same buffer concurrently through, so it can't be linked into the free list
+    // twice. The counts are decremented first so a concurrent allocation of the same buffer can't overstate them.
+    const bool wasAllocated = this->m_buffers[id].allocated.exchange(false, std::memory_order_relaxed);
+    FW_ASSERT(wasAllocated, static_cast<FwAssertArgType>(id), static_cast<FwAssertArgType>(this->m_mgrId));
+    this->m_binStates[this->m_buffers[id].bin].currBuffs.fetch_sub(1, std::memory_order_relaxed);
+    this->m_currBuffs.fetch_sub(1, std::memory_order_relaxed);
+    this->pushFree(static_cast<U16>(id));
 }
 
 Fw::Buffer BufferManagerComponentImpl ::bufferGetCallee_handler(const FwIndexType portNum, Fw::Buffer::SizeType size) {
     // make sure component has been set up
     FW_ASSERT(this->m_setup);
     FW_ASSERT(m_buffers);
-    // find smallest buffer based on size.
-    for (U16 buff = 0; buff < this->m_numStructs; buff++) {
-        if ((not this->m_buffers[buff].allocated) and (size <= this->m_buffers[buff].size)) {
-            this->m_buffers[buff].allocated = true;
-            this->m_currBuffs++;
-            if (this->m_currBuffs > this->m_highWater) {
-                this->m_highWater = this->m_currBuffs;
+    // find the smallest bin with a free buffer big enough for the size.
+    // bins are ordered by increasing buffer size.
+    U16 failedBin = BUFFERMGR_MAX_NUM_BINS;
+    for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+        if ((this->m_bufferBins.bins[bin].numBuffers == 0) or (size > this->m_bufferBins.bins[bin].bufferSize)) {
+            continue;
+        }
+        const U16 buff = this->popFree(bin);
+        if (buff == NO_FREE_BUFFER) {
+            // remember the first bin the request was sized for
+            if (failedBin == BUFFERMGR_MAX_NUM_BINS) {
+                failedBin = bin;
             }
-            Fw::Buffer copy = this->m_buffers[buff].buff;
-            // change size to match request
-            copy.setSize(size);
-            return copy;
+            continue;
         }
+        FW_ASSERT(buff < this->m_numStructs, static_cast<FwAssertArgType>(buff),
+                  static_cast<FwAssertArgType>(bin));
+        const bool wasAllocated = this->m_buffers[buff].allocated.exchange(true, std::memory_order_relaxed);
+        FW_ASSERT(not wasAllocated, static_cast<FwAssertArgType>(buff));
+        BinState& binState = this->m_binStates[bin];
+        updateHighWater(binState.highWater, binState.currBuffs.fetch_add(1, std::memory_order_relaxed) + 1);
+        updateHighWater(this->m_highWater, this->m_currBuffs.fetch_add(1, std::memory_order_relaxed) + 1);
+        Fw::Buffer copy = this->m_buffers[buff].buff;
+        // change size to match request
+        copy.setSize(size);
+        return copy;
     }
 
     // if no buffers found, return empty buffer
     this->log_WARNING_HI_NoBuffsAvailable(size);
-    this->m_noBuffs++;
+    this->m_noBuffs.fetch_add(1, std::memory_order_relaxed);
+    if (failedBin < BUFFERMGR_MAX_NUM_BINS) {
+        this->m_binStates[failedBin].noBuffs.fetch_add(1, std::memory_order_relaxed);
+    }
     return Fw::Buffer();
 }
 
+U16 BufferManagerComponentImpl ::popFree(U16 bin) {
+    BinState& binState = this->m_binStates[bin];
+    if (this->m_mode == LOCKED) {
+        Os::ScopeLock lock(this->m_freeLock);
+        const U16 id = binState.firstFree;
+        if (id != NO_FREE_BUFFER) {
+            binState.firstFree = this->m_buffers[id].nextFree.load(std::memory_order_relaxed);
+            if (binState.firstFree == NO_FREE_BUFFER) {
+                binState.lastFree = NO_FREE_BUFFER;
+            }
+        }
+        return id;
+    }
+    // LOCK_FREE: replace the stack head with its successor. The tag in the upper half of the
+    // head changes on every update, so a head that was popped and pushed back by another task
+    // between the load and the exchange fails the exchange rather than linking in a stale successor.
+    U32 top = binState.stackTop.load(std::memory_order_acquire);
+    while (true) {
+        const U16 id = static_cast<U16>(top & 0xFFFF);
+        if (id == NO_FREE_BUFFER) {
+            return NO_FREE_BUFFER;
+        }
+        const U32 next = this->m_buffers[id].nextFree.load(std::memory_order_relaxed);
+        const U32 newTop = ((top & 0xFFFF0000U) + 0x10000U) | next;
+        if (binState.stackTop.compare_exchange_weak(top, newTop, std::memory_order_acquire,
+                                                    std::memory_order_acquire)) {
+            return id;
+        }
+    }
+}
+
+void BufferManagerComponentImpl ::pushFree(U16 id) {
+    AllocatedBuffer& buffer = this->m_buffers[id];
+    BinState& binState = this->m_binStates[buffer.bin];
+    if (this->m_mode == LOCKED) {
+        // append to the tail, so buffers are reused least-recently-returned first. This is not
+        // lowest ID first: once buffers come back out of order, so does the allocation order.
+        Os::ScopeLock lock(this->m_freeLock);
+        buffer.nextFree.store(NO_FREE_BUFFER, std::memory_order_relaxed);
+        if (binState.lastFree == NO_FREE_BUFFER) {
+            binState.firstFree = id;
+        } else {
+            this->m_buffers[binState.lastFree].nextFree.store(id, std::memory_order_relaxed);
+        }
+        binState.lastFree = id;
+        return;
+    }
+    // LOCK_FREE: link the buffer above the current head and publish it with release ordering
+    // so the next allocator of the buffer sees the returning task's writes
+    U32 top = binState.stackTop.load(std::memory_order_relaxed);
+    U32 newTop = 0;
+    do {
+        buffer.nextFree.store(static_cast<U16>(top & 0xFFFF), std::memory_order_relaxed);
+        newTop = ((top & 0xFFFF0000U) + 0x10000U) | id;
+    } while (not binState.stackTop.compare_exchange_weak(top, newTop, std::memory_order_release,
+                                                          std::memory_order_relaxed));
+}
+
+void BufferManagerComponentImpl ::updateHighWater(std::atomic<U32>& highWater, U32 value) {
+    U32 current = highWater.load(std::memory_order_relaxed);
+    while ((value > current) and
+           (not highWater.compare_exchange_weak(current, value, std::memory_order_relaxed))) {
+    }
+}
+
 void BufferManagerComponentImpl::setup(U16 mgrId,                    //!< manager ID
                                        FwEnumStoreType memId,        //!< Memory segment identifier
                                        Fw::MemAllocator& allocator,  //!< memory allocator
-                                       const BufferBins& bins        //!< Set of user bins
+                                       const BufferBins& bins,       //!< Set of user bins
+                                       AllocationMode mode           //!< Protection of the bin free lists
 ) {
     this->m_mgrId = mgrId;
+    this->m_mode = mode;
+    // a new pool starts with nothing allocated and fresh statistics, even if setup() was called before
+    this->m_cleaned = false;
+    this->m_highWater = 0;
+    this->m_currBuffs = 0;
+    this->m_noBuffs = 0;
+    this->m_emptyBuffs = 0;
     this->m_memId = memId;
     this->m_allocator = &allocator;
     // clear bins
@@ -173,19 +278,34 @@ void BufferManagerComponentImpl::setup(U16 mgrId,                    //!< manage
     // walk through entries and initialize them
     U16 currStruct = 0;
     for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+        this->m_binStates[bin].firstFree = NO_FREE_BUFFER;
+        this->m_binStates[bin].lastFree = NO_FREE_BUFFER;
+        this->m_binStates[bin].stackTop = NO_FREE_BUFFER;
+        this->m_binStates[bin].highWater = 0;
+        this->m_binStates[bin].currBuffs = 0;
+        this->m_binStates[bin].noBuffs = 0;
         if (this->m_bufferBins.bins[bin].numBuffers) {
+            const U16 binStart = currStruct;
             for (U16 binEntry = 0; binEntry < this->m_bufferBins.bins[bin].numBuffers; binEntry++) {
                 // placement new for Fw::Buffer instance. We don't need the new() return value,
                 // because we know where the Fw::Buffer instance is
                 U32 context = (static_cast<U32>(this->m_mgrId) << 16) | static_cast<U32>(currStruct);
                 (void)new (&this->m_buffers[currStruct].buff)
                     Fw::Buffer(bufferMem, this->m_bufferBins.bins[bin].bufferSize, context);
-                this->m_buffers[currStruct].allocated = false;
+                (void)new (&this->m_buffers[currStruct].allocated) std::atomic<bool>(false);
                 this->m_buffers[currStruct].memory = bufferMem;
                 this->m_buffers[currStruct].size = this->m_bufferBins.bins[bin].bufferSize;
+                this->m_buffers[currStruct].bin = bin;
+                (void)new (&this->m_buffers[currStruct].nextFree) std::atomic<U16>(NO_FREE_BUFFER);
                 bufferMem += this->m_bufferBins.bins[bin].bufferSize;
                 currStruct++;
             }
+            // buffers start out on the bin free list so a new pool hands them out in table order
+            for (U16 binEntry = 0; binEntry < this->m_bufferBins.bins[bin].numBuffers; binEntry++) {
+                const U16 entry = (mode == LOCKED) ? static_cast<U16>(binStart + binEntry)
+                                                   : static_cast<U16>(currStruct - 1 - binEntry);
+                this->pushFree(entry);
+            }
         }
     }
 
@@ -205,11 +325,20 @@ void BufferManagerComponentImpl::setup(U16 mgrId,                    //!< manage
 
 void BufferManagerComponentImpl ::schedIn_handler(const FwIndexType portNum, U32 context) {
     // write telemetry values
-    this->tlmWrite_HiBuffs(this->m_highWater);
-    this->tlmWrite_CurrBuffs(this->m_currBuffs);
+    this->tlmWrite_HiBuffs(this->m_highWater.load(std::memory_order_relaxed));
+    this->tlmWrite_CurrBuffs(this->m_currBuffs.load(std::memory_order_relaxed));
     this->tlmWrite_TotalBuffs(this->m_numStructs);
-    this->tlmWrite_NoBuffs(this->m_noBuffs);
-    this->tlmWrite_EmptyBuffs(this->m_emptyBuffs);
+    this->tlmWrite_NoBuffs(this->m_noBuffs.load(std::memory_order_relaxed));
+    this->tlmWrite_EmptyBuffs(this->m_emptyBuffs.load(std::memory_order_relaxed));
+
+    BufferManagerBinCounts binHiBuffs;
+    BufferManagerBinCounts binNoBuffs;
+    for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+        binHiBuffs[bin] = this->m_binStates[bin].highWater.load(std::memory_order_relaxed);
+        binNoBuffs[bin] = this->m_binStates[bin].noBuffs.load(std::memory_order_relaxed);
+    }
+    this->tlmWrite_BinHiBuffs(binHiBuffs);
+    this->tlmWrite_BinNoBuffs(binNoBuffs);
 }
 
 }  // end namespace Svc
@@ -14,6 +14,8 @@
 #define BufferManager_HPP
 
 #include <Fw/Types/MemAllocator.hpp>
+#include <Os/Mutex.hpp>
+#include <atomic>
 #include "Svc/BufferManager/BufferManagerComponentAc.hpp"
 #include "config/BufferManagerComponentImplCfg.hpp"
 
@@ -47,6 +49,15 @@ namespace Svc {
 // 4. A returned buffer has an indicated size larger than originally allocated.
 // 5. A returned buffer has a pointer different than the one originally allocated.
 //
+// The bufferGetCallee and bufferSendIn ports are sync ports and may be called concurrently from
+// many tasks. The AllocationMode passed to setup() selects how the bin free lists are protected:
+// 1. LOCKED (default) - each bin keeps a FIFO free list protected by a component mutex. Free buffers
+//    are reused least-recently-returned first, not lowest ID first.
+// 2. LOCK_FREE - each bin keeps a lock-free (Treiber) stack of free buffers. The stack head
+//    carries a modification tag to guard against ABA races, so allocation and deallocation
+//    never block. Free buffers are reused most-recently-returned first.
+// In both modes the statistics are kept in atomic counters.
+//
 // Note that a pointer to the Fw::MemAllocator used in setup() is stored for later memory cleanup.
 // The instance of the allocator must persist beyond calling the cleanup() function or the
 // destructor of BufferManager if cleanup() is not called. If a project-specific manual memory
@@ -76,13 +87,20 @@ class BufferManagerComponentImpl final : public BufferManagerComponentBase {
         BufferBin bins[BUFFERMGR_MAX_NUM_BINS];  //!< set of bins to define buffers
     };
 
+    //! Protection of the bin free lists
+    enum AllocationMode {
+        LOCKED,    //!< free lists are protected by a mutex
+        LOCK_FREE  //!< free lists are lock-free stacks
+    };
+
     //! set up configuration
 
     void setup(U16 mgrID,                    //!< ID of manager for buffer checking
                FwEnumStoreType memID,        //!< Memory segment identifier
                Fw::MemAllocator& allocator,  //!< memory allocator. MUST be persistent for later deallocation.
                                              //!  MUST persist past destructor if cleanup() not called explicitly.
-               const BufferBins& bins        //!< Set of user bins
+               const BufferBins& bins,       //!< Set of user bins
+               AllocationMode mode = LOCKED  //!< Protection of the bin free lists
     );
 
     void cleanup();  // Free memory prior to end of program if desired. Otherwise,
@@ -107,6 +125,16 @@ class BufferManagerComponentImpl final : public BufferManagerComponentBase {
     Fw::Buffer bufferGetCallee_handler(const FwIndexType portNum, /*!< The port number*/
                                        Fw::Buffer::SizeType size);
 
+    //! Take a free buffer from a bin
+    //! \return the buffer index, or NO_FREE_BUFFER if the bin is empty
+    U16 popFree(U16 bin);
+
+    //! Return a buffer to its bin free list
+    void pushFree(U16 id);
+
+    //! Raise a high watermark to at least the given value
+    static void updateHighWater(std::atomic<U32>& highWater, U32 value);
+
     //! Handler implementation for schedIn
     //!
     void schedIn_handler(const FwIndexType portNum, /*!< The port number*/
@@ -120,22 +148,46 @@ class BufferManagerComponentImpl final : public BufferManagerComponentBase {
     BufferBins m_bufferBins;  //!< copy of bins supplied by user
 
     struct AllocatedBuffer {
-        Fw::Buffer buff;            //!< Buffer class to give to user
-        U8* memory;                 //!< pointer to memory buffer
-        Fw::Buffer::SizeType size;  //!< size of the buffer
-        bool allocated;             //!< this buffer has been allocated
+        Fw::Buffer buff;              //!< Buffer class to give to user
+        U8* memory;                   //!< pointer to memory buffer
+        Fw::Buffer::SizeType size;    //!< size of the buffer
+        std::atomic<bool> allocated;  //!< this buffer has been allocated
+        U16 bin;                      //!< bin the buffer belongs to
+        std::atomic<U16> nextFree;    //!< next buffer in the bin free list, if not allocated
+    };
+
+    //! Marks the end of a bin free list
+    static const U16 NO_FREE_BUFFER = 0xFFFF;
+
+    //! Per-bin allocation state. Each bin keeps its unallocated buffers in an intrusive
+    //! list linked through AllocatedBuffer::nextFree, so allocation and deallocation
+    //! do not search the buffer table. In LOCKED mode the list is a FIFO described by
+    //! firstFree and lastFree. In LOCK_FREE mode the list is a stack whose head is stackTop,
+    //! holding the top buffer index in the lower 16 bits and a tag that changes on every
+    //! update in the upper 16 bits.
+    struct BinState {
+        U16 firstFree;               //!< first buffer in the free list, or NO_FREE_BUFFER if empty
+        U16 lastFree;                //!< last buffer in the free list
+        std::atomic<U32> stackTop;   //!< tagged head of the lock-free stack
+        std::atomic<U32> highWater;  //!< high watermark for allocations from the bin
+        std::atomic<U32> currBuffs;  //!< number of currently allocated buffers from the bin
+        std::atomic<U32> noBuffs;    //!< number of requests sized for the bin that couldn't return a buffer
     };
 
+    BinState m_binStates[BUFFERMGR_MAX_NUM_BINS];  //!< allocation state of each bin
+    AllocationMode m_mode;                          //!< protection of the bin free lists
+    Os::Mutex m_freeLock;                           //!< protects the free lists in LOCKED mode
+
     AllocatedBuffer* m_buffers;     //!< pointer to allocated buffer space
     Fw::MemAllocator* m_allocator;  //!< allocator for memory
     FwEnumStoreType m_memId;        //!< identifier for allocator
     U16 m_numStructs;               //!< number of allocated structs
 
     // stats
-    U32 m_highWater;   //!< high watermark for allocations
-    U32 m_currBuffs;   //!< number of currently allocated buffers
-    U32 m_noBuffs;     //!< number of failures to allocate a buffer
-    U32 m_emptyBuffs;  //!< number of empty buffers returned
+    std::atomic<U32> m_highWater;   //!< high watermark for allocations
+    std::atomic<U32> m_currBuffs;   //!< number of currently allocated buffers
+    std::atomic<U32> m_noBuffs;     //!< number of failures to allocate a buffer
+    std::atomic<U32> m_emptyBuffs;  //!< number of empty buffers returned
 };
 
 }  // end namespace Svc
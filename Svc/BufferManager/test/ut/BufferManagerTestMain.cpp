@@ -19,6 +19,38 @@ TEST(Nominal, MultSize) {
     tester.multBuffSize();
 }
 
+TEST(Nominal, Resetup) {
+    Svc::BufferManagerTester tester;
+    tester.resetup();
+}
+
+TEST(Nominal, RandomGetReturn) {
+    Svc::BufferManagerTester tester;
+    tester.randomGetReturn();
+}
+
+TEST(Nominal, ConcurrentLocked) {
+    Svc::BufferManagerTester tester;
+    tester.concurrentGetReturn(Svc::BufferManagerComponentImpl::LOCKED, 10000);
+}
+
+TEST(Nominal, ConcurrentLockFree) {
+    Svc::BufferManagerTester tester;
+    tester.concurrentGetReturn(Svc::BufferManagerComponentImpl::LOCK_FREE, 10000);
+}
+
+// Throughput benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(Nominal, DISABLED_ConcurrentLockedThroughput) {
+    Svc::BufferManagerTester tester;
+    tester.concurrentGetReturn(Svc::BufferManagerComponentImpl::LOCKED, 1000000, true);
+}
+
+// Throughput benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(Nominal, DISABLED_ConcurrentLockFreeThroughput) {
+    Svc::BufferManagerTester tester;
+    tester.concurrentGetReturn(Svc::BufferManagerComponentImpl::LOCK_FREE, 1000000, true);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -13,6 +13,10 @@
 #include "BufferManagerTester.hpp"
 #include <Fw/Test/UnitTest.hpp>
 #include <Fw/Types/MallocAllocator.hpp>
+#include <Fw/Types/String.hpp>
+#include <Os/Task.hpp>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 
 #define INSTANCE 0
@@ -30,6 +34,14 @@ static const U16 BIN2_NUM_BUFFERS = 3;
 static const FwEnumStoreType MEM_ID = 49;
 static const U16 MGR_ID = 32;
 
+// Concurrent test configuration. The pool holds at least as many buffers of each size as the
+// tasks can hold at once, so no request fails and no event is emitted from the tasks.
+static const U32 CONCURRENT_TASKS = 4;
+static const U32 CONCURRENT_HELD = 8;
+static const Fw::Buffer::SizeType CONCURRENT_SMALL_SIZE = 16;
+static const Fw::Buffer::SizeType CONCURRENT_LARGE_SIZE = 64;
+static const U16 CONCURRENT_NUM_BUFFERS = CONCURRENT_TASKS * CONCURRENT_HELD;
+
 // Define our own instrumented allocator for testing
 class TestAllocator : public Fw::MemAllocator {
   public:
@@ -187,7 +199,7 @@ void BufferManagerTester::oneBufferSize() {
 
     // check telemetry
     this->invoke_to_schedIn(0, 0);
-    ASSERT_TLM_SIZE(5);
+    ASSERT_TLM_SIZE(7);
     ASSERT_TLM_TotalBuffs_SIZE(1);
     ASSERT_TLM_TotalBuffs(0, BIN1_NUM_BUFFERS);
     ASSERT_TLM_CurrBuffs_SIZE(1);
@@ -198,6 +210,13 @@ void BufferManagerTester::oneBufferSize() {
     ASSERT_TLM_NoBuffs(0, 1);
     ASSERT_TLM_EmptyBuffs_SIZE(1);
     ASSERT_TLM_EmptyBuffs(0, 0);
+    BufferManagerBinCounts binCounts;
+    binCounts[0] = BIN1_NUM_BUFFERS;
+    ASSERT_TLM_BinHiBuffs_SIZE(1);
+    ASSERT_TLM_BinHiBuffs(0, binCounts);
+    binCounts[0] = 1;
+    ASSERT_TLM_BinNoBuffs_SIZE(1);
+    ASSERT_TLM_BinNoBuffs(0, binCounts);
 
     // clear histories
     this->clearHistory();
@@ -288,7 +307,7 @@ void BufferManagerTester::multBuffSize() {
 
     // check telemetry
     this->invoke_to_schedIn(0, 0);
-    ASSERT_TLM_SIZE(5);
+    ASSERT_TLM_SIZE(7);
     ASSERT_TLM_TotalBuffs_SIZE(1);
     ASSERT_TLM_TotalBuffs(0, BIN0_NUM_BUFFERS + BIN1_NUM_BUFFERS + BIN2_NUM_BUFFERS);
     ASSERT_TLM_CurrBuffs_SIZE(1);
@@ -299,6 +318,18 @@ void BufferManagerTester::multBuffSize() {
     ASSERT_TLM_NoBuffs(0, 1);
     ASSERT_TLM_EmptyBuffs_SIZE(1);
     ASSERT_TLM_EmptyBuffs(0, 0);
+    // each bin was fully allocated, and the failed request was sized for bin 1
+    BufferManagerBinCounts binHiBuffs;
+    binHiBuffs[0] = BIN0_NUM_BUFFERS;
+    binHiBuffs[1] = BIN1_NUM_BUFFERS;
+    binHiBuffs[2] = BIN2_NUM_BUFFERS;
+    ASSERT_TLM_BinHiBuffs_SIZE(1);
+    ASSERT_TLM_BinHiBuffs(0, binHiBuffs);
+    BufferManagerBinCounts binNoBuffs;
+    binNoBuffs[1] = 1;
+    ASSERT_TLM_BinNoBuffs_SIZE(1);
+    ASSERT_TLM_BinNoBuffs(0, binNoBuffs);
+    ASSERT_EQ(BIN1_NUM_BUFFERS, this->component.m_binStates[1].currBuffs);
 
     // clear histories
     this->clearHistory();
@@ -357,13 +388,17 @@ void BufferManagerTester::multBuffSize() {
 
     // check telemetry
     this->invoke_to_schedIn(0, 0);
-    ASSERT_TLM_SIZE(2);
+    ASSERT_TLM_SIZE(3);
     ASSERT_TLM_TotalBuffs_SIZE(0);
     ASSERT_TLM_CurrBuffs_SIZE(1);
     ASSERT_TLM_CurrBuffs(0, BIN1_NUM_BUFFERS + BIN2_NUM_BUFFERS);
     ASSERT_TLM_NoBuffs_SIZE(1);
     ASSERT_TLM_NoBuffs(0, 2);
     ASSERT_TLM_EmptyBuffs_SIZE(0);
+    ASSERT_TLM_BinHiBuffs_SIZE(0);
+    binNoBuffs[1] = 2;
+    ASSERT_TLM_BinNoBuffs_SIZE(1);
+    ASSERT_TLM_BinNoBuffs(0, binNoBuffs);
 
     // clear histories
     this->clearHistory();
@@ -416,13 +451,17 @@ void BufferManagerTester::multBuffSize() {
 
     // check telemetry
     this->invoke_to_schedIn(0, 0);
-    ASSERT_TLM_SIZE(2);
+    ASSERT_TLM_SIZE(3);
     ASSERT_TLM_TotalBuffs_SIZE(0);
     ASSERT_TLM_CurrBuffs_SIZE(1);
     ASSERT_TLM_CurrBuffs(0, BIN2_NUM_BUFFERS);
     ASSERT_TLM_NoBuffs_SIZE(1);
     ASSERT_TLM_NoBuffs(0, 3);
     ASSERT_TLM_EmptyBuffs_SIZE(0);
+    ASSERT_TLM_BinHiBuffs_SIZE(0);
+    binNoBuffs[2] = 1;
+    ASSERT_TLM_BinNoBuffs_SIZE(1);
+    ASSERT_TLM_BinNoBuffs(0, binNoBuffs);
 
     // clear histories
     this->clearHistory();
@@ -458,6 +497,279 @@ void BufferManagerTester::multBuffSize() {
     this->component.cleanup();
 }
 
+void BufferManagerTester::resetup() {
+    BufferManagerComponentImpl::BufferBins bins;
+    memset(&bins, 0, sizeof(bins));
+    bins.bins[0].bufferSize = BIN0_BUFFER_SIZE;
+    bins.bins[0].numBuffers = BIN0_NUM_BUFFERS;
+    bins.bins[1].bufferSize = BIN1_BUFFER_SIZE;
+    bins.bins[1].numBuffers = BIN1_NUM_BUFFERS;
+
+    TestAllocator alloc;
+
+    this->component.setup(MGR_ID, MEM_ID, alloc, bins);
+
+    // take every buffer and fail one more request
+    for (U16 entry = 0; entry < BIN0_NUM_BUFFERS + BIN1_NUM_BUFFERS; entry++) {
+        ASSERT_NE(nullptr, this->invoke_to_bufferGetCallee(0, 1).getData());
+    }
+    ASSERT_EQ(nullptr, this->invoke_to_bufferGetCallee(0, 1).getData());
+    ASSERT_EQ(BIN0_NUM_BUFFERS, this->component.m_binStates[0].currBuffs);
+    ASSERT_EQ(BIN1_NUM_BUFFERS, this->component.m_binStates[1].currBuffs);
+    ASSERT_EQ(1, this->component.m_binStates[0].noBuffs);
+    this->clearEvents();
+
+    // tear down with the buffers still out and set up a different pool
+    this->component.cleanup();
+    bins.bins[1].numBuffers = 1;
+    bins.bins[2].bufferSize = BIN2_BUFFER_SIZE;
+    bins.bins[2].numBuffers = BIN2_NUM_BUFFERS;
+    this->component.setup(MGR_ID, MEM_ID, alloc, bins);
+    ASSERT_FALSE(this->component.m_cleaned);
+
+    // nothing carries over from the old pool
+    ASSERT_EQ(0, this->component.m_currBuffs);
+    ASSERT_EQ(0, this->component.m_highWater);
+    ASSERT_EQ(0, this->component.m_noBuffs);
+    for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+        ASSERT_EQ(0, this->component.m_binStates[bin].currBuffs);
+        ASSERT_EQ(0, this->component.m_binStates[bin].highWater);
+        ASSERT_EQ(0, this->component.m_binStates[bin].noBuffs);
+    }
+
+    // every buffer of the new pool can be allocated once
+    static const U16 NUM_BUFFERS = BIN0_NUM_BUFFERS + 1 + BIN2_NUM_BUFFERS;
+    ASSERT_EQ(NUM_BUFFERS, this->component.m_numStructs);
+    Fw::Buffer held[NUM_BUFFERS];
+    for (U16 entry = 0; entry < NUM_BUFFERS; entry++) {
+        held[entry] = this->invoke_to_bufferGetCallee(0, 1);
+        ASSERT_NE(nullptr, held[entry].getData());
+    }
+    ASSERT_EQ(nullptr, this->invoke_to_bufferGetCallee(0, 1).getData());
+    ASSERT_EQ(NUM_BUFFERS, this->component.m_currBuffs);
+    for (U16 entry = 0; entry < NUM_BUFFERS; entry++) {
+        this->invoke_to_bufferSendIn(0, held[entry]);
+    }
+    ASSERT_EQ(0, this->component.m_currBuffs);
+
+    // cleanup BufferManager memory
+    this->component.cleanup();
+    ASSERT_TRUE(this->component.m_cleaned);
+}
+
+void BufferManagerTester::randomGetReturn() {
+    BufferManagerComponentImpl::BufferBins bins;
+    memset(&bins, 0, sizeof(bins));
+    bins.bins[0].bufferSize = BIN0_BUFFER_SIZE;
+    bins.bins[0].numBuffers = BIN0_NUM_BUFFERS;
+    bins.bins[1].bufferSize = BIN1_BUFFER_SIZE;
+    bins.bins[1].numBuffers = BIN1_NUM_BUFFERS;
+    bins.bins[2].bufferSize = BIN2_BUFFER_SIZE;
+    bins.bins[2].numBuffers = BIN2_NUM_BUFFERS;
+
+    TestAllocator alloc;
+
+    this->component.setup(MGR_ID, MEM_ID, alloc, bins);
+
+    static const U16 NUM_BUFFERS = BIN0_NUM_BUFFERS + BIN1_NUM_BUFFERS + BIN2_NUM_BUFFERS;
+    static const U32 NUM_ITERATIONS = 10000;
+    // model of the buffers handed out by the component
+    Fw::Buffer held[NUM_BUFFERS];
+    U16 numHeld = 0;
+    U32 expectedNoBuffs = 0;
+
+    for (U32 iteration = 0; iteration < NUM_ITERATIONS; iteration++) {
+        if ((numHeld > 0) and (STest::Pick::lowerUpper(0, 1) == 0)) {
+            // return a random held buffer
+            const U16 entry = static_cast<U16>(STest::Pick::lowerUpper(0, numHeld - 1));
+            const U32 id = held[entry].getContext() & 0xFFFF;
+            this->invoke_to_bufferSendIn(0, held[entry]);
+            ASSERT_FALSE(this->component.m_buffers[id].allocated);
+            held[entry] = held[--numHeld];
+        } else {
+            // request a random size, sometimes larger than any bin
+            const Fw::Buffer::SizeType size =
+                static_cast<Fw::Buffer::SizeType>(STest::Pick::lowerUpper(1, BIN2_BUFFER_SIZE + 10));
+            // the model expects the smallest fitting buffer that is free
+            bool expectBuffer = false;
+            Fw::Buffer::SizeType expectedSize = 0;
+            for (U16 entry = 0; entry < this->component.m_numStructs; entry++) {
+                if ((not this->component.m_buffers[entry].allocated) and
+                    (size <= this->component.m_buffers[entry].size)) {
+                    expectBuffer = true;
+                    expectedSize = this->component.m_buffers[entry].size;
+                    break;
+                }
+            }
+            Fw::Buffer buffer = this->invoke_to_bufferGetCallee(0, size);
+            if (expectBuffer) {
+                ASSERT_NE(nullptr, buffer.getData());
+                ASSERT_EQ(size, buffer.getSize());
+                const U32 id = buffer.getContext() & 0xFFFF;
+                ASSERT_TRUE(this->component.m_buffers[id].allocated);
+                ASSERT_EQ(expectedSize, this->component.m_buffers[id].size);
+                held[numHeld++] = buffer;
+            } else {
+                ASSERT_EQ(nullptr, buffer.getData());
+                expectedNoBuffs++;
+            }
+        }
+        // check stats against the model
+        ASSERT_EQ(numHeld, this->component.m_currBuffs);
+        ASSERT_EQ(expectedNoBuffs, this->component.m_noBuffs);
+        U32 binCurrBuffs = 0;
+        for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+            ASSERT_LE(this->component.m_binStates[bin].currBuffs, this->component.m_binStates[bin].highWater);
+            binCurrBuffs += this->component.m_binStates[bin].currBuffs;
+        }
+        ASSERT_EQ(numHeld, binCurrBuffs);
+    }
+
+    // return everything and the free lists should hold every buffer
+    while (numHeld > 0) {
+        this->invoke_to_bufferSendIn(0, held[--numHeld]);
+    }
+    U16 numFree = 0;
+    for (U16 bin = 0; bin < BUFFERMGR_MAX_NUM_BINS; bin++) {
+        for (U16 entry = this->component.m_binStates[bin].firstFree;
+             entry != BufferManagerComponentImpl::NO_FREE_BUFFER; entry = this->component.m_buffers[entry].nextFree) {
+            ASSERT_FALSE(this->component.m_buffers[entry].allocated);
+            ASSERT_EQ(bin, this->component.m_buffers[entry].bin);
+            numFree++;
+        }
+    }
+    ASSERT_EQ(NUM_BUFFERS, numFree);
+
+    // cleanup BufferManager memory
+    this->component.cleanup();
+}
+
+namespace {
+
+//! State shared between concurrentGetReturn and its tasks
+struct ConcurrentTaskData {
+    BufferManagerTester* tester;
+    U8 taskId;
+    U32 seed;
+    std::atomic<U8>* owners;  //!< owner of each buffer ID, zero if not held
+    U32 iterations;           //!< number of gets and returns made by the task
+    U32 gets;                 //!< number of successful requests by the task
+};
+
+}  // namespace
+
+void BufferManagerTester ::concurrentGetReturn(BufferManagerComponentImpl::AllocationMode mode,
+                                               U32 iterations,
+                                               bool report) {
+    REQUIREMENT("FPRIME-BM-007");
+
+    BufferManagerComponentImpl::BufferBins bins;
+    memset(&bins, 0, sizeof(bins));
+    bins.bins[0].bufferSize = CONCURRENT_SMALL_SIZE;
+    bins.bins[0].numBuffers = CONCURRENT_NUM_BUFFERS;
+    bins.bins[1].bufferSize = CONCURRENT_LARGE_SIZE;
+    bins.bins[1].numBuffers = CONCURRENT_NUM_BUFFERS;
+
+    TestAllocator alloc;
+
+    this->component.setup(MGR_ID, MEM_ID, alloc, bins, mode);
+
+    std::atomic<U8> owners[2 * CONCURRENT_NUM_BUFFERS];
+    for (U16 entry = 0; entry < 2 * CONCURRENT_NUM_BUFFERS; entry++) {
+        owners[entry] = 0;
+    }
+    ConcurrentTaskData data[CONCURRENT_TASKS];
+    Os::Task tasks[CONCURRENT_TASKS];
+
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 task = 0; task < CONCURRENT_TASKS; task++) {
+        data[task].tester = this;
+        data[task].taskId = static_cast<U8>(task + 1);
+        data[task].seed = STest::Pick::any();
+        data[task].owners = owners;
+        data[task].iterations = iterations;
+        data[task].gets = 0;
+        Os::Task::Arguments arguments(Fw::String("BufMgrTest"), concurrentTask, &data[task]);
+        ASSERT_EQ(Os::Task::OP_OK, tasks[task].start(arguments));
+    }
+    U32 gets = 0;
+    for (U32 task = 0; task < CONCURRENT_TASKS; task++) {
+        ASSERT_EQ(Os::Task::OP_OK, tasks[task].join());
+        gets += data[task].gets;
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (report) {
+        (void)printf("%s: %u tasks, %u get/return pairs, %.1f ns per pair\n",
+                     (mode == BufferManagerComponentImpl::LOCKED) ? "LOCKED" : "LOCK_FREE",
+                     static_cast<unsigned int>(CONCURRENT_TASKS), static_cast<unsigned int>(gets),
+                     elapsed.count() / static_cast<double>(gets));
+    }
+
+    // every buffer is back, nothing failed, and the counts are consistent
+    ASSERT_EQ(0, this->component.m_currBuffs);
+    ASSERT_EQ(0, this->component.m_noBuffs);
+    ASSERT_LE(this->component.m_highWater, CONCURRENT_TASKS * CONCURRENT_HELD);
+    for (U16 entry = 0; entry < this->component.m_numStructs; entry++) {
+        ASSERT_FALSE(this->component.m_buffers[entry].allocated);
+        ASSERT_EQ(0, owners[entry]);
+    }
+    ASSERT_EVENTS_SIZE(0);
+
+    // the pool is still fully usable from a single task afterwards
+    Fw::Buffer held[2 * CONCURRENT_NUM_BUFFERS];
+    for (U16 entry = 0; entry < 2 * CONCURRENT_NUM_BUFFERS; entry++) {
+        held[entry] = this->invoke_to_bufferGetCallee(0, CONCURRENT_SMALL_SIZE);
+        ASSERT_NE(nullptr, held[entry].getData());
+    }
+    for (U16 entry = 0; entry < 2 * CONCURRENT_NUM_BUFFERS; entry++) {
+        this->invoke_to_bufferSendIn(0, held[entry]);
+    }
+
+    this->component.cleanup();
+}
+
+void BufferManagerTester ::concurrentTask(void* arg) {
+    ConcurrentTaskData& data = *static_cast<ConcurrentTaskData*>(arg);
+    Fw::Buffer held[CONCURRENT_HELD];
+    U32 numHeld = 0;
+    U32 random = data.seed;
+    for (U32 iteration = 0; iteration < data.iterations; iteration++) {
+        // STest::Pick is not thread safe, so each task runs its own generator
+        random = random * 1664525U + 1013904223U;
+        if ((numHeld == CONCURRENT_HELD) or ((numHeld > 0) and ((random >> 31) != 0))) {
+            const U32 entry = (random >> 8) % numHeld;
+            const U32 id = held[entry].getContext() & 0xFFFF;
+            // nobody else wrote to the buffer while it was held
+            for (FwSizeType byte = 0; byte < held[entry].getSize(); byte++) {
+                ASSERT_EQ(data.taskId, held[entry].getData()[byte]);
+            }
+            data.owners[id] = 0;
+            data.tester->invoke_to_bufferSendIn(0, held[entry]);
+            held[entry] = held[--numHeld];
+        } else {
+            const Fw::Buffer::SizeType size =
+                static_cast<Fw::Buffer::SizeType>(1 + ((random >> 8) % CONCURRENT_LARGE_SIZE));
+            Fw::Buffer buffer = data.tester->invoke_to_bufferGetCallee(0, size);
+            ASSERT_NE(nullptr, buffer.getData());
+            ASSERT_EQ(size, buffer.getSize());
+            const U32 id = buffer.getContext() & 0xFFFF;
+            // the buffer must not be held by any other task
+            U8 expected = 0;
+            ASSERT_TRUE(data.owners[id].compare_exchange_strong(expected, data.taskId)) << "Buffer " << id
+                                                                                        << " allocated twice";
+            memset(buffer.getData(), data.taskId, buffer.getSize());
+            held[numHeld++] = buffer;
+            data.gets++;
+        }
+    }
+    while (numHeld > 0) {
+        const U32 id = held[--numHeld].getContext() & 0xFFFF;
+        data.owners[id] = 0;
+        data.tester->invoke_to_bufferSendIn(0, held[numHeld]);
+    }
+}
+
 // ----------------------------------------------------------------------
 // Helper methods
 // ----------------------------------------------------------------------
@@ -48,6 +48,15 @@ class BufferManagerTester : public BufferManagerGTestBase {
     //! Multiple buffer sizes
     void multBuffSize();
 
+    //! Set up again after a cleanup with buffers still allocated
+    void resetup();
+
+    //! Randomly get and return buffers and check against a model of the pool
+    void randomGetReturn();
+
+    //! Get and return buffers from several tasks at once, optionally reporting throughput
+    void concurrentGetReturn(BufferManagerComponentImpl::AllocationMode mode, U32 iterations, bool report = false);
+
   private:
     // ----------------------------------------------------------------------
     // Helper methods
@@ -61,6 +70,9 @@ class BufferManagerTester : public BufferManagerGTestBase {
     //!
     void initComponents();
 
+    //! Task routine for concurrentGetReturn
+    static void concurrentTask(void* arg);
+
   private:
     // ----------------------------------------------------------------------
     // Variables
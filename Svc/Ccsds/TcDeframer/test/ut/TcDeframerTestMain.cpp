@@ -36,6 +36,11 @@ TEST(TcDeframer, testInvalidCrc) {
     tester.testInvalidCrc();
 }
 
+TEST(TcDeframer, testCrc16MatchesReference) {
+    Svc::Ccsds::TcDeframerTester tester;
+    tester.testCrc16MatchesReference();
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
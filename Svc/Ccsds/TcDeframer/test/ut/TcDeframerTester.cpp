@@ -10,6 +10,10 @@
 #include "Svc/Ccsds/Types/TCTrailerSerializableAc.hpp"
 #include "Svc/Ccsds/Utils/CRC16.hpp"
 
+extern "C" {
+#include <Utils/Hash/libcrc/lib_crc.h>
+}
+
 namespace Svc {
 
 namespace Ccsds {
@@ -170,6 +174,30 @@ void TcDeframerTester::setComponentState(U16 scid, U8 vcid, U8 sequenceNumber, b
     this->component.configure(vcid, scid, acceptAllVcid);
 }
 
+void TcDeframerTester::testCrc16MatchesReference() {
+    // Frames are built with CRC16::compute, so check it independently against the lib_crc byte-wise CRC-CCITT
+    U8 data[600];
+    for (U32 i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<U8>(STest::Random::lowerUpper(0, 0xFF));
+    }
+    // Cover every length and alignment around the eight byte blocks of the table implementation
+    for (U32 length = 0; length <= sizeof(data) - 8; length++) {
+        for (U32 offset = 0; offset < 8; offset++) {
+            U16 expected = 0xFFFF;
+            Ccsds::Utils::CRC16 incremental;
+            for (U32 i = 0; i < length; i++) {
+                expected = update_crc_ccitt(expected, static_cast<char>(data[offset + i]));
+                incremental.update(data[offset + i]);
+            }
+            ASSERT_EQ(expected, Ccsds::Utils::CRC16::compute(&data[offset], length)) << length << " " << offset;
+            ASSERT_EQ(expected, incremental.finalize()) << length << " " << offset;
+        }
+    }
+    // Standard CRC-16/CCITT-FALSE check value of "123456789"
+    const U8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    ASSERT_EQ(0x29B1, Ccsds::Utils::CRC16::compute(check, sizeof(check)));
+}
+
 Fw::Buffer TcDeframerTester::assembleFrameBuffer(U8* data, U8 dataLength, U16 scid, U8 vcid, U8 seqNumber) {
     ::memset(this->m_frameData, 0, sizeof(this->m_frameData));
     U16 frameLength = static_cast<U16>(TCHeader::SERIALIZED_SIZE + dataLength + TCTrailer::SERIALIZED_SIZE);
@@ -1,11 +1,8 @@
 #ifndef SVC_CCSDS_UTILS_CRC16_HPP
 #define SVC_CCSDS_UTILS_CRC16_HPP
 
+#include <limits>
 #include "Fw/Types/BasicTypes.hpp"
-// Include the lic crc c library:
-extern "C" {
-#include <Utils/Hash/libcrc/lib_crc.h>
-}
 
 namespace Svc {
 namespace Ccsds {
@@ -14,6 +11,8 @@ namespace Utils {
 //! \brief CRC16 CCITT implementation
 //!
 //! CCSDS uses a CRC16 (CCITT) implementation with polynomial 0x1021, initial value of 0xFFFF, and XOR of 0x0000.
+//! Results are the same as lib_crc's `update_crc_ccitt`. Buffers are processed eight bytes per step with slice-by-8
+//! tables built at compile time, so that a full TM frame costs one table lookup per byte and no per-byte call.
 //!
 class CRC16 {
   public:
@@ -25,7 +24,7 @@ class CRC16 {
     //! Update function for CRC taking previous value from member variable and updating it.
     //!
     //! \param new_byte: new byte to add to calculation
-    void update(U8 new_byte) { this->m_crc = static_cast<U16>(update_crc_ccitt(m_crc, static_cast<char>(new_byte))); };
+    void update(U8 new_byte) { this->m_crc = updateByte(this->m_crc, new_byte); };
 
     //! \brief finalize and return CRC value
     U16 finalize() {
@@ -41,16 +40,68 @@ class CRC16 {
     //! \param length: length of the data buffer
     //! \return computed CRC16 value
     static U16 compute(const U8* buffer, U32 length) {
+        const Tables& t = tables();
         U16 crc = std::numeric_limits<U16>::max();  // Initial value
-        for (U32 i = 0; i < length; ++i) {
-            crc = static_cast<U16>(update_crc_ccitt(crc, static_cast<char>(buffer[i])));
+        U32 i = 0;
+        // The register lines up with the first two bytes of each eight byte block
+        for (; length - i >= 8; i += 8) {
+            crc = static_cast<U16>(
+                t.entries[7][buffer[i] ^ (crc >> 8)] ^ t.entries[6][buffer[i + 1] ^ (crc & 0xFF)] ^
+                t.entries[5][buffer[i + 2]] ^ t.entries[4][buffer[i + 3]] ^ t.entries[3][buffer[i + 4]] ^
+                t.entries[2][buffer[i + 5]] ^ t.entries[1][buffer[i + 6]] ^ t.entries[0][buffer[i + 7]]);
+        }
+        for (; i < length; ++i) {
+            crc = updateByte(crc, buffer[i]);
         }
         return crc ^ static_cast<U16>(0);  // Finalize with XOR value
     }
 
     U16 m_crc;
+
+  private:
+    //! Polynomial of the CRC, processed most significant bit first
+    static constexpr U16 POLYNOMIAL = 0x1021;
+
+    //! Slice-by-8 tables. Entry [0][b] is the CRC of byte b from a zero register; entry [k][b] is the CRC of byte b
+    //! followed by k zero bytes.
+    struct Tables {
+        U16 entries[8][256];
+    };
+
+    //! \brief get the slice-by-8 tables
+    static const Tables& tables();
+
+    //! \brief update a CRC value with one byte
+    static U16 updateByte(U16 crc, U8 new_byte) {
+        return static_cast<U16>((crc << 8) ^ tables().entries[0][(crc >> 8) ^ new_byte]);
+    }
+
+    //! \brief build the slice-by-8 tables
+    static constexpr Tables makeTables() {
+        Tables t = {};
+        for (U32 byte = 0; byte < 256; byte++) {
+            U16 crc = static_cast<U16>(byte << 8);
+            for (U32 bit = 0; bit < 8; bit++) {
+                crc = static_cast<U16>((crc & 0x8000) ? ((crc << 1) ^ POLYNOMIAL) : (crc << 1));
+            }
+            t.entries[0][byte] = crc;
+        }
+        for (U32 slice = 1; slice < 8; slice++) {
+            for (U32 byte = 0; byte < 256; byte++) {
+                const U16 previous = t.entries[slice - 1][byte];
+                t.entries[slice][byte] = static_cast<U16>((previous << 8) ^ t.entries[0][previous >> 8]);
+            }
+        }
+        return t;
+    }
 };
 
+inline const CRC16::Tables& CRC16::tables() {
+    // Constant initialized, so no run time initialization is needed
+    static constexpr Tables TABLES = makeTables();
+    return TABLES;
+}
+
 }  // namespace Utils
 }  // namespace Ccsds
 }  // namespace Svc
@@ -64,8 +64,10 @@ ComLogger ::~ComLogger() {
     // faults.
     // So I am copying part of that function here.
     if (OPEN == this->m_fileMode) {
-        // Close file:
-        this->m_file.close();
+        // Close file, writing out the buffered packets:
+        if (Os::File::OP_OK != this->m_file.close()) {
+            this->m_validatedFile.invalidateRunningHash();
+        }
 
         // Write out the hash file to disk:
         this->writeHashFile();
@@ -156,6 +158,10 @@ void ComLogger ::openFile() {
         // Reset byte count:
         this->m_byteCount = 0;
 
+        // Hash the file as it is written:
+        this->m_validatedFile.setFileName(this->m_fileName.toChar());
+        this->m_validatedFile.startRunningHash();
+
         // Set mode:
         this->m_fileMode = OPEN;
     }
@@ -163,8 +169,9 @@ void ComLogger ::openFile() {
 
 void ComLogger ::closeFile() {
     if (OPEN == this->m_fileMode) {
-        // Close file:
-        this->m_file.close();
+        // Close file, writing out any buffered bytes:
+        this->writeBlockToFile();
+        (void)this->m_file.close();
 
         // Write out the hash file to disk:
         this->writeHashFile();
@@ -193,11 +200,15 @@ void ComLogger ::writeComBufferToFile(Fw::ComBuffer& data, U16 size) {
     if (this->writeToFile(data.getBuffAddr(), size)) {
         this->m_byteCount += size;
     }
+
+    // Write the length and buffer out together, so that no packet waits in memory for the next one:
+    this->writeBlockToFile();
 }
 
 bool ComLogger ::writeToFile(void* data, U16 length) {
     FwSizeType size = length;
-    Os::File::Status ret = m_file.write(reinterpret_cast<const U8*>(data), size);
+    Os::File::Status ret = this->m_validatedFile.writeAndHash(this->m_file, reinterpret_cast<const U8*>(data), size,
+                                                              Os::File::WaitType::WAIT);
     if ((Os::File::OP_OK != ret) || (size != length)) {
         if (!this->m_writeErrorOccurred) {  // throttle this event, otherwise a positive
                                             // feedback event loop can occur!
@@ -207,13 +218,34 @@ bool ComLogger ::writeToFile(void* data, U16 length) {
         return false;
     }
 
-    this->m_writeErrorOccurred = false;
     return true;
 }
 
+void ComLogger ::writeBlockToFile() {
+    const FwSizeType bufferedSize = this->m_file.getBufferedSize();
+    if (0 == bufferedSize) {
+        return;
+    }
+    const Os::File::Status ret = this->m_file.writeBlock();
+    if (Os::File::OP_OK != ret) {
+        // The buffered bytes are lost, so the running hash no longer matches the file
+        this->m_validatedFile.invalidateRunningHash();
+        if (!this->m_writeErrorOccurred) {  // throttle this event, otherwise a positive
+                                            // feedback event loop can occur!
+            this->log_WARNING_HI_FileWriteError(ret, 0, static_cast<U32>(bufferedSize), this->m_fileName);
+        }
+        this->m_writeErrorOccurred = true;
+        return;
+    }
+
+    // Reset event throttle once packets reach the file:
+    this->m_writeErrorOccurred = false;
+}
+
 void ComLogger ::writeHashFile() {
     Os::ValidateFile::Status validateStatus;
-    validateStatus = Os::ValidateFile::createValidation(this->m_fileName.toChar(), this->m_hashFileName.toChar());
+    // The hash was computed as the file was written, so the file does not need to be read back
+    validateStatus = this->m_validatedFile.createHashFileFromRunningHash();
     if (Os::ValidateFile::VALIDATION_OK != validateStatus) {
         this->log_WARNING_LO_FileValidationError(this->m_fileName, this->m_hashFileName, validateStatus);
     }
@@ -10,8 +10,10 @@
 #include <limits.h>
 #include <Fw/Types/Assert.hpp>
 #include <Fw/Types/FileNameString.hpp>
+#include <Os/BufferedFile.hpp>
 #include <Os/File.hpp>
 #include <Os/Mutex.hpp>
+#include <Os/ValidatedFile.hpp>
 #include <Utils/Hash/Hash.hpp>
 #include <cstdarg>
 #include <cstdio>
@@ -76,10 +78,11 @@ class ComLogger final : public ComLoggerComponentBase {
     enum FileMode { CLOSED = 0, OPEN = 1 };
 
     FileMode m_fileMode;
-    Os::File m_file;
+    Os::BufferedFile m_file;  //!< Gathers the length prefix and packet into one write
 
     Fw::FileNameString m_fileName;
     Fw::FileNameString m_hashFileName;
+    Os::ValidatedFile m_validatedFile;  //!< Running hash of the open file, written to the hash file on close
     U32 m_byteCount;
     bool m_writeErrorOccurred;
     bool m_openErrorOccurred;
@@ -101,6 +104,8 @@ class ComLogger final : public ComLoggerComponentBase {
 
     bool writeToFile(void* data, U16 length);
 
+    void writeBlockToFile();
+
     void writeHashFile();
 };
 }  // namespace Svc
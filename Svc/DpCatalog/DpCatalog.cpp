@@ -13,10 +13,25 @@
 #include "Fw/Types/StringUtils.hpp"
 #include "Os/File.hpp"
 #include "Os/FileSystem.hpp"
+#include "Utils/Hash/Hash.hpp"
+
+#include <cstring>
 
 namespace Svc {
 static_assert(DP_MAX_DIRECTORIES > 0, "Configuration DP_MAX_DIRECTORIES must be positive");
 static_assert(DP_MAX_FILES > 0, "Configuration DP_MAX_FILES must be positive");
+
+// The index file is a header followed by records appended as the catalog changes. The header holds a magic
+// number, the format version and the record size, followed by a CRC32 of them. Each record holds a directory
+// index and a DP record, followed by a CRC32 of them.
+static const U32 DP_INDEX_MAGIC = 0x44504349;  // "DPCI"
+static const U8 DP_INDEX_VERSION = 1;
+static const FwSizeType DP_INDEX_HEADER_SIZE = sizeof(U32) + sizeof(U8) + sizeof(U16) + sizeof(U32);
+static const FwSizeType DP_INDEX_RECORD_SIZE = sizeof(FwIndexType) + DpRecord::SERIALIZED_SIZE + sizeof(U32);
+// number of records read or written with each file operation
+static const FwSizeType DP_INDEX_BLOCK_RECORDS = 16;
+// extension of the file written while compacting the index file
+static const char DP_INDEX_TEMP_EXT[] = ".tmp";
 // ----------------------------------------------------------------------
 // Component construction and destruction
 // ----------------------------------------------------------------------
@@ -24,14 +39,13 @@ static_assert(DP_MAX_FILES > 0, "Configuration DP_MAX_FILES must be positive");
 DpCatalog ::DpCatalog(const char* const compName)
     : DpCatalogComponentBase(compName),
       m_initialized(false),
-      m_dpTree(nullptr),
-      m_freeListHead(nullptr),
-      m_currentNode(nullptr),
-      m_currentXmitNode(nullptr),
+      m_numIndexed(0),
       m_numDpSlots(0),
       m_numDirectories(0),
       m_stateFileData(nullptr),
       m_stateFileEntries(0),
+      m_indexRecords(0),
+      m_indexValid(false),
       m_memSize(0),
       m_memPtr(nullptr),
       m_allocatorId(0),
@@ -52,20 +66,22 @@ void DpCatalog::configure(Fw::FileNameString directories[DP_MAX_DIRECTORIES],
                           FwSizeType numDirs,
                           Fw::FileNameString& stateFile,
                           FwEnumStoreType memId,
-                          Fw::MemAllocator& allocator) {
+                          Fw::MemAllocator& allocator,
+                          const Fw::FileNameString& indexFile) {
     // Do some assertion checks
     FW_ASSERT(numDirs <= DP_MAX_DIRECTORIES, static_cast<FwAssertArgType>(numDirs));
 
     this->m_stateFile = stateFile;
+    this->m_indexFile = indexFile;
 
     // request memory for catalog which is DP_MAX_FILES * slot size.
     //
-    // A "slot" consists of a set of two memory locations for each data product consisting
-    // an entry in the binary tree and
+    // A "slot" consists of a set of three memory locations for each data product consisting
+    // a node in the downlink index, an entry in the index free list, and
     // an entry in the state file data. These may not be fully used in a given
     // situation based on the number of actual data products, but this provides room for the
     // maximum possible.
-    static const FwSizeType slotSize = sizeof(DpBtreeNode) + sizeof(DpDstateFileEntry);
+    static const FwSizeType slotSize = sizeof(DpIndex::Node) + sizeof(DpIndex::Index) + sizeof(DpDstateFileEntry);
     this->m_memSize = DP_MAX_FILES * slotSize;
     bool notUsed;  // we don't need to recover the catalog.
     // request memory. this->m_memSize will be modified if there is less than we requested
@@ -81,18 +97,29 @@ void DpCatalog::configure(Fw::FileNameString directories[DP_MAX_DIRECTORIES],
     // don't get the full amount requested. This allows for graceful degradation
     // if there are memory issues.
     //
-    // 2) Place the binary tree free list at the beginning of the memory.
+    // 2) Place the index nodes at the beginning of the memory.
+    //
+    // 3) Place the state file data in memory after the index nodes
+    // by indexing the nodes to one element past the end of
+    // the nodes.
     //
-    // 3) Place the state file data in memory after the binary free list
-    // by indexing the free list to one element past the end of
-    // the free list.
+    // 4) Place the index free list after the state file data. It has
+    // the smallest alignment, so it goes last.
 
     if ((this->m_memSize >= slotSize) and (this->m_memPtr != nullptr)) {
         // set the number of available record slots based on how much memory we actually got
         this->m_numDpSlots = this->m_memSize / slotSize;  // Step 1.
-        this->resetBinaryTree();                          // Step 2
+        DpIndex::Node* nodes = static_cast<DpIndex::Node*>(this->m_memPtr);
+        for (FwSizeType slot = 0; slot < this->m_numDpSlots; slot++) {
+            // overlay new instance of the index node on the memory - Step 2
+            (void)new (&nodes[slot]) DpIndex::Node();
+        }
         // assign pointer for the state file storage - Step 3
-        this->m_stateFileData = reinterpret_cast<DpDstateFileEntry*>(&this->m_freeListHead[this->m_numDpSlots]);
+        this->m_stateFileData = reinterpret_cast<DpDstateFileEntry*>(&nodes[this->m_numDpSlots]);
+        // assign the index storage - Step 4
+        DpIndex::Index* freeNodes = reinterpret_cast<DpIndex::Index*>(&this->m_stateFileData[this->m_numDpSlots]);
+        this->m_dpIndex.setStorage(nodes, freeNodes, this->m_numDpSlots);
+        this->resetIndex();
     } else {
         // if we don't have enough memory, set the number of records
         // to zero for later detection
@@ -111,23 +138,11 @@ void DpCatalog::configure(Fw::FileNameString directories[DP_MAX_DIRECTORIES],
     this->m_initialized = true;
 }
 
-void DpCatalog::resetBinaryTree() {
-    // initialize data structures in the free list
-    // Step 2 in memory partition (see configure() comments)
+void DpCatalog::resetIndex() {
     FW_ASSERT(this->m_memPtr);
-    this->m_freeListHead = static_cast<DpBtreeNode*>(this->m_memPtr);
-    for (FwSizeType slot = 0; slot < this->m_numDpSlots; slot++) {
-        // overlay new instance of the DpState entry on the memory
-        (void)new (&this->m_freeListHead[slot]) DpBtreeNode();
-        this->m_freeListHead[slot].left = nullptr;
-        this->m_freeListHead[slot].right = nullptr;
-        // link the free list
-        if (slot > 0) {
-            this->m_freeListHead[slot - 1].left = &this->m_freeListHead[slot];
-        }
-    }
-    // clear binary tree
-    this->m_dpTree = nullptr;
+    // clear the index, returning all nodes to its free list
+    this->m_dpIndex.clear();
+    this->m_numIndexed = 0;
     // reset number of records
     this->m_pendingFiles = 0;
     this->m_pendingDpBytes = 0;
@@ -140,6 +155,7 @@ void DpCatalog::resetStateFileData() {
     for (FwSizeType slot = 0; slot < this->m_numDpSlots; slot++) {
         this->m_stateFileData[slot].used = false;
         this->m_stateFileData[slot].visited = false;
+        this->m_stateFileData[slot].line = 0;
         (void)new (&this->m_stateFileData[slot].entry.record) DpRecord();
     }
     this->m_stateFileEntries = 0;
@@ -210,6 +226,7 @@ Fw::CmdResponse DpCatalog::loadStateFile() {
         FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
         this->m_stateFileData[entry].used = true;
         this->m_stateFileData[entry].visited = false;
+        this->m_stateFileData[entry].line = entry;
 
         // increment the file location
         fileLoc += size;
@@ -219,19 +236,75 @@ Fw::CmdResponse DpCatalog::loadStateFile() {
     return Fw::CmdResponse::OK;
 }
 
-void DpCatalog::getFileState(DpStateEntry& entry) {
+int DpCatalog::DpDstateFileEntry::compareProducts(const DpStateEntry& left, const DpStateEntry& right) {
+    // check directory, then id, priority, & time
+    if (left.dir < right.dir) {
+        return -1;
+    } else if (left.dir > right.dir) {
+        return 1;
+    }
+    return DpStateEntry::compareEntries(left, right);
+}
+
+bool DpCatalog::DpDstateFileEntry::operator<(const DpDstateFileEntry& other) const {
+    const int compare = compareProducts(this->entry, other.entry);
+    return (compare < 0) or ((compare == 0) and (this->line < other.line));
+}
+
+void DpCatalog::sortStateFileData() {
     FW_ASSERT(this->m_stateFileData);
-    // search the file state data for the entry
-    for (FwSizeType line = 0; line < this->m_stateFileEntries; line++) {
-        // check for a match (compare dir, then id, priority, & time)
-        if (this->m_stateFileData[line].entry.dir == entry.dir && this->m_stateFileData[line].entry == entry) {
-            // update the transmitted state
-            entry.record.set_state(this->m_stateFileData[line].entry.record.get_state());
-            entry.record.set_blocks(this->m_stateFileData[line].entry.record.get_blocks());
-            // mark it as visited for later pruning if necessary
-            this->m_stateFileData[line].visited = true;
+    // Heap sort the loaded entries in place. It needs no extra memory or recursion
+    // and takes O(n log n) steps for any state file.
+    const FwSizeType count = this->m_stateFileEntries;
+    for (FwSizeType root = count / 2; root > 0; root--) {
+        this->siftStateFileData(root - 1, count);
+    }
+    for (FwSizeType end = count; end > 1; end--) {
+        const DpDstateFileEntry largest = this->m_stateFileData[0];
+        this->m_stateFileData[0] = this->m_stateFileData[end - 1];
+        this->m_stateFileData[end - 1] = largest;
+        this->siftStateFileData(0, end - 1);
+    }
+}
+
+void DpCatalog::siftStateFileData(FwSizeType root, const FwSizeType count) {
+    while (2 * root + 1 < count) {
+        // find the larger child
+        FwSizeType child = 2 * root + 1;
+        if ((child + 1 < count) and (this->m_stateFileData[child] < this->m_stateFileData[child + 1])) {
+            child++;
+        }
+        if (not(this->m_stateFileData[root] < this->m_stateFileData[child])) {
             return;
         }
+        const DpDstateFileEntry parent = this->m_stateFileData[root];
+        this->m_stateFileData[root] = this->m_stateFileData[child];
+        this->m_stateFileData[child] = parent;
+        root = child;
+    }
+}
+
+void DpCatalog::getFileState(DpStateEntry& entry) {
+    FW_ASSERT(this->m_stateFileData);
+    // binary search the sorted file state data for the first line with the entry
+    FwSizeType low = 0;
+    FwSizeType high = this->m_stateFileEntries;
+    while (low < high) {
+        const FwSizeType middle = low + (high - low) / 2;
+        if (DpDstateFileEntry::compareProducts(this->m_stateFileData[middle].entry, entry) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    // check for a match (compare dir, then id, priority, & time)
+    if ((low < this->m_stateFileEntries) and
+        (DpDstateFileEntry::compareProducts(this->m_stateFileData[low].entry, entry) == 0)) {
+        // update the transmitted state
+        entry.record.set_state(this->m_stateFileData[low].entry.record.get_state());
+        entry.record.set_blocks(this->m_stateFileData[low].entry.record.get_blocks());
+        // mark it as visited for later pruning if necessary
+        this->m_stateFileData[low].visited = true;
     }
 }
 
@@ -329,6 +402,335 @@ void DpCatalog::appendFileState(const DpStateEntry& entry) {
     stateFile.close();
 }
 
+void DpCatalog::serializeIndexHeader(Fw::LinearBufferBase& buffer) {
+    FW_ASSERT(buffer.getSize() == 0, static_cast<FwAssertArgType>(buffer.getSize()));
+    Fw::SerializeStatus serStat = buffer.serializeFrom(DP_INDEX_MAGIC);
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+    serStat = buffer.serializeFrom(DP_INDEX_VERSION);
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+    serStat = buffer.serializeFrom(static_cast<U16>(DP_INDEX_RECORD_SIZE));
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+    Utils::HashBuffer crc;
+    Utils::Hash::hash(buffer.getBuffAddr(), buffer.getSize(), crc);
+    serStat = buffer.serializeFrom(crc.asBigEndianU32());
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+}
+
+void DpCatalog::serializeIndexRecord(const DpStateEntry& entry, Fw::LinearBufferBase& buffer) {
+    // the record may follow others in the buffer
+    const Fw::Serializable::SizeType start = buffer.getSize();
+    Fw::SerializeStatus serStat = buffer.serializeFrom(entry.dir);
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+    serStat = buffer.serializeFrom(entry.record);
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+    Utils::HashBuffer crc;
+    Utils::Hash::hash(&buffer.getBuffAddr()[start], buffer.getSize() - start, crc);
+    serStat = buffer.serializeFrom(crc.asBigEndianU32());
+    FW_ASSERT(serStat == Fw::FW_SERIALIZE_OK, serStat);
+}
+
+bool DpCatalog::deserializeIndexRecord(const U8* record, DpStateEntry& entry) {
+    FW_ASSERT(record != nullptr);
+    U8 buffer[DP_INDEX_RECORD_SIZE];
+    (void)::memcpy(buffer, record, sizeof(buffer));
+    Fw::ExternalSerializeBuffer recordBuffer(buffer, sizeof(buffer));
+    Fw::SerializeStatus status = recordBuffer.setBuffLen(static_cast<Fw::Serializable::SizeType>(sizeof(buffer)));
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+
+    // check the checksum before using the fields
+    Utils::HashBuffer crc;
+    Utils::Hash::hash(buffer, sizeof(buffer) - sizeof(U32), crc);
+    status = recordBuffer.moveDeserToOffset(sizeof(buffer) - sizeof(U32));
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    U32 storedCrc = 0;
+    status = recordBuffer.deserializeTo(storedCrc);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    if (storedCrc != crc.asBigEndianU32()) {
+        return false;
+    }
+
+    recordBuffer.resetDeser();
+    status = recordBuffer.deserializeTo(entry.dir);
+    FW_ASSERT(Fw::FW_SERIALIZE_OK == status, status);
+    status = recordBuffer.deserializeTo(entry.record);
+    if (status != Fw::FW_SERIALIZE_OK) {
+        return false;
+    }
+    // the directories may have been reconfigured since the record was written
+    return (entry.dir >= 0) and (entry.dir < static_cast<FwIndexType>(this->m_numDirectories));
+}
+
+bool DpCatalog::loadIndexFile() {
+    FW_ASSERT(this->m_stateFileData);
+    this->m_indexValid = false;
+
+    // Make sure that a file was specified
+    if (this->m_indexFile.length() == 0) {
+        return false;
+    }
+
+    // open the index file. Without one, the directories are scanned
+    Os::File indexFile;
+    Os::File::Status stat = indexFile.open(this->m_indexFile.toChar(), Os::File::OPEN_READ);
+    if (stat == Os::File::DOESNT_EXIST) {
+        return false;
+    }
+    if (stat != Os::File::OP_OK) {
+        this->log_WARNING_HI_IndexReadError(this->m_indexFile, stat, 0);
+        return false;
+    }
+
+    // The header has to match the one this build writes, which checks the format version and record layout
+    BYTE header[DP_INDEX_HEADER_SIZE];
+    Fw::ExternalSerializeBuffer headerBuffer(header, sizeof(header));
+    DpCatalog::serializeIndexHeader(headerBuffer);
+
+    // The file is read sequentially a block of records at a time
+    BYTE block[DP_INDEX_BLOCK_RECORDS * DP_INDEX_RECORD_SIZE];
+    FwSizeType size = DP_INDEX_HEADER_SIZE;
+    stat = indexFile.read(block, size);
+    if (stat != Os::File::OP_OK) {
+        this->log_WARNING_HI_IndexReadError(this->m_indexFile, stat, 0);
+        return false;
+    }
+    if ((size != DP_INDEX_HEADER_SIZE) or (::memcmp(block, header, DP_INDEX_HEADER_SIZE) != 0)) {
+        this->log_WARNING_LO_IndexInvalid(this->m_indexFile);
+        return false;
+    }
+
+    // The records are read into the state file data, which the caller reloads from the state file afterward
+    FwSizeType fileLoc = DP_INDEX_HEADER_SIZE;
+    FwSizeType records = 0;
+    bool truncated = false;
+    bool done = false;
+    while (not done) {
+        size = sizeof(block);
+        stat = indexFile.read(block, size);
+        if (stat != Os::File::OP_OK) {
+            this->log_WARNING_HI_IndexReadError(this->m_indexFile, stat, static_cast<I32>(fileLoc));
+            return false;
+        }
+        // a short read is the end of the file
+        done = (size < sizeof(block));
+
+        for (FwSizeType offset = 0; offset + DP_INDEX_RECORD_SIZE <= size; offset += DP_INDEX_RECORD_SIZE) {
+            // compaction keeps the file within the slots of the catalog that wrote it
+            if (records == this->m_numDpSlots) {
+                this->log_WARNING_LO_IndexInvalid(this->m_indexFile);
+                return false;
+            }
+            DpDstateFileEntry& loaded = this->m_stateFileData[records];
+            if (not this->deserializeIndexRecord(&block[offset], loaded.entry)) {
+                truncated = true;
+                break;
+            }
+            loaded.used = true;
+            loaded.visited = false;
+            loaded.line = records;
+            records++;
+            fileLoc += DP_INDEX_RECORD_SIZE;
+        }
+
+        // An interrupted append leaves a partial or corrupt record at the end. The records before it are used.
+        if (truncated or ((size % DP_INDEX_RECORD_SIZE) != 0)) {
+            this->log_WARNING_LO_IndexTruncated(this->m_indexFile, static_cast<I32>(fileLoc));
+            truncated = true;
+            done = true;
+        }
+    }
+    indexFile.close();
+
+    // Sort the records by product. The records of a product stay in the order they were appended,
+    // so the last one holds its current state
+    this->m_stateFileEntries = records;
+    this->sortStateFileData();
+    for (FwSizeType entry = 0; entry < records; entry++) {
+        const DpStateEntry& loaded = this->m_stateFileData[entry].entry;
+        if ((entry + 1 < records) and
+            (DpDstateFileEntry::compareProducts(loaded, this->m_stateFileData[entry + 1].entry) == 0)) {
+            continue;
+        }
+        if (loaded.record.get_state() == Fw::DpState::TRANSMITTED) {
+            continue;
+        }
+        // there are no more products than records, so the index has room
+        const bool inserted = this->insertEntry(loaded);
+        FW_ASSERT(inserted);
+        this->m_pendingFiles++;
+        this->m_pendingDpBytes += loaded.record.get_size();
+    }
+
+    this->m_indexRecords = records;
+    this->m_indexValid = true;
+    this->log_ACTIVITY_HI_IndexLoaded(this->m_indexFile, this->m_pendingFiles);
+
+    // compact the file if it has a bad record or is mostly superseded records
+    if (truncated or (records > 2 * static_cast<FwSizeType>(this->m_pendingFiles))) {
+        (void)this->writeIndexFile();
+    }
+
+    return true;
+}
+
+bool DpCatalog::checkIndexFile() {
+    FW_ASSERT(this->m_indexFile.length() > 0);
+
+    FwSizeType fileSize = 0;
+    if (Os::FileSystem::getFileSize(this->m_indexFile.toChar(), fileSize) != Os::FileSystem::OP_OK) {
+        return false;
+    }
+
+    Os::File indexFile;
+    Os::File::Status stat = indexFile.open(this->m_indexFile.toChar(), Os::File::OPEN_READ);
+    if (stat != Os::File::OP_OK) {
+        return false;
+    }
+    BYTE header[DP_INDEX_HEADER_SIZE];
+    FwSizeType size = sizeof(header);
+    stat = indexFile.read(header, size);
+    indexFile.close();
+
+    BYTE expected[DP_INDEX_HEADER_SIZE];
+    Fw::ExternalSerializeBuffer headerBuffer(expected, sizeof(expected));
+    DpCatalog::serializeIndexHeader(headerBuffer);
+    if ((stat != Os::File::OP_OK) or (size != sizeof(header)) or (::memcmp(header, expected, sizeof(header)) != 0)) {
+        return false;
+    }
+
+    // a record appended after a partial one would be lost
+    if (((fileSize - DP_INDEX_HEADER_SIZE) % DP_INDEX_RECORD_SIZE) != 0) {
+        return false;
+    }
+
+    this->m_indexRecords = (fileSize - DP_INDEX_HEADER_SIZE) / DP_INDEX_RECORD_SIZE;
+    this->m_indexValid = true;
+    return true;
+}
+
+bool DpCatalog::writeIndexFile() {
+    // Make sure that a file was specified
+    if (this->m_indexFile.length() == 0) {
+        return false;
+    }
+    this->m_indexValid = false;
+
+    // The entries are written to a new file that is then renamed over the old one,
+    // so an interrupted write leaves the old file in place
+    Fw::FileNameString tempFile;
+    tempFile.format("%s%s", this->m_indexFile.toChar(), DP_INDEX_TEMP_EXT);
+
+    Os::File indexFile;
+    Os::File::Status stat = indexFile.open(tempFile.toChar(), Os::File::OPEN_CREATE, Os::FileInterface::OVERWRITE);
+    if (stat != Os::File::OP_OK) {
+        this->log_WARNING_HI_IndexWriteError(this->m_indexFile, stat);
+        this->invalidateIndexFile();
+        return false;
+    }
+
+    BYTE block[DP_INDEX_BLOCK_RECORDS * DP_INDEX_RECORD_SIZE];
+    Fw::ExternalSerializeBuffer blockBuffer(block, sizeof(block));
+    DpCatalog::serializeIndexHeader(blockBuffer);
+    FwSizeType records = 0;
+
+    // the entry being sent has left the index but has not been transmitted
+    if (this->m_xmitInProgress) {
+        DpCatalog::serializeIndexRecord(this->m_currentXmitEntry, blockBuffer);
+        records++;
+    }
+
+    for (DpIndex::ConstIterator it = this->m_dpIndex.begin(); (stat == Os::File::OP_OK) and it.isInRange(); ++it) {
+        // write out a full block
+        if (blockBuffer.getSize() + DP_INDEX_RECORD_SIZE > sizeof(block)) {
+            FwSizeType size = blockBuffer.getSize();
+            stat = indexFile.write(block, size);
+            blockBuffer.resetSer();
+        }
+        DpCatalog::serializeIndexRecord(it->entry, blockBuffer);
+        records++;
+    }
+    if (stat == Os::File::OP_OK) {
+        FwSizeType size = blockBuffer.getSize();
+        stat = indexFile.write(block, size);
+    }
+    indexFile.close();
+
+    if (stat != Os::File::OP_OK) {
+        this->log_WARNING_HI_IndexWriteError(this->m_indexFile, stat);
+        (void)Os::FileSystem::removeFile(tempFile.toChar());
+        this->invalidateIndexFile();
+        return false;
+    }
+
+    const Os::FileSystem::Status moveStat = Os::FileSystem::rename(tempFile.toChar(), this->m_indexFile.toChar());
+    if (moveStat != Os::FileSystem::OP_OK) {
+        this->log_WARNING_HI_IndexWriteError(this->m_indexFile, moveStat);
+        (void)Os::FileSystem::removeFile(tempFile.toChar());
+        this->invalidateIndexFile();
+        return false;
+    }
+
+    this->m_indexRecords = records;
+    this->m_indexValid = true;
+    return true;
+}
+
+void DpCatalog::appendIndexRecord(const DpStateEntry& entry) {
+    // Make sure that a file was specified
+    if (this->m_indexFile.length() == 0) {
+        return;
+    }
+
+    if (not this->m_indexValid) {
+        // Before the catalog is built, the index file hasn't been loaded. Check it, so the entry can be
+        // appended for the build to load. After a build, the index file has already been removed.
+        if (this->m_catalogBuilt or (not this->checkIndexFile())) {
+            this->invalidateIndexFile();
+            return;
+        }
+    }
+
+    // Compact the file before it holds more records than a build can load. Before a build, the catalog
+    // doesn't hold the entries to compact it with, and a full catalog with an entry in flight doesn't fit.
+    if (this->m_indexRecords >= this->m_numDpSlots) {
+        if ((not this->m_catalogBuilt) or (not this->writeIndexFile()) or
+            (this->m_indexRecords >= this->m_numDpSlots)) {
+            this->invalidateIndexFile();
+            return;
+        }
+    }
+
+    // open the index file
+    Os::File indexFile;
+    Os::File::Status stat = indexFile.open(this->m_indexFile.toChar(), Os::File::OPEN_APPEND);
+    if (stat != Os::File::OP_OK) {
+        this->log_WARNING_HI_IndexWriteError(this->m_indexFile, stat);
+        this->invalidateIndexFile();
+        return;
+    }
+
+    BYTE buffer[DP_INDEX_RECORD_SIZE];
+    Fw::ExternalSerializeBuffer recordBuffer(buffer, sizeof(buffer));
+    DpCatalog::serializeIndexRecord(entry, recordBuffer);
+    FwSizeType size = recordBuffer.getSize();
+    stat = indexFile.write(buffer, size);
+    indexFile.close();
+    if ((stat != Os::File::OP_OK) or (size != sizeof(buffer))) {
+        this->log_WARNING_HI_IndexWriteError(this->m_indexFile, stat);
+        this->invalidateIndexFile();
+        return;
+    }
+
+    this->m_indexRecords++;
+}
+
+void DpCatalog::invalidateIndexFile() {
+    this->m_indexValid = false;
+    this->m_indexRecords = 0;
+    if (this->m_indexFile.length() > 0) {
+        (void)Os::FileSystem::removeFile(this->m_indexFile.toChar());
+    }
+}
+
 Fw::CmdResponse DpCatalog::doCatalogBuild() {
     // check initialization
     if (not this->checkInit()) {
@@ -347,26 +749,48 @@ Fw::CmdResponse DpCatalog::doCatalogBuild() {
         return Fw::CmdResponse::EXECUTION_ERROR;
     }
 
+    // reset the index
+    this->resetIndex();
+
+    // fill the index from the index file if it is valid. It is read through the state file data
+    this->resetStateFileData();
+    const bool indexLoaded = this->loadIndexFile();
+
     // reset state file data
     this->resetStateFileData();
 
     // load state data from file
     Fw::CmdResponse response = this->loadStateFile();
+    // sort the entries that were read for lookup
+    this->sortStateFileData();
 
-    // reset free list for entries
-    this->resetBinaryTree();
+    if (indexLoaded) {
+        // no files were visited, so keep the whole state file until the next scan
+        for (FwSizeType entry = 0; entry < this->m_stateFileEntries; entry++) {
+            this->m_stateFileData[entry].visited = true;
+        }
+    } else {
+        // fill the index with DP files
+        bool complete = true;
+        response = this->fillIndex(complete);
+        if (response != Fw::CmdResponse::OK) {
+            // clean up the index
+            this->resetIndex();
+            this->resetStateFileData();
+            return response;
+        }
 
-    // fill the binary tree with DP files
-    response = this->fillBinaryTree();
-    if (response != Fw::CmdResponse::OK) {
-        // clean up the binary tree
-        this->resetBinaryTree();
-        this->resetStateFileData();
-        return response;
-    }
+        // prune and rewrite the state file
+        this->pruneAndWriteStateFile();
 
-    // prune and rewrite the state file
-    this->pruneAndWriteStateFile();
+        // record the catalog so the next build can load it. A truncated scan is missing files that the
+        // next build must find, so it rescans instead.
+        if (complete) {
+            (void)this->writeIndexFile();
+        } else {
+            this->invalidateIndexFile();
+        }
+    }
 
     this->log_ACTIVITY_HI_CatalogBuildComplete();
 
@@ -376,9 +800,10 @@ Fw::CmdResponse DpCatalog::doCatalogBuild() {
     return Fw::CmdResponse::OK;
 }
 
-Fw::CmdResponse DpCatalog::fillBinaryTree() {
+Fw::CmdResponse DpCatalog::fillIndex(bool& complete) {
     // keep cumulative number of files
     FwSizeType totalFiles = 0;
+    complete = true;
 
     // get file listings from file system
     for (FwSizeType dir = 0; dir < this->m_numDirectories; dir++) {
@@ -403,8 +828,13 @@ Fw::CmdResponse DpCatalog::fillBinaryTree() {
         // Assert number of files isn't more than asked
         FW_ASSERT(filesRead <= this->m_numDpSlots - totalFiles, static_cast<FwAssertArgType>(filesRead),
                   static_cast<FwAssertArgType>(this->m_numDpSlots - totalFiles));
+        // a listing that filled the remaining slots may have left files out
+        if (filesRead == this->m_numDpSlots - totalFiles) {
+            complete = false;
+        }
 
-        // extract metadata for each file
+        // keep the full path of each file with the DP extension
+        FwSizeType dpFiles = 0;
         for (FwSizeType file = 0; file < filesRead; file++) {
             // only consider files with the DP extension
 
@@ -418,9 +848,22 @@ Fw::CmdResponse DpCatalog::fillBinaryTree() {
 
             Fw::String fullFile;
             fullFile.format("%s/%s", this->m_directories[dir].toChar(), this->m_fileList[file].toChar());
+            this->m_fileList[dpFiles] = fullFile;
+            dpFiles++;
+        }
 
-            int ret = processFile(fullFile, dir);
+        // read all the headers up front when there are tasks to share the work
+        const bool scanned = this->m_scanPool.isRunning();
+        if (scanned) {
+            this->m_scanPool.scan(this->m_fileList, dir, this->m_headerReads, dpFiles);
+        }
+
+        // extract metadata for each file
+        for (FwSizeType file = 0; file < dpFiles; file++) {
+            int ret = scanned ? this->catalogHeader(this->m_fileList[file], this->m_headerReads[file])
+                              : this->processFile(this->m_fileList[file], dir);
             if (ret < 0) {
+                complete = false;
                 break;
             }
 
@@ -437,13 +880,14 @@ Fw::CmdResponse DpCatalog::fillBinaryTree() {
         // that means generated products exceed the catalog size
         if (totalFiles == this->m_numDpSlots) {
             this->log_WARNING_HI_CatalogFull(this->m_directories[dir]);
+            complete = false;
             break;
         }
     }  // end for each directory
 
     return Fw::CmdResponse::OK;
 
-}  // end fillBinaryTree()
+}  // end fillIndex()
 
 FwSizeType DpCatalog::determineDirectory(Fw::String fullFile) {
     // Grab the directory string (up until the final slash)
@@ -478,6 +922,12 @@ FwSizeType DpCatalog::determineDirectory(Fw::String fullFile) {
 }
 
 int DpCatalog::processFile(Fw::String fullFile, FwSizeType dir) {
+    DpHeaderRead header;
+    DpCatalog::readHeader(fullFile, dir, header);
+    return this->catalogHeader(fullFile, header);
+}
+
+void DpCatalog::readHeader(const Fw::StringBase& fullFile, FwSizeType dir, DpHeaderRead& header) {
     // file class instance for processing files
     Os::File dpFile;
 
@@ -486,20 +936,22 @@ int DpCatalog::processFile(Fw::String fullFile, FwSizeType dir) {
     Fw::Buffer hdrBuff(dpBuff, sizeof(dpBuff));   // buffer for container header decoding
     Fw::DpContainer container;                    // container object for extracting header fields
 
-    this->log_ACTIVITY_LO_ProcessingFile(fullFile);
+    header.stat = 0;
 
     // get file size
     FwSizeType fileSize = 0;
     Os::FileSystem::Status sizeStat = Os::FileSystem::getFileSize(fullFile.toChar(), fileSize);
     if (sizeStat != Os::FileSystem::OP_OK) {
-        this->log_WARNING_HI_FileSizeError(fullFile, sizeStat);
-        return 0;
+        header.status = HEADER_SIZE_ERROR;
+        header.stat = static_cast<I32>(sizeStat);
+        return;
     }
 
     Os::File::Status stat = dpFile.open(fullFile.toChar(), Os::File::OPEN_READ);
     if (stat != Os::File::OP_OK) {
-        this->log_WARNING_HI_FileOpenError(fullFile, stat);
-        return 0;
+        header.status = HEADER_OPEN_ERROR;
+        header.stat = static_cast<I32>(stat);
+        return;
     }
 
     // Read DP header
@@ -507,16 +959,18 @@ int DpCatalog::processFile(Fw::String fullFile, FwSizeType dir) {
 
     stat = dpFile.read(dpBuff, size);
     if (stat != Os::File::OP_OK) {
-        this->log_WARNING_HI_FileReadError(fullFile, stat);
+        header.status = HEADER_READ_ERROR;
+        header.stat = static_cast<I32>(stat);
         dpFile.close();
-        return 0;
+        return;
     }
 
     // if full header isn't read, something's wrong with the file, so skip
     if (size != Fw::DpContainer::Header::SIZE) {
-        this->log_WARNING_HI_FileReadError(fullFile, Os::File::BAD_SIZE);
+        header.status = HEADER_READ_ERROR;
+        header.stat = static_cast<I32>(Os::File::BAD_SIZE);
         dpFile.close();
-        return 0;
+        return;
     }
 
     // if all is well, don't need the file any more
@@ -528,32 +982,62 @@ int DpCatalog::processFile(Fw::String fullFile, FwSizeType dir) {
     // reset header deserialization in the container
     Fw::SerializeStatus desStat = container.deserializeHeader();
     if (desStat != Fw::FW_SERIALIZE_OK) {
-        this->log_WARNING_HI_FileHdrDesError(fullFile, desStat);
-        return 0;
+        header.status = HEADER_DES_ERROR;
+        header.stat = static_cast<I32>(desStat);
+        return;
     }
 
     // skip adding an already transmitted file
     if (container.getState() == Fw::DpState::TRANSMITTED) {
-        this->log_ACTIVITY_HI_DpFileSkipped(fullFile);
-        return 0;
+        header.status = HEADER_TRANSMITTED;
+        return;
+    }
+
+    // build the catalog entry
+    header.status = HEADER_OK;
+    header.entry.dir = static_cast<FwIndexType>(dir);
+    header.entry.record.set_id(container.getId());
+    header.entry.record.set_priority(container.getPriority());
+    header.entry.record.set_state(container.getState());
+    header.entry.record.set_tSec(container.getTimeTag().getSeconds());
+    header.entry.record.set_tSub(container.getTimeTag().getUSeconds());
+    header.entry.record.set_size(static_cast<U64>(fileSize));
+}
+
+int DpCatalog::catalogHeader(const Fw::StringBase& fullFile, const DpHeaderRead& header) {
+    this->log_ACTIVITY_LO_ProcessingFile(fullFile);
+
+    switch (header.status) {
+        case HEADER_OK:
+            break;
+        case HEADER_SIZE_ERROR:
+            this->log_WARNING_HI_FileSizeError(fullFile, header.stat);
+            return 0;
+        case HEADER_OPEN_ERROR:
+            this->log_WARNING_HI_FileOpenError(fullFile, header.stat);
+            return 0;
+        case HEADER_READ_ERROR:
+            this->log_WARNING_HI_FileReadError(fullFile, header.stat);
+            return 0;
+        case HEADER_DES_ERROR:
+            this->log_WARNING_HI_FileHdrDesError(fullFile, header.stat);
+            return 0;
+        case HEADER_TRANSMITTED:
+            this->log_ACTIVITY_HI_DpFileSkipped(fullFile);
+            return 0;
+        default:
+            FW_ASSERT(0, static_cast<FwAssertArgType>(header.status));
+            return 0;
     }
 
     // add entry to catalog.
-    DpStateEntry entry;
-    entry.dir = static_cast<FwIndexType>(dir);
-    entry.record.set_id(container.getId());
-    entry.record.set_priority(container.getPriority());
-    entry.record.set_state(container.getState());
-    entry.record.set_tSec(container.getTimeTag().getSeconds());
-    entry.record.set_tSub(container.getTimeTag().getUSeconds());
-    entry.record.set_size(static_cast<U64>(fileSize));
+    DpStateEntry entry = header.entry;
 
     // check the state file to see if there is transmit state
     this->getFileState(entry);
 
-    // insert entry into sorted list. if can't insert, quit
-    DpBtreeNode* addedEntry = this->insertEntry(entry);
-    if (addedEntry == nullptr) {
+    // insert entry into the index. if can't insert, quit
+    if (not this->insertEntry(entry)) {
         this->log_WARNING_HI_DpInsertError(entry.record);
         // return and hope new slots open up later
         return -1;
@@ -570,20 +1054,11 @@ int DpCatalog::processFile(Fw::String fullFile, FwSizeType dir) {
     }
 
     Fw::FileNameString addedFileName;
-    addedFileName.format(DP_FILENAME_FORMAT, this->m_directories[dir].toChar(), entry.record.get_id(),
+    addedFileName.format(DP_FILENAME_FORMAT, this->m_directories[entry.dir].toChar(), entry.record.get_id(),
                          entry.record.get_tSec(), entry.record.get_tSub());
 
     this->log_ACTIVITY_HI_DpFileAdded(addedFileName);
 
-    // Compute relative priority to current exploration node
-    // For Handling adding a node to a catalog that has
-    // already moved past the inserted node's priority
-    if (this->m_currentNode == nullptr) {
-        this->m_currentNode = addedEntry;
-    } else if (entry < this->m_currentNode->entry) {
-        this->m_currentNode = addedEntry;
-    }
-
     return 1;
 }
 
@@ -639,238 +1114,41 @@ bool DpCatalog::DpStateEntry::operator<(const DpStateEntry& other) const {
     return compareEntries(*this, other) < 0;
 }
 
-DpCatalog::DpBtreeNode* DpCatalog::insertEntry(DpStateEntry& entry) {
-    // the tree is filled in the following priority order:
-    // 1. DP priority - lower number is higher priority
-    // 2. DP time - older is higher priority
-    // 3. DP ID - lower number is higher priority
-
-    // Higher priority is to the left of the tree
-
-    // if the tree is empty, add the first entry
-    if (this->m_dpTree == nullptr) {
-        bool goodInsert = this->allocateNode(this->m_dpTree, entry);
-        if (not goodInsert) {
-            return nullptr;
-        }
-
-        return this->m_dpTree;
-
-        // otherwise, search depth-first to sort the entry
-    } else {
-        // to avoid recursion, loop through a max of the number of available records
-        DpBtreeNode* node = this->m_dpTree;
-        for (FwSizeType record = 0; record < this->m_numDpSlots; record++) {
-            CheckStat stat = CheckStat::CHECK_CONT;
-            stat = this->checkLeftRight(entry < node->entry, node, entry);
-
-            // act on status
-            if (stat == CheckStat::CHECK_ERROR) {
-                return nullptr;
-            } else if (stat == CheckStat::CHECK_OK) {
-                return node;
-            }
-        }  // end for each possible record
-
-        return nullptr;
-    }
+bool DpCatalog::DpIndexEntry::operator==(const DpIndexEntry& other) const {
+    return this->order == other.order;
 }
 
-DpCatalog::CheckStat DpCatalog::checkLeftRight(bool condition, DpBtreeNode*& node, const DpStateEntry& newEntry) {
-    if (condition) {
-        if (node->left == nullptr) {
-            bool allocated = this->allocateNode(node->left, newEntry);
-            if (not allocated) {
-                return CheckStat::CHECK_ERROR;
-            }
-            node->left->parent = node;
-            // Let the caller know where node ended up
-            node = node->left;
-            return CheckStat::CHECK_OK;
-        } else {
-            node = node->left;
-            return CheckStat::CHECK_CONT;
-        }
-    } else {
-        if (node->right == nullptr) {
-            bool allocated = this->allocateNode(node->right, newEntry);
-            if (not allocated) {
-                return CheckStat::CHECK_ERROR;
-            }
-            node->right->parent = node;
-            // Let the caller know where node ended up
-            node = node->right;
-            return CheckStat::CHECK_OK;
-        } else {
-            node = node->right;
-            return CheckStat::CHECK_CONT;
-        }
-    }
+bool DpCatalog::DpIndexEntry::operator<(const DpIndexEntry& other) const {
+    // entries that compare equal are sent in the order they were added
+    const int compare = DpStateEntry::compareEntries(this->entry, other.entry);
+    return (compare < 0) or ((compare == 0) and (this->order < other.order));
 }
 
-bool DpCatalog::allocateNode(DpBtreeNode*& newNode, const DpStateEntry& newEntry) {
-    // should always be null since we are allocating an empty slot
-    FW_ASSERT(newNode == nullptr);
-    // make sure there is an entry from the free list
-    if (this->m_freeListHead == nullptr) {
-        this->log_WARNING_HI_DpCatalogFull(newEntry.record);
+bool DpCatalog::insertEntry(const DpStateEntry& entry) {
+    // the index is kept in the following priority order:
+    // 1. DP priority - lower number is higher priority
+    // 2. DP time - older is higher priority
+    // 3. DP ID - lower number is higher priority
+    if (this->m_dpIndex.getSize() == this->m_dpIndex.getCapacity()) {
+        this->log_WARNING_HI_DpCatalogFull(entry.record);
         return false;
     }
-
-    // get a new node from the free list
-    newNode = this->m_freeListHead;
-    // move the head of the free list to the next node
-    // If we've at the bottom of the free list, head will now be nullptr
-    this->m_freeListHead = this->m_freeListHead->left;
-
-    // initialize the new node
-    newNode->left = nullptr;
-    newNode->right = nullptr;
-    newNode->parent = nullptr;
-    newNode->entry = newEntry;
-
-    // we got one, so return success
+    DpIndexEntry indexEntry;
+    indexEntry.entry = entry;
+    indexEntry.order = this->m_numIndexed++;
+    const Fw::Success status = this->m_dpIndex.insert(indexEntry);
+    FW_ASSERT(status == Fw::Success::SUCCESS, static_cast<FwAssertArgType>(status));
     return true;
 }
 
-void DpCatalog::deallocateNode(DpBtreeNode* node) {
-    DpBtreeNode* parent = node->parent;
-
-    // since nodes are deallocated after xmit, left should be gone
-    // However, left node could be added during xmit
-    if (node->left != nullptr) {
-        // Since we aren't limited to adding just 1 node during file transfer
-        // the left child might not be a leaf
-        // Instead, find the node of closest (but higher) priority to this node
-        // This is the lowest priority node on the left branch
-        // Which is the rightmost node of the left branch
-        DpBtreeNode* rightmostNode = node->left;
-
-        // (i.e. node->left->right->right ... ->right until we hit null)
-
-        // bounded while loop (in case we're linked onto the free list somehow)
-        for (FwSizeType record = 0; record < this->m_numDpSlots && rightmostNode->right != nullptr; record++) {
-            rightmostNode = rightmostNode->right;
-
-            // I really hope these never fire
-            FW_ASSERT(rightmostNode != this->m_freeListHead);
-            FW_ASSERT(rightmostNode != nullptr);
-        }
-
-        FW_ASSERT(rightmostNode != nullptr);
-        FW_ASSERT(rightmostNode->parent != nullptr);
-
-        // We can then swap the node to be deallocated w/ the rightmost
-        // (since it is immediately higher priority than us)
-
-        // Make the "parent" of the deallocated node point at the rightmost
-        if (parent == nullptr) {
-            // this is the root node: has no parent, but needs the root pointer to shift
-            this->m_dpTree = rightmostNode;
-        } else {
-            // patch onto the appropriate parent branch
-            if (parent->left == node) {
-                parent->left = rightmostNode;
-            } else {
-                parent->right = rightmostNode;
-            }
-        }
-
-        // Handle the children of the rightmost node
-        if (rightmostNode == node->left) {
-            // The rightmost node is the immediate left child of the deallocated node
-            // Since it only has left children, shift the left branch up
-            // with node->left taking the place of the deallocated node
-
-            // Nothing we need to do
-            // Just avoid the infinite loop that would occur in this case
-            // on the other branch
-        } else {
-            // If the rightmost node isn't the node to be deallocated's left child,
-            // we can stitch its left branch onto its parent in its place
-            rightmostNode->parent->right = rightmostNode->left;
-
-            // Now connect the deallocated node's left branch onto rightmostNode
-            rightmostNode->left = node->left;
-            node->left->parent = rightmostNode;
-        }
-
-        // Regardless, connect the deallocated node's right branch onto rightmostNode
-        rightmostNode->right = node->right;
-
-        if (node->right != nullptr) {
-            node->right->parent = rightmostNode;
-        }
-
-        // Now that we're done using the parent of rightmost node
-        // Point at actual parent or nullptr if this is the new root
-        rightmostNode->parent = parent;
-
-        // Ensure the Left node no longer points at us
-        FW_ASSERT(node->left->parent != node);
-    } else {
-        // This node only had a right branch
-        // cut out this node and shift the right branch up
-
-        // The root node has no parent, but needs the tree root pointer to shift
-        if (parent == nullptr) {
-            this->m_dpTree = node->right;
-        } else {
-            // Patch the right branch onto
-            // the appropriate parent branch of this node
-            if (parent->left == node) {
-                parent->left = node->right;
-            } else {
-                parent->right = node->right;
-            }
-        }
-
-        // If there is a right branch
-        // Point it at the parent of the removed node
-        if (node->right != nullptr) {
-            FW_ASSERT(node->right->parent != nullptr);
-            node->right->parent = parent;
-        }
-    }
-
-    // clear out the entry
-    node->entry = {};
-    // point this node @ the old head of the free list
-    node->left = m_freeListHead;
-
-    // Ensure the Right node no longer points at us
-    if (node->right != nullptr) {
-        FW_ASSERT(node->right->parent != node);
-    }
-
-    // clear out our right reference
-    node->right = nullptr;
-
-    DpBtreeNode* oldFreeListHead = this->m_freeListHead;
-    // make this node the new head of the free list
-    this->m_freeListHead = node;
-
-    // Node is the head of the free list
-    FW_ASSERT(this->m_freeListHead == node);
-
-    node->parent = nullptr;
-
-    // Ensure this Node only points at next in free list
-    FW_ASSERT(node->left == oldFreeListHead);
-    FW_ASSERT(node->right == nullptr);
-    FW_ASSERT(node->parent == nullptr);
-}
-
 void DpCatalog::sendNextEntry() {
     // Use xmit flag to break upon STOP_XMIT_CATALOG
     if (this->m_xmitInProgress != true) {
         return;
     }
 
-    // look in the tree for the next entry to send
-    this->m_currentXmitNode = this->findNextTreeNode();
-
-    if (this->m_currentXmitNode == nullptr) {
+    // take the next entry to send from the index
+    if (not this->findNextEntry(this->m_currentXmitEntry)) {
         // if no entry found, we are done
         this->m_xmitInProgress = false;
         this->log_ACTIVITY_HI_CatalogXmitCompleted(this->m_xmitBytes);
@@ -879,12 +1157,12 @@ void DpCatalog::sendNextEntry() {
     } else {
         // build file name based on the found entry
         this->m_currXmitFileName.format(
-            DP_FILENAME_FORMAT, this->m_directories[this->m_currentXmitNode->entry.dir].toChar(),
-            this->m_currentXmitNode->entry.record.get_id(), this->m_currentXmitNode->entry.record.get_tSec(),
-            this->m_currentXmitNode->entry.record.get_tSub());
+            DP_FILENAME_FORMAT, this->m_directories[this->m_currentXmitEntry.dir].toChar(),
+            this->m_currentXmitEntry.record.get_id(), this->m_currentXmitEntry.record.get_tSec(),
+            this->m_currentXmitEntry.record.get_tSub());
         this->log_ACTIVITY_LO_SendingProduct(this->m_currXmitFileName,
-                                             static_cast<U32>(this->m_currentXmitNode->entry.record.get_size()),
-                                             this->m_currentXmitNode->entry.record.get_priority());
+                                             static_cast<U32>(this->m_currentXmitEntry.record.get_size()),
+                                             this->m_currentXmitEntry.record.get_priority());
         Svc::SendFileResponse resp = this->fileOut_out(0, this->m_currXmitFileName, this->m_currXmitFileName, 0, 0);
         if (resp.get_status() != Svc::SendFileStatus::STATUS_OK) {
             // warn, but keep going since it may be an issue with this file but others could
@@ -895,44 +1173,24 @@ void DpCatalog::sendNextEntry() {
 
 }  // end sendNextEntry()
 
-DpCatalog::DpBtreeNode* DpCatalog::findNextTreeNode() {
+bool DpCatalog::findNextEntry(DpStateEntry& entry) {
     // check some asserts
     FW_ASSERT(this->m_xmitInProgress);
 
-    if (this->m_dpTree == nullptr) {
+    DpIndex::ConstIterator next = this->m_dpIndex.begin();
+    if (not next.isInRange()) {
         // We've run out of entries, we are done
         this->m_xmitInProgress = false;
-        return nullptr;
-    }
-
-    // start back at the top
-    if (this->m_currentNode == nullptr) {
-        this->m_currentNode = this->m_dpTree;
-    }
-
-    // Nav left until nullptr
-    // Leads to highest priority node
-    // bounded while loop (in case we're linked onto the free list somehow)
-    for (FwSizeType record = 0; record < this->m_numDpSlots && this->m_currentNode->left != nullptr; record++) {
-        this->m_currentNode = this->m_currentNode->left;
-
-        // I really hope these never fire
-        FW_ASSERT(this->m_currentNode != this->m_freeListHead);
-        FW_ASSERT(this->m_currentNode != nullptr);
-    }
-
-    // save the high prio & find next best
-    DpBtreeNode* found = this->m_currentNode;
-
-    // On the next cycle, explore the node to the right, if available,
-    // otherwise the node above
-    if (this->m_currentNode->right != nullptr) {
-        this->m_currentNode = this->m_currentNode->right;
-    } else {
-        this->m_currentNode = this->m_currentNode->parent;
+        return false;
     }
 
-    return found;
+    // The first entry is the highest priority. It leaves the index as it is sent,
+    // so entries added while it is in flight are ordered against the rest
+    const DpIndexEntry found = *next;
+    const Fw::Success status = this->m_dpIndex.remove(found);
+    FW_ASSERT(status == Fw::Success::SUCCESS, static_cast<FwAssertArgType>(status));
+    entry = found.entry;
+    return true;
 }
 
 bool DpCatalog::checkInit() {
@@ -947,7 +1205,18 @@ bool DpCatalog::checkInit() {
     return true;
 }
 
+void DpCatalog::startScanTasks(const FwTaskPriorityType priority,
+                               const Os::Task::ParamType stackSize,
+                               const Os::Task::ParamType cpuAffinity) {
+    this->m_scanPool.start(priority, stackSize, cpuAffinity);
+}
+
+void DpCatalog::stopScanTasks() {
+    this->m_scanPool.stop();
+}
+
 void DpCatalog::shutdown() {
+    this->stopScanTasks();
     // only try to deallocate if both pointers are non-zero
     // it's a way to more gracefully shut down if there are missing
     // pointers
@@ -973,24 +1242,20 @@ void DpCatalog ::fileDone_handler(FwIndexType portNum, const Svc::SendFileRespon
         return;
     }
 
-    // Since catalog built flag is true
-    // we should have a tree w/ at least one element
-    FW_ASSERT(this->m_dpTree);
-
     // Reduce pending
-    this->m_pendingDpBytes -= this->m_currentXmitNode->entry.record.get_size();
+    this->m_pendingDpBytes -= this->m_currentXmitEntry.record.get_size();
     this->m_pendingFiles--;
     // Log File Complete & pending
     this->log_ACTIVITY_LO_ProductComplete(this->m_currXmitFileName, this->m_pendingFiles, this->m_pendingDpBytes);
 
     // mark the entry as transmitted
-    this->m_currentXmitNode->entry.record.set_state(Fw::DpState::TRANSMITTED);
+    this->m_currentXmitEntry.record.set_state(Fw::DpState::TRANSMITTED);
     // update the transmitted state in the state file
-    this->appendFileState(this->m_currentXmitNode->entry);
+    this->appendFileState(this->m_currentXmitEntry);
+    // and in the index file
+    this->appendIndexRecord(this->m_currentXmitEntry);
     // add the size
-    this->m_xmitBytes += this->m_currentXmitNode->entry.record.get_size();
-    // deallocate this node
-    this->deallocateNode(this->m_currentXmitNode);
+    this->m_xmitBytes += this->m_currentXmitEntry.record.get_size();
     // send the next entry, if it exists
     this->sendNextEntry();
 }
@@ -1015,16 +1280,25 @@ void DpCatalog ::addToCat_handler(FwIndexType portNum,
         return;
     }
 
+    // Both of these are grabbed from the header
+    (void)priority;
+    (void)size;
+
     // Check the catalog has been built
     if (not this->m_catalogBuilt) {
         this->log_ACTIVITY_HI_NotLoaded(fileName);
+        // record the file in the index file, so a build that loads it includes the file
+        FwSizeType dir = this->determineDirectory(fileName);
+        if ((this->m_indexFile.length() > 0) and (dir != DP_MAX_DIRECTORIES)) {
+            DpHeaderRead header;
+            DpCatalog::readHeader(fileName, dir, header);
+            if (header.status == HEADER_OK) {
+                this->appendIndexRecord(header.entry);
+            }
+        }
         return;
     }
 
-    // Both of these are grabbed from the header
-    (void)priority;
-    (void)size;
-
     // Since this is a runtime addition
     // Check if file is in one of our directories
     FwSizeType dir = this->determineDirectory(fileName);
@@ -1035,13 +1309,17 @@ void DpCatalog ::addToCat_handler(FwIndexType portNum,
         return;
     }
 
+    DpHeaderRead header;
+    DpCatalog::readHeader(fileName, dir, header);
     // ret > 0 := success
-    int ret = processFile(fileName, dir);
+    int ret = this->catalogHeader(fileName, header);
 
     if (ret > 0) {
+        // record the entry in the index file
+        this->appendIndexRecord(header.entry);
+
         // If we already finished, sendNext only if remainingActive
         if (!this->m_xmitInProgress && this->m_remainActive) {
-            this->m_currentNode = this->m_dpTree;
             this->m_xmitInProgress = true;
             this->sendNextEntry();
         }
@@ -1134,8 +1412,10 @@ void DpCatalog ::STOP_XMIT_CATALOG_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
 }
 
 void DpCatalog ::CLEAR_CATALOG_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
-    this->resetBinaryTree();
+    this->resetIndex();
     this->resetStateFileData();
+    // the next build scans the directories
+    this->invalidateIndexFile();
 
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
 }
@@ -10,7 +10,11 @@
 #include "Svc/DpCatalog/DpCatalogComponentAc.hpp"
 #include "Svc/DpCatalog/DpRecordSerializableAc.hpp"
 
+#include <Fw/DataStructures/ExternalRedBlackTreeSet.hpp>
 #include <Fw/Types/MemAllocator.hpp>
+#include <Os/Condition.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
 
 #include <Fw/Types/FileNameString.hpp>
 #include <config/DpCatalogCfg.hpp>
@@ -44,11 +48,26 @@ class DpCatalog final : public DpCatalogComponentBase {
     /// @param memId  memory ID for allocator
     /// @param allocator Allocator to supply memory for catalog.
     ///        Instance must survive for shutdown to use for reclaiming memory
+    /// @param indexFile file to store the catalog entries, so a build can load them instead of scanning the
+    ///        directories. Provide a zero-length string to scan the directories on every build
     void configure(Fw::FileNameString directories[DP_MAX_DIRECTORIES],
                    FwSizeType numDirs,
                    Fw::FileNameString& stateFile,
                    FwEnumStoreType memId,
-                   Fw::MemAllocator& allocator);
+                   Fw::MemAllocator& allocator,
+                   const Fw::FileNameString& indexFile = Fw::FileNameString());
+
+    /// @brief Start tasks that read data product headers in parallel during catalog builds.
+    /// Without them, headers are read on the component thread.
+    /// @param priority priority of the tasks
+    /// @param stackSize stack size of the tasks
+    /// @param cpuAffinity CPU affinity of the tasks
+    void startScanTasks(const FwTaskPriorityType priority = Os::Task::TASK_PRIORITY_DEFAULT,
+                        const Os::Task::ParamType stackSize = Os::Task::TASK_DEFAULT,
+                        const Os::Task::ParamType cpuAffinity = Os::Task::TASK_DEFAULT);
+
+    /// @brief Stop the header scan tasks and wait for them to exit. Also done by shutdown().
+    void stopScanTasks();
 
     // @brief clean up component.
     // Deallocates memory.
@@ -142,15 +161,93 @@ class DpCatalog final : public DpCatalogComponentBase {
         bool used;     //!< if the entry is used
         bool visited;  //!< used for state file state; indicates that the entry was found in the search of current data
                        //!< products
+        FwSizeType line;     //!< position of the entry in the state file
         DpStateEntry entry;  //!< state entry from file
+
+        /// @brief compare the location and metadata of two entries
+        /// @param left an entry to compare
+        /// @param right other entry to compare
+        /// @return -1 if left sorts first, 0 if they are the same product, and 1 if right sorts first
+        static int compareProducts(const DpStateEntry& left, const DpStateEntry& right);
+
+        /// @brief order entries by product, then by their position in the state file
+        bool operator<(const DpDstateFileEntry& other) const;
+    };
+
+    /// @brief An entry in the downlink index. Entries are kept in priority order, with entries of
+    /// equal priority, time, and ID kept in the order they were added
+    struct DpIndexEntry {
+        DpStateEntry entry;  //!< catalog entry
+        FwSizeType order;    //!< order in which the entry was added
+
+        bool operator==(const DpIndexEntry& other) const;
+        bool operator<(const DpIndexEntry& other) const;
+    };
+
+    /// @brief The downlink index, a red-black tree in the catalog memory
+    using DpIndex = Fw::ExternalRedBlackTreeSet<DpIndexEntry>;
+
+    /// @brief outcome of reading a data product file header
+    enum HeaderStatus {
+        HEADER_OK,           //!< header read; the entry holds its metadata
+        HEADER_SIZE_ERROR,   //!< couldn't get the file size
+        HEADER_OPEN_ERROR,   //!< couldn't open the file
+        HEADER_READ_ERROR,   //!< couldn't read a full header
+        HEADER_DES_ERROR,    //!< couldn't deserialize the header
+        HEADER_TRANSMITTED,  //!< the header says the product was already transmitted
     };
 
-    /// @brief A list sorted in priority order for downlink
-    struct DpBtreeNode {
-        DpStateEntry entry;   //!< pointer to DP record
-        DpBtreeNode* left;    //!< left child. Also used for free list
-        DpBtreeNode* right;   //!< right child
-        DpBtreeNode* parent;  //!< parent node
+    /// @brief result of reading a data product file header
+    struct DpHeaderRead {
+        HeaderStatus status;  //!< outcome of the read
+        I32 stat;             //!< status of the failed operation
+        DpStateEntry entry;   //!< entry built from the header
+    };
+
+    /// @brief A pool of tasks that read the headers of a directory's data product files in parallel
+    class ScanPool {
+      public:
+        /// @brief construct a stopped pool
+        ScanPool();
+
+        /// @brief start the tasks
+        void start(const FwTaskPriorityType priority,
+                   const Os::Task::ParamType stackSize,
+                   const Os::Task::ParamType cpuAffinity);
+
+        /// @brief stop the tasks and wait for them to exit
+        void stop();
+
+        /// @brief check whether the tasks are running
+        bool isRunning() const { return this->m_running; }
+
+        /// @brief read the headers of a set of files, waiting until all have been read
+        /// @param files full paths of the files
+        /// @param dir directory index in m_directories of the files
+        /// @param headers results of the reads, one for each file
+        /// @param count number of files
+        void scan(const Fw::String* files, FwSizeType dir, DpHeaderRead* headers, FwSizeType count);
+
+      private:
+        /// @brief the task entry point
+        static void taskEntry(void* ptr);
+
+        /// @brief read headers until stopped
+        void run();
+
+        Os::Task m_tasks[DP_SCAN_TASKS];  //!< the tasks
+        Os::Mutex m_mutex;                //!< protects the scan state
+        Os::ConditionVariable m_queued;   //!< signaled when files are queued or the tasks are stopped
+        Os::ConditionVariable m_done;     //!< signaled when the last header of a scan has been read
+
+        const Fw::String* m_files;  //!< files of the current scan
+        DpHeaderRead* m_headers;    //!< results of the current scan
+        FwSizeType m_dir;           //!< directory index of the current scan
+        FwSizeType m_count;         //!< number of files in the current scan
+        FwSizeType m_next;          //!< next file to be claimed by a task
+        FwSizeType m_read;          //!< number of headers read
+        bool m_running;             //!< whether the tasks are running
+        bool m_quit;                //!< whether the tasks have been asked to stop
     };
 
     // ----------------------------------
@@ -168,30 +265,41 @@ class DpCatalog final : public DpCatalogComponentBase {
     /// @return -1 for quit, 0 for failure but continue, 1 for success
     int processFile(Fw::String fullFile, FwSizeType dir);
 
-    /// @brief insert an entry into the sorted list; if it exists, update the metadata
-    /// @param entry new entry
-    /// @return failed if couldn't find a slot
-    DpCatalog::DpBtreeNode* insertEntry(DpStateEntry& entry);
-
-    /// @brief enumeration for check and insert function
-    enum CheckStat {
-        CHECK_OK,     //!< check passed and inserted. Can break loop
-        CHECK_CONT,   //!< check passed and find another node to check
-        CHECK_ERROR,  //!< check failed to allocate an entry. Quit function
-    };
+    /// @brief read the header of a data product file. Touches no component state, so it can run on any task.
+    /// @param fullFile full path to file to be read
+    /// @param dir directory index in m_directories
+    /// @param header result of the read
+    static void readHeader(const Fw::StringBase& fullFile, FwSizeType dir, DpHeaderRead& header);
 
-    /// @brief check for left/right insertion
-    CheckStat checkLeftRight(bool condition, DpBtreeNode*& node, const DpStateEntry& newEntry);
+    /// @brief add a file to the catalog from the result of reading its header
+    /// @param fullFile full path to the file
+    /// @param header result of reading the file header
+    /// @return -1 for quit, 0 for failure but continue, 1 for success
+    int catalogHeader(const Fw::StringBase& fullFile, const DpHeaderRead& header);
 
-    /// @brief reset the free list
-    void resetBinaryTree();
+    /// @brief insert an entry into the downlink index
+    /// @param entry new entry
+    /// @return false if the index is full
+    bool insertEntry(const DpStateEntry& entry);
 
-    /// #brief fill  the binary tree from DP files
-    Fw::CmdResponse fillBinaryTree();
+    /// @brief clear the downlink index
+    void resetIndex();
+
+    /// @brief fill the downlink index from DP files
+    /// @param complete set to false when the scan stopped before every DP file was cataloged
+    Fw::CmdResponse fillIndex(bool& complete);
 
     /// @brief reset the state file data
     void resetStateFileData();
 
+    /// @brief sort the state file data by product for lookup by getFileState
+    void sortStateFileData();
+
+    /// @brief restore the sort order of the state file data below a heap node
+    /// @param root index of the heap node
+    /// @param count number of entries in the heap
+    void siftStateFileData(FwSizeType root, FwSizeType count);
+
     /// @brief get file state from the stored state file
     /// @param entry entry to update from file state
     void getFileState(DpStateEntry& entry);
@@ -206,23 +314,47 @@ class DpCatalog final : public DpCatalogComponentBase {
     /// @param entry entry to add to state file
     void appendFileState(const DpStateEntry& entry);
 
-    /// @brief add an entry to the tree
-    /// @param newNode pointer to newly allocated node
-    /// @param newEntry entry to add
-    /// @return true if a node could be allocated
-    bool allocateNode(DpBtreeNode*& newNode, const DpStateEntry& newEntry);
+    /// @brief serialize the header of the index file
+    /// @param buffer buffer to hold the header
+    static void serializeIndexHeader(Fw::LinearBufferBase& buffer);
 
-    /// @brief free an entry from the tree
-    /// @param node entry to deallocate
-    void deallocateNode(DpBtreeNode* node);
+    /// @brief serialize an index file record, followed by its checksum
+    /// @param entry entry to serialize
+    /// @param buffer buffer to hold the record
+    static void serializeIndexRecord(const DpStateEntry& entry, Fw::LinearBufferBase& buffer);
+
+    /// @brief deserialize an index file record and verify its checksum
+    /// @param record serialized record of DP_INDEX_RECORD_SIZE bytes
+    /// @param entry deserialized entry
+    /// @return false if the record is corrupt
+    bool deserializeIndexRecord(const U8* record, DpStateEntry& entry);
+
+    /// @brief fill the downlink index from the index file
+    /// @return true if the index file was valid and was loaded
+    bool loadIndexFile();
+
+    /// @brief check the header of an index file that has not been loaded and count its records
+    /// @return true if records can be appended to the index file
+    bool checkIndexFile();
+
+    /// @brief rewrite the index file with the entries waiting to be transmitted
+    /// @return true if the index file was written
+    bool writeIndexFile();
+
+    /// @brief append the state of an entry to the index file
+    /// @param entry entry to append
+    void appendIndexRecord(const DpStateEntry& entry);
+
+    /// @brief remove the index file, so the next build scans the directories
+    void invalidateIndexFile();
 
     /// @brief send the next entry to file downlink
     void sendNextEntry();
 
-    /// @brief find the next entry in the tree
-    /// @return pointer if an entry was found, nullptr if no more entries
-    /// @param entry entry to return
-    DpBtreeNode* findNextTreeNode();
+    /// @brief remove the highest priority entry from the downlink index
+    /// @param entry the removed entry
+    /// @return false if there are no more entries
+    bool findNextEntry(DpStateEntry& entry);
 
     /// @brief check to see if component successfully initialized
     /// @return bool if it was initialized
@@ -245,21 +377,26 @@ class DpCatalog final : public DpCatalogComponentBase {
     // ----------------------------------
     bool m_initialized;  //!< set when the component has been initialized
 
-    DpBtreeNode* m_dpTree;           //!< The head of the binary tree
-    DpBtreeNode* m_freeListHead;     //!< The head of the free list
-    DpBtreeNode* m_currentNode;      //!< current node for traversing tree
-    DpBtreeNode* m_currentXmitNode;  //!< node being currently transmitted
+    DpIndex m_dpIndex;                //!< entries waiting to be transmitted, in priority order
+    FwSizeType m_numIndexed;          //!< number of entries added to the index since it was reset
+    DpStateEntry m_currentXmitEntry;  //!< entry being currently transmitted
 
     FwSizeType m_numDpSlots;  //!< Stores the available number of record slots.
 
     Fw::FileNameString m_directories[DP_MAX_DIRECTORIES];  //!< List of supplied DP directories
     FwSizeType m_numDirectories;                           //!< number of supplied directories
     Fw::String m_fileList[DP_MAX_FILES];                   //!< working array of files/directory
+    DpHeaderRead m_headerReads[DP_MAX_FILES];              //!< headers read from the working array of files
+    ScanPool m_scanPool;                                   //!< tasks reading headers during catalog builds
 
     Fw::FileNameString m_stateFile;      //!< file to store transmit state
     DpDstateFileEntry* m_stateFileData;  //!< DP state loaded from file
     FwSizeType m_stateFileEntries;       //!< size of state file data
 
+    Fw::FileNameString m_indexFile;  //!< file to store the catalog entries
+    FwSizeType m_indexRecords;       //!< number of records in the index file
+    bool m_indexValid;               //!< set when the index file is known to be valid and can be appended to
+
     FwSizeType m_memSize;           //!< size of allocated buffer
     void* m_memPtr;                 //!< stored for shutdown
     FwEnumStoreType m_allocatorId;  //!< stored for shutdown
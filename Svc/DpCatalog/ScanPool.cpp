@@ -0,0 +1,103 @@
+// ======================================================================
+// \title  ScanPool.cpp
+// \brief  cpp file for DpCatalog::ScanPool
+// ======================================================================
+
+#include <Fw/Types/Assert.hpp>
+#include <Os/TaskString.hpp>
+#include <Svc/DpCatalog/DpCatalog.hpp>
+
+namespace Svc {
+
+static_assert(DP_SCAN_TASKS > 0, "Configuration DP_SCAN_TASKS must be positive");
+
+DpCatalog::ScanPool::ScanPool()
+    : m_files(nullptr),
+      m_headers(nullptr),
+      m_dir(0),
+      m_count(0),
+      m_next(0),
+      m_read(0),
+      m_running(false),
+      m_quit(false) {}
+
+void DpCatalog::ScanPool::start(const FwTaskPriorityType priority,
+                                const Os::Task::ParamType stackSize,
+                                const Os::Task::ParamType cpuAffinity) {
+    FW_ASSERT(not this->m_running);
+    this->m_quit = false;
+    for (FwIndexType task = 0; task < DP_SCAN_TASKS; task++) {
+        Os::TaskString name;
+        name.format("DpScan%" PRI_FwIndexType, task);
+        Os::Task::Arguments arguments(name, taskEntry, this, priority, stackSize, cpuAffinity);
+        const Os::Task::Status status = this->m_tasks[task].start(arguments);
+        FW_ASSERT(status == Os::Task::OP_OK, status);
+    }
+    this->m_running = true;
+}
+
+void DpCatalog::ScanPool::stop() {
+    if (not this->m_running) {
+        return;
+    }
+    this->m_mutex.lock();
+    this->m_quit = true;
+    this->m_queued.notifyAll();
+    this->m_mutex.unLock();
+    for (FwIndexType task = 0; task < DP_SCAN_TASKS; task++) {
+        (void)this->m_tasks[task].join();
+    }
+    this->m_running = false;
+}
+
+void DpCatalog::ScanPool::scan(const Fw::String* files,
+                               const FwSizeType dir,
+                               DpHeaderRead* headers,
+                               const FwSizeType count) {
+    FW_ASSERT(this->m_running);
+    FW_ASSERT(files != nullptr);
+    FW_ASSERT(headers != nullptr);
+    Os::ScopeLock lock(this->m_mutex);
+    this->m_files = files;
+    this->m_headers = headers;
+    this->m_dir = dir;
+    this->m_count = count;
+    this->m_next = 0;
+    this->m_read = 0;
+    this->m_queued.notifyAll();
+    while (this->m_read < this->m_count) {
+        this->m_done.wait(this->m_mutex);
+    }
+}
+
+void DpCatalog::ScanPool::taskEntry(void* ptr) {
+    FW_ASSERT(ptr != nullptr);
+    static_cast<ScanPool*>(ptr)->run();
+}
+
+void DpCatalog::ScanPool::run() {
+    this->m_mutex.lock();
+    while (true) {
+        while ((this->m_next == this->m_count) && not this->m_quit) {
+            this->m_queued.wait(this->m_mutex);
+        }
+        if (this->m_quit) {
+            break;
+        }
+        // Each file and its result belong to the task that claimed it, so they are used unlocked
+        const FwSizeType file = this->m_next;
+        ++this->m_next;
+        this->m_mutex.unLock();
+
+        DpCatalog::readHeader(this->m_files[file], this->m_dir, this->m_headers[file]);
+
+        this->m_mutex.lock();
+        ++this->m_read;
+        if (this->m_read == this->m_count) {
+            this->m_done.notify();
+        }
+    }
+    this->m_mutex.unLock();
+}
+
+}  // namespace Svc
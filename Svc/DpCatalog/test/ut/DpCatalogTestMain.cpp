@@ -274,6 +274,11 @@ TEST(NominalManual, RandomDp) {
     tester.test_RandomDp();
 }
 
+TEST(NominalManual, RandomDpScanTasks) {
+    Svc::DpCatalogTester tester;
+    tester.test_RandomDp(true);
+}
+
 TEST(NominalManual, XmitBeforeInit) {
     Svc::DpCatalogTester tester;
     tester.test_XmitBeforeInit();
@@ -299,6 +304,40 @@ TEST(NominalManual, BadFileDone) {
     tester.test_BadFileDone();
 }
 
+TEST(NominalManual, IndexBuild) {
+    Svc::DpCatalogTester tester;
+    tester.test_IndexBuild(1000);
+}
+
+// Timing benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(NominalManual, DISABLED_IndexBuildBenchmark) {
+    Svc::DpCatalogTester tester;
+    tester.test_IndexBuild(100000, true);
+}
+
+TEST(NominalManual, StateFileLookup) {
+    Svc::DpCatalogTester tester;
+    tester.test_StateFileLookup();
+}
+
+TEST(NominalManual, IndexFile) {
+    // build a catalog that writes the index file
+    {
+        Svc::DpCatalogTester tester;
+        tester.test_IndexFileBuild();
+    }
+    // restart and load the catalog from it
+    {
+        Svc::DpCatalogTester tester;
+        tester.test_IndexFileLoad();
+    }
+}
+
+TEST(NominalManual, IndexFileTruncated) {
+    Svc::DpCatalogTester tester;
+    tester.test_IndexFileTruncated();
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -6,7 +6,10 @@
 
 #include "DpCatalogTester.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <vector>
 #include "Fw/Dp/DpContainer.hpp"
 #include "Fw/Test/UnitTest.hpp"
 #include "Fw/Types/FileNameString.hpp"
@@ -63,8 +66,8 @@ void DpCatalogTester::testTree(DpCatalog::DpStateEntry* input,
     Fw::FileNameString stateFile("./DpTest/dpState.dat");
     this->component.configure(dirs, FW_NUM_ARRAY_ELEMENTS(dirs), stateFile, 100, alloc);
 
-    // reset tree
-    this->component.resetBinaryTree();
+    // reset index
+    this->component.resetIndex();
 
     // add entries
     for (FwIndexType entry = 0; entry < numEntries; entry++) {
@@ -75,21 +78,18 @@ void DpCatalogTester::testTree(DpCatalog::DpStateEntry* input,
     this->component.m_xmitInProgress = true;
 
     // retrieve entries - they should match expected output
+    DpCatalog::DpStateEntry res;
     for (FwIndexType entry = 0; entry < numEntries + 1; entry++) {
         if (entry == numEntries) {
             // final request should indicate empty
-            ASSERT_TRUE(this->component.findNextTreeNode() == nullptr);
+            ASSERT_FALSE(this->component.findNextEntry(res));
         } else if (output[entry].record.get_state() != Fw::DpState::TRANSMITTED) {
             // Outputs is only composed of the UNTRANSMITTED data products
-            DpCatalog::DpBtreeNode* res = this->component.findNextTreeNode();
-            ASSERT_TRUE(res != nullptr) << "nullptr findNextTreeNode() at " << entry << " out of " << numEntries;
+            ASSERT_TRUE(this->component.findNextEntry(res))
+                << "no entry from findNextEntry() at " << entry << " out of " << numEntries;
 
             //  should match expected entry
-            if (res != nullptr) {
-                ASSERT_EQ(res->entry.record, output[entry].record) << "entry mismatch at " << entry;
-            }
-            // Deallocate the "sent" node
-            this->component.deallocateNode(res);
+            ASSERT_EQ(res.record, output[entry].record) << "entry mismatch at " << entry;
         }
     }
 
@@ -313,8 +313,8 @@ void DpCatalogTester::textLogIn(FwEventIdType id,                //!< The event
 Svc::SendFileResponse DpCatalogTester ::from_fileOut_handler(FwIndexType portNum,
                                                              const Fw::StringBase& sourceFileName,
                                                              const Fw::StringBase& destFileName,
-                                                             U32 offset,
-                                                             U32 length) {
+                                                             FwFileOffsetType offset,
+                                                             FwFileOffsetType length) {
     // Tell the DpCatalog that the xmit succeeded
     this->pushFromPortEntry_fileOut(sourceFileName, destFileName, offset, length);
     this->invoke_to_fileDone(0, Svc::SendFileResponse());
@@ -613,7 +613,7 @@ void DpCatalogTester ::test_TreeTestRandomPrioIdTime() {
     }
 }
 
-void DpCatalogTester ::test_RandomDp() {
+void DpCatalogTester ::test_RandomDp(bool scanTasks) {
     static constexpr FwIndexType NUM_ENTRIES = DP_MAX_FILES;
     static constexpr FwIndexType NUM_ITERS = 100;
     static constexpr FwIndexType NUM_DIRS = DP_MAX_DIRECTORIES;
@@ -658,6 +658,10 @@ void DpCatalogTester ::test_RandomDp() {
 
         Fw::Wait wait = static_cast<Fw::Wait::T>(STest::Pick::lowerUpper(0, 1));
 
+        // readDps shuts the component down, which stops the tasks
+        if (scanTasks) {
+            this->component.startScanTasks();
+        }
         this->readDps(dirs, NUM_DIRS, stateFile, dpSet, entries, runtimeEntries, 0, wait);
     }
 }
@@ -743,4 +747,262 @@ void DpCatalogTester ::test_BadFileDone() {
     this->component.shutdown();
 }
 
+void DpCatalogTester ::test_IndexBuild(FwSizeType numEntries, bool report) {
+    // Data products arrive in time order, the worst case for an unbalanced tree
+    static const FwDpPriorityType NUM_PRIORITIES = 10;
+
+    std::vector<DpCatalog::DpIndex::Node> nodes(numEntries);
+    std::vector<DpCatalog::DpIndex::Index> freeNodes(numEntries);
+    this->component.m_dpIndex.setStorage(nodes.data(), freeNodes.data(), numEntries);
+
+    const auto start = std::chrono::steady_clock::now();
+    DpCatalog::DpStateEntry entry;
+    for (FwSizeType file = 0; file < numEntries; file++) {
+        entry.record.set_id(static_cast<FwDpIdType>(file));
+        entry.record.set_priority(static_cast<FwDpPriorityType>(file % NUM_PRIORITIES));
+        entry.record.set_tSec(static_cast<U32>(file));
+        entry.record.set_tSub(0);
+        entry.record.set_size(100);
+        ASSERT_TRUE(this->component.insertEntry(entry));
+    }
+    const auto built = std::chrono::steady_clock::now();
+
+    // entries should come out in priority order, then in time order
+    this->component.m_xmitInProgress = true;
+    DpCatalog::DpStateEntry previous;
+    ASSERT_TRUE(this->component.findNextEntry(previous));
+    for (FwSizeType file = 1; file < numEntries; file++) {
+        ASSERT_TRUE(this->component.findNextEntry(entry));
+        ASSERT_TRUE(previous < entry) << "entry out of order at " << file;
+        previous = entry;
+    }
+    ASSERT_FALSE(this->component.findNextEntry(entry));
+    const auto drained = std::chrono::steady_clock::now();
+
+    if (report) {
+        const std::chrono::duration<F64> buildTime = built - start;
+        const std::chrono::duration<F64> drainTime = drained - built;
+        (void)printf("%u synthetic data products: index built in %.3f s, drained in %.3f s\n",
+                     static_cast<unsigned int>(numEntries), buildTime.count(), drainTime.count());
+    }
+}
+
+void DpCatalogTester ::test_StateFileLookup() {
+    static const FwSizeType NUM_LINES = 100;
+
+    Fw::MallocAllocator alloc;
+    Fw::FileNameString dirs[2];
+    dirs[0] = "dir0";
+    dirs[1] = "dir1";
+    Fw::FileNameString stateFile("");
+    this->component.configure(dirs, FW_NUM_ARRAY_ELEMENTS(dirs), stateFile, 100, alloc);
+    ASSERT_GE(this->component.m_numDpSlots, NUM_LINES);
+    this->component.resetStateFileData();
+
+    // load lines in random order, in both directories, with some products listed twice
+    for (FwSizeType line = 0; line < NUM_LINES; line++) {
+        DpCatalog::DpDstateFileEntry& fileEntry = this->component.m_stateFileData[line];
+        fileEntry.used = true;
+        fileEntry.visited = false;
+        fileEntry.line = line;
+        fileEntry.entry.dir = static_cast<FwIndexType>(STest::Pick::lowerUpper(0, 1));
+        fileEntry.entry.record.set_id(STest::Pick::lowerUpper(0, 9));
+        fileEntry.entry.record.set_priority(STest::Pick::lowerUpper(0, 2));
+        fileEntry.entry.record.set_tSec(STest::Pick::lowerUpper(0, 2));
+        fileEntry.entry.record.set_state(Fw::DpState::TRANSMITTED);
+        fileEntry.entry.record.set_blocks(static_cast<U32>(line));
+    }
+    this->component.m_stateFileEntries = NUM_LINES;
+    DpCatalog::DpDstateFileEntry lines[NUM_LINES];
+    for (FwSizeType line = 0; line < NUM_LINES; line++) {
+        lines[line] = this->component.m_stateFileData[line];
+    }
+
+    this->component.sortStateFileData();
+
+    // each product should take its state from the first line that lists it
+    for (FwSizeType line = 0; line < NUM_LINES; line++) {
+        FwSizeType first = 0;
+        while (DpCatalog::DpDstateFileEntry::compareProducts(lines[first].entry, lines[line].entry) != 0) {
+            first++;
+        }
+        DpCatalog::DpStateEntry entry;
+        entry.dir = lines[line].entry.dir;
+        entry.record = lines[line].entry.record;
+        entry.record.set_state(Fw::DpState::UNTRANSMITTED);
+        entry.record.set_blocks(0);
+        this->component.getFileState(entry);
+        ASSERT_EQ(entry.record.get_state(), Fw::DpState::TRANSMITTED);
+        ASSERT_EQ(entry.record.get_blocks(), first);
+    }
+
+    // only the first line for each product is marked for keeping
+    for (FwSizeType line = 0; line < NUM_LINES; line++) {
+        const DpCatalog::DpDstateFileEntry& fileEntry = this->component.m_stateFileData[line];
+        const bool first = (line == 0) or (DpCatalog::DpDstateFileEntry::compareProducts(
+                                               this->component.m_stateFileData[line - 1].entry, fileEntry.entry) != 0);
+        ASSERT_EQ(fileEntry.visited, first) << "line " << fileEntry.line;
+    }
+
+    // a product that isn't in the state file is unchanged
+    DpCatalog::DpStateEntry missing;
+    missing.dir = 0;
+    missing.record.set_id(100);
+    missing.record.set_state(Fw::DpState::UNTRANSMITTED);
+    this->component.getFileState(missing);
+    ASSERT_EQ(missing.record.get_state(), Fw::DpState::UNTRANSMITTED);
+
+    this->component.shutdown();
+}
+
+namespace {
+// products and files shared by the index file tests
+const char* const INDEX_TEST_DIR = "./DpIndex";
+const char* const INDEX_TEST_STATE_FILE = "./DpIndex/dpState.dat";
+const char* const INDEX_TEST_INDEX_FILE = "./DpIndex/dpIndex.dat";
+const FwSizeType INDEX_TEST_DPS = 10;
+const FwSizeType INDEX_TEST_SENT = 4;
+}  // namespace
+
+void DpCatalogTester ::test_IndexFileBuild() {
+    this->makeDpDir(INDEX_TEST_DIR);
+    (void)Os::FileSystem::removeFile(INDEX_TEST_STATE_FILE);
+    (void)Os::FileSystem::removeFile(INDEX_TEST_INDEX_FILE);
+    for (FwSizeType dp = 0; dp < INDEX_TEST_DPS; dp++) {
+        this->genDP(static_cast<FwDpIdType>(dp), static_cast<FwDpPriorityType>(dp % 3),
+                    Fw::Time(1000 + static_cast<U32>(dp), 0), 100, Fw::DpState::UNTRANSMITTED, false, INDEX_TEST_DIR);
+    }
+
+    Fw::MallocAllocator alloc;
+    Fw::FileNameString dirs[1];
+    dirs[0] = INDEX_TEST_DIR;
+    Fw::FileNameString stateFile(INDEX_TEST_STATE_FILE);
+    Fw::FileNameString indexFile(INDEX_TEST_INDEX_FILE);
+    this->component.configure(dirs, FW_NUM_ARRAY_ELEMENTS(dirs), stateFile, 100, alloc, indexFile);
+
+    // without an index file, the directory is scanned and the index file is written
+    this->sendCmd_BUILD_CATALOG(0, 10);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, DpCatalog::OPCODE_BUILD_CATALOG, 10, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_IndexLoaded_SIZE(0);
+    ASSERT_EVENTS_DpFileAdded_SIZE(INDEX_TEST_DPS);
+    ASSERT_TRUE(Os::FileSystem::exists(INDEX_TEST_INDEX_FILE));
+
+    // send some of the products, then stop while another is sent
+    this->sendCmd_START_XMIT_CATALOG(0, 11, Fw::Wait::NO_WAIT, false);
+    this->component.doDispatch();
+    while (this->fromPortHistory_fileOut->size() < INDEX_TEST_SENT) {
+        this->component.doDispatch();
+    }
+    this->sendCmd_STOP_XMIT_CATALOG(0, 12);
+    while (this->component.m_queue.getMessagesAvailable() > 0) {
+        this->component.doDispatch();
+    }
+    ASSERT_EVENTS_CatalogXmitStopped_SIZE(1);
+    ASSERT_from_fileOut_SIZE(INDEX_TEST_SENT + 1);
+
+    this->component.shutdown();
+}
+
+void DpCatalogTester ::test_IndexFileLoad() {
+    Fw::MallocAllocator alloc;
+    Fw::FileNameString dirs[1];
+    dirs[0] = INDEX_TEST_DIR;
+    Fw::FileNameString stateFile(INDEX_TEST_STATE_FILE);
+    Fw::FileNameString indexFile(INDEX_TEST_INDEX_FILE);
+    this->component.configure(dirs, FW_NUM_ARRAY_ELEMENTS(dirs), stateFile, 100, alloc, indexFile);
+
+    // a product written before the build is recorded in the index file
+    const Fw::Time addedTime(1, 0);
+    Fw::String added = this->genDP(static_cast<FwDpIdType>(INDEX_TEST_DPS), 0, addedTime, 100,
+                                   Fw::DpState::UNTRANSMITTED, false, INDEX_TEST_DIR);
+    this->invoke_to_addToCat(0, added, 0, 0);
+    this->component.doDispatch();
+    ASSERT_EVENTS_NotLoaded_SIZE(1);
+
+    // the build loads the products that weren't sent from the index file without reading the directory
+    this->sendCmd_BUILD_CATALOG(0, 10);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, DpCatalog::OPCODE_BUILD_CATALOG, 10, Fw::CmdResponse::OK);
+    const U32 pending = static_cast<U32>(INDEX_TEST_DPS - INDEX_TEST_SENT);
+    ASSERT_EVENTS_IndexLoaded_SIZE(1);
+    ASSERT_EVENTS_IndexLoaded(0, INDEX_TEST_INDEX_FILE, pending);
+    ASSERT_EVENTS_ProcessingDirectory_SIZE(0);
+    ASSERT_EVENTS_ProcessingFile_SIZE(0);
+
+    this->sendCmd_START_XMIT_CATALOG(0, 11, Fw::Wait::NO_WAIT, false);
+    while (this->component.m_queue.getMessagesAvailable() > 0) {
+        this->component.doDispatch();
+    }
+    ASSERT_EVENTS_CatalogXmitCompleted_SIZE(1);
+    ASSERT_from_fileOut_SIZE(pending);
+    // the product added before the build has the highest priority
+    ASSERT_from_fileOut(0, added, added, 0, 0);
+
+    // clearing the catalog removes the index file
+    this->sendCmd_CLEAR_CATALOG(0, 12);
+    this->component.doDispatch();
+    ASSERT_FALSE(Os::FileSystem::exists(INDEX_TEST_INDEX_FILE));
+
+    // an index file written in another format is ignored and the directory is scanned
+    Os::File badIndex;
+    ASSERT_EQ(badIndex.open(INDEX_TEST_INDEX_FILE, Os::File::OPEN_CREATE), Os::File::OP_OK);
+    U8 garbage[] = {'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'n', 'd', 'e', 'x'};
+    FwSizeType size = sizeof(garbage);
+    ASSERT_EQ(badIndex.write(garbage, size), Os::File::OP_OK);
+    badIndex.close();
+    this->clearEvents();
+    this->sendCmd_BUILD_CATALOG(0, 13);
+    this->component.doDispatch();
+    ASSERT_EVENTS_IndexInvalid_SIZE(1);
+    ASSERT_EVENTS_IndexLoaded_SIZE(0);
+    ASSERT_EVENTS_DpFileAdded_SIZE(INDEX_TEST_DPS + 1);
+
+    this->component.shutdown();
+
+    for (FwSizeType dp = 0; dp <= INDEX_TEST_DPS; dp++) {
+        const Fw::Time time = (dp == INDEX_TEST_DPS) ? addedTime : Fw::Time(1000 + static_cast<U32>(dp), 0);
+        this->delDp(static_cast<FwDpIdType>(dp), time, INDEX_TEST_DIR);
+    }
+    (void)Os::FileSystem::removeFile(INDEX_TEST_STATE_FILE);
+    (void)Os::FileSystem::removeFile(INDEX_TEST_INDEX_FILE);
+}
+
+void DpCatalogTester ::test_IndexFileTruncated() {
+    this->makeDpDir(INDEX_TEST_DIR);
+    (void)Os::FileSystem::removeFile(INDEX_TEST_STATE_FILE);
+    (void)Os::FileSystem::removeFile(INDEX_TEST_INDEX_FILE);
+    for (FwSizeType dp = 0; dp < INDEX_TEST_DPS; dp++) {
+        this->genDP(static_cast<FwDpIdType>(dp), 0, Fw::Time(1000 + static_cast<U32>(dp), 0), 100,
+                    Fw::DpState::UNTRANSMITTED, false, INDEX_TEST_DIR);
+    }
+
+    Fw::MallocAllocator alloc;
+    Fw::FileNameString dirs[1];
+    dirs[0] = INDEX_TEST_DIR;
+    Fw::FileNameString stateFile(INDEX_TEST_STATE_FILE);
+    Fw::FileNameString indexFile(INDEX_TEST_INDEX_FILE);
+    this->component.configure(dirs, FW_NUM_ARRAY_ELEMENTS(dirs), stateFile, 100, alloc, indexFile);
+    // leave room for only some of the products
+    this->component.m_numDpSlots = INDEX_TEST_DPS / 2;
+
+    // a scan that fills the catalog doesn't write the index file, so the next build scans again
+    this->sendCmd_BUILD_CATALOG(0, 10);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, DpCatalog::OPCODE_BUILD_CATALOG, 10, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_CatalogFull_SIZE(1);
+    ASSERT_EVENTS_DpFileAdded_SIZE(INDEX_TEST_DPS / 2);
+    ASSERT_FALSE(Os::FileSystem::exists(INDEX_TEST_INDEX_FILE));
+
+    this->component.shutdown();
+
+    for (FwSizeType dp = 0; dp < INDEX_TEST_DPS; dp++) {
+        this->delDp(static_cast<FwDpIdType>(dp), Fw::Time(1000 + static_cast<U32>(dp), 0), INDEX_TEST_DIR);
+    }
+    (void)Os::FileSystem::removeFile(INDEX_TEST_STATE_FILE);
+}
+
 }  // namespace Svc
@@ -93,8 +93,8 @@ class DpCatalogTester : public DpCatalogGTestBase {
         FwIndexType portNum,                   //!< The port number
         const Fw::StringBase& sourceFileName,  //!< Path of file to downlink
         const Fw::StringBase& destFileName,    //!< Path to store downlinked file at
-        U32 offset,  //!< Amount of data in bytes to downlink from file. 0 to read until end of file
-        U32 length   //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+        FwFileOffsetType offset,  //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+        FwFileOffsetType length   //!< Amount of data in bytes to downlink from file. 0 to read until end of file
         ) override;
 
     //! Handler implementation for pingOut
@@ -142,12 +142,17 @@ class DpCatalogTester : public DpCatalogGTestBase {
     void test_TreeTestRandomTime();
     void test_TreeTestRandomId();
     void test_TreeTestRandomPrioIdTime();
-    void test_RandomDp();
+    void test_RandomDp(bool scanTasks = false);
     void test_XmitBeforeInit();
     void test_StopWarn();
     void test_CompareEntries();
     void test_PingIn();
     void test_BadFileDone();
+    void test_IndexBuild(FwSizeType numEntries, bool report = false);
+    void test_StateFileLookup();
+    void test_IndexFileBuild();
+    void test_IndexFileLoad();
+    void test_IndexFileTruncated();
 };
 
 }  // namespace Svc
@@ -14,9 +14,19 @@
 #include <Fw/Types/Assert.hpp>
 #include <Os/FileSystem.hpp>
 #include <Svc/FileDownlink/FileDownlink.hpp>
+#include <cstring>
 
 namespace Svc {
 
+static_assert(FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE > 0, "FileDownlink read-ahead blocks cannot be empty");
+
+FileDownlink::File ::File() : m_size(0), m_nextBlock(0) {
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(this->m_blocks); i++) {
+        this->m_blocks[i].offset = 0;
+        this->m_blocks[i].size = 0;
+    }
+}
+
 Os::File::Status FileDownlink::File ::open(const char* const sourceFileName, const char* const destFileName) {
     // Set source name
     Fw::LogStringArg sourceLogStringArg(sourceFileName);
@@ -32,39 +42,71 @@ Os::File::Status FileDownlink::File ::open(const char* const sourceFileName, con
     if (status != Os::FileSystem::OP_OK) {
         return Os::File::BAD_SIZE;
     }
-    // If the size does not cast cleanly to the desired U32 type, return size error
-    if (static_cast<FwSizeType>(static_cast<U32>(file_size)) != file_size) {
+    // If the size does not cast cleanly to the file packet offset type, return size error
+    if (static_cast<FwSizeType>(static_cast<FwFileOffsetType>(file_size)) != file_size) {
         return Os::File::BAD_SIZE;
     }
-    this->m_size = static_cast<U32>(file_size);
+    this->m_size = static_cast<FwFileOffsetType>(file_size);
 
     // Initialize checksum
     CFDP::Checksum checksum;
     this->m_checksum = checksum;
 
+    // Discard blocks read ahead from the previous file
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(this->m_blocks); i++) {
+        this->m_blocks[i].size = 0;
+    }
+    this->m_nextBlock = 0;
+
     // Open osFile for reading
     return this->m_osFile.open(sourceFileName, Os::File::OPEN_READ);
 }
 
-Os::File::Status FileDownlink::File ::read(U8* const data, const U32 byteOffset, const U32 size) {
-    Os::File::Status status;
-    status = this->m_osFile.seek(byteOffset, Os::File::SeekType::ABSOLUTE);
-    if (status != Os::File::OP_OK) {
-        return status;
+Os::File::Status FileDownlink::File ::read(U8* const data, const FwFileOffsetType byteOffset, const U32 size) {
+    U32 copied = 0;
+    while (copied < size) {
+        const FwFileOffsetType offset = byteOffset + copied;
+        const ReadAheadBlock* block = this->findBlock(offset);
+        if (block == nullptr) {
+            const Os::File::Status status = this->fillBlock(offset, block);
+            if (status != Os::File::OP_OK) {
+                return status;
+            }
+            // Force a bad size error when the file ends before the requested bytes
+            if (offset - block->offset >= block->size) {
+                return Os::File::BAD_SIZE;
+            }
+        }
+        const U32 position = static_cast<U32>(offset - block->offset);
+        const U32 count = FW_MIN(size - copied, block->size - position);
+        (void)::memcpy(&data[copied], &block->data[position], count);
+        copied += count;
     }
+    this->m_checksum.update(data, byteOffset, size);
 
-    FwSizeType intSize = size;
-    status = this->m_osFile.read(data, intSize);
+    return Os::File::OP_OK;
+}
 
-    if (status != Os::File::OP_OK) {
-        return status;
-    }
-    // Force a bad size error when the U32 carrying size is bad
-    if (static_cast<U32>(intSize) != size) {
-        return Os::File::BAD_SIZE;
+const FileDownlink::File::ReadAheadBlock* FileDownlink::File ::findBlock(const FwFileOffsetType byteOffset) const {
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(this->m_blocks); i++) {
+        const ReadAheadBlock& block = this->m_blocks[i];
+        if ((byteOffset >= block.offset) && (byteOffset - block.offset < block.size)) {
+            return &block;
+        }
     }
-    this->m_checksum.update(data, byteOffset, size);
+    return nullptr;
+}
 
-    return Os::File::OP_OK;
+Os::File::Status FileDownlink::File ::fillBlock(const FwFileOffsetType byteOffset, const ReadAheadBlock*& block) {
+    ReadAheadBlock& fill = this->m_blocks[this->m_nextBlock];
+    this->m_nextBlock = (this->m_nextBlock + 1) % FW_NUM_ARRAY_ELEMENTS(this->m_blocks);
+    block = &fill;
+
+    // One positional read of the whole aligned block, without seeking
+    fill.offset = byteOffset - (byteOffset % FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE);
+    FwSizeType readSize = sizeof(fill.data);
+    const Os::File::Status status = this->m_osFile.readAt(fill.data, readSize, static_cast<FwSizeType>(fill.offset));
+    fill.size = (status == Os::File::OP_OK) ? static_cast<U32>(readSize) : 0;
+    return status;
 }
 }  // namespace Svc
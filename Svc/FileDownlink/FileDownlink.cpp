@@ -19,6 +19,8 @@
 
 namespace Svc {
 
+static_assert(FILEDOWNLINK_WINDOW_SIZE > 0, "FileDownlink needs at least one packet in flight");
+
 // ----------------------------------------------------------------------
 // Construction, initialization, and destruction
 // ----------------------------------------------------------------------
@@ -26,6 +28,8 @@ namespace Svc {
 FileDownlink ::FileDownlink(const char* const name)
     : FileDownlinkComponentBase(name),
       m_configured(false),
+      m_inFlight(0),
+      m_stranded(0),
       m_filesSent(this),
       m_packetsSent(this),
       m_warnings(this),
@@ -37,7 +41,13 @@ FileDownlink ::FileDownlink(const char* const name)
       m_lastCompletedType(Fw::FilePacket::T_NONE),
       m_lastBufferId(0),
       m_curEntry(),
-      m_cntxId(0) {}
+      m_cntxId(0) {
+    for (U32 i = 0; i < FILEDOWNLINK_WINDOW_SIZE; i++) {
+        this->m_slots[i].bufferId = 0;
+        this->m_slots[i].inFlight = false;
+        this->m_slots[i].stranded = false;
+    }
+}
 
 void FileDownlink ::configure(U32 cooldown, U32 cycleTime, U32 fileQueueDepth) {
     this->m_cooldown = cooldown;
@@ -68,6 +78,15 @@ FileDownlink ::~FileDownlink() {}
 void FileDownlink ::Run_handler(const FwIndexType portNum, U32 context) {
     switch (this->m_mode.get()) {
         case Mode::IDLE: {
+            // Packets of a failed downlink may still be in flight. Wait for them before starting the next file,
+            // and take those not returned within the timeout out of service so they are never reused downstream.
+            if (this->m_inFlight > 0) {
+                if (this->m_curTimer < FILEDOWNLINK_BUFFER_RETURN_TIMEOUT) {
+                    this->m_curTimer += m_cycleTime;
+                    return;
+                }
+                this->strandBuffers();
+            }
             FwSizeType real_size = 0;
             FwQueuePriorityType prio = 0;
             Os::Queue::Status stat = m_fileQueue.receive(reinterpret_cast<U8*>(&this->m_curEntry),
@@ -78,6 +97,15 @@ void FileDownlink ::Run_handler(const FwIndexType portNum, U32 context) {
                 return;
             }
 
+            // The file is sent with the buffers that are not out of service, and fails when there are none
+            if (this->m_stranded == FILEDOWNLINK_WINDOW_SIZE) {
+                this->log_WARNING_HI_NoBuffers(Fw::LogStringArg(this->m_curEntry.srcFilename),
+                                               Fw::LogStringArg(this->m_curEntry.destFilename));
+                sendResponse(FILEDOWNLINK_COMMAND_FAILURES_DISABLED ? SendFileStatus::STATUS_OK
+                                                                    : SendFileStatus::STATUS_ERROR);
+                return;
+            }
+
             sendFile(this->m_curEntry.srcFilename, this->m_curEntry.destFilename, this->m_curEntry.offset,
                      this->m_curEntry.length);
             break;
@@ -104,8 +132,8 @@ Svc::SendFileResponse FileDownlink ::SendFile_handler(
     const FwIndexType portNum,
     const Fw::StringBase& sourceFilename,  // lgtm[cpp/large-parameter] dictated by command architecture
     const Fw::StringBase& destFilename,    // lgtm[cpp/large-parameter] dictated by command architecture
-    U32 offset,
-    U32 length) {
+    FwFileOffsetType offset,
+    FwFileOffsetType length) {
     struct FileEntry entry;
     entry.srcFilename[0] = 0;
     entry.destFilename[0] = 0;
@@ -138,16 +166,22 @@ void FileDownlink ::pingIn_handler(const FwIndexType portNum, U32 key) {
 
 void FileDownlink ::bufferReturn_handler(const FwIndexType portNum, Fw::Buffer& fwBuffer) {
     // If this is a stale buffer (old, timed-out, or both), then ignore its return.
-    // File downlink actions only respond to the return of the most-recently-sent buffer.
-    if (this->m_lastBufferId != fwBuffer.getContext() + 1 || this->m_mode.get() == Mode::IDLE) {
+    // Buffers may return in any order; each return frees its place in the send window.
+    if (not this->releaseBuffer(fwBuffer)) {
+        return;
+    }
+    // Packets still in flight when a downlink failed return after it ended, and only free their buffers
+    if (this->m_mode.get() == Mode::IDLE || this->m_mode.get() == Mode::COOLDOWN) {
         return;
     }
     // Non-ignored buffers cannot be returned in "DOWNLINK" and "IDLE" state.  Only in "WAIT", "CANCEL" state.
     FW_ASSERT(this->m_mode.get() == Mode::WAIT || this->m_mode.get() == Mode::CANCEL,
               static_cast<FwAssertArgType>(this->m_mode.get()));
-    // If the last packet has been sent (and is returning now) then finish the file
+    // If the last packet has been sent then finish the file once every packet has returned
     if (this->m_lastCompletedType == Fw::FilePacket::T_END || this->m_lastCompletedType == Fw::FilePacket::T_CANCEL) {
-        finishHelper(this->m_lastCompletedType == Fw::FilePacket::T_CANCEL);
+        if (this->m_inFlight == 0) {
+            finishHelper(this->m_lastCompletedType == Fw::FilePacket::T_CANCEL);
+        }
         return;
     }
     // If waiting and a buffer is in-bound, then switch to downlink mode
@@ -195,8 +229,8 @@ void FileDownlink ::SendPartial_cmdHandler(FwOpcodeType opCode,
                                            U32 cmdSeq,
                                            const Fw::CmdStringArg& sourceFilename,
                                            const Fw::CmdStringArg& destFilename,
-                                           U32 startOffset,
-                                           U32 length) {
+                                           FwFileOffsetType startOffset,
+                                           FwFileOffsetType length) {
     struct FileEntry entry;
     entry.srcFilename[0] = 0;
     entry.destFilename[0] = 0;
@@ -265,7 +299,10 @@ void FileDownlink ::sendResponse(SendFileStatus resp) {
     }
 }
 
-void FileDownlink ::sendFile(const char* sourceFilename, const char* destFilename, U32 startOffset, U32 length) {
+void FileDownlink ::sendFile(const char* sourceFilename,
+                             const char* destFilename,
+                             FwFileOffsetType startOffset,
+                             FwFileOffsetType length) {
     // Open file for downlink
     Os::File::Status status = this->m_file.open(sourceFilename, destFilename);
 
@@ -284,7 +321,7 @@ void FileDownlink ::sendFile(const char* sourceFilename, const char* destFilenam
         sendResponse(FILEDOWNLINK_COMMAND_FAILURES_DISABLED ? SendFileStatus::STATUS_OK
                                                             : SendFileStatus::STATUS_INVALID);
         return;
-    } else if (startOffset + length > this->m_file.getSize()) {
+    } else if (length > this->m_file.getSize() - startOffset) {
         // If the amount to downlink is greater than the file size, emit a Warning and then allow
         // the file to be downlinked anyway
         this->log_WARNING_LO_DownlinkPartialWarning(startOffset, length, this->m_file.getSize(),
@@ -292,8 +329,7 @@ void FileDownlink ::sendFile(const char* sourceFilename, const char* destFilenam
         length = this->m_file.getSize() - startOffset;
     }
 
-    // Send file and switch to WAIT mode
-    this->getBuffer(this->m_buffer, FILE_PACKET);
+    // Send file and switch to WAIT mode. Data packets follow once the start packet returns.
     this->sendStartPacket();
     this->m_mode.set(Mode::WAIT);
     this->m_sequenceIndex = 1;
@@ -312,15 +348,15 @@ void FileDownlink ::sendFile(const char* sourceFilename, const char* destFilenam
     }
 }
 
-Os::File::Status FileDownlink ::sendDataPacket(U32& byteOffset) {
+Os::File::Status FileDownlink ::sendDataPacket(FwFileOffsetType& byteOffset) {
     FW_ASSERT(byteOffset < this->m_endOffset);
     const U32 maxDataSize =
         FILEDOWNLINK_INTERNAL_BUFFER_SIZE - Fw::FilePacket::DataPacket::HEADERSIZE - sizeof(FwPacketDescriptorType);
-    const U32 dataSize =
-        (byteOffset + maxDataSize > this->m_endOffset) ? (this->m_endOffset - byteOffset) : maxDataSize;
+    const FwFileOffsetType remaining = this->m_endOffset - byteOffset;
+    const U32 dataSize = (remaining < maxDataSize) ? static_cast<U32>(remaining) : maxDataSize;
     U8 buffer[maxDataSize];
     // This will be last data packet sent
-    if (dataSize + byteOffset == this->m_endOffset) {
+    if (dataSize == remaining) {
         this->m_lastCompletedType = Fw::FilePacket::T_DATA;
     }
 
@@ -343,28 +379,12 @@ Os::File::Status FileDownlink ::sendDataPacket(U32& byteOffset) {
 }
 
 void FileDownlink ::sendCancelPacket() {
-    Fw::Buffer buffer;
     Fw::FilePacket::CancelPacket cancelPacket;
     cancelPacket.initialize(this->m_sequenceIndex);
 
     Fw::FilePacket filePacket;
     filePacket.fromCancelPacket(cancelPacket);
-    this->getBuffer(buffer, CANCEL_PACKET);
-    FW_ASSERT(buffer.getSize() >= filePacket.bufferSize() + sizeof(FwPacketDescriptorType),
-              static_cast<FwAssertArgType>(buffer.getSize()),
-              static_cast<FwAssertArgType>(filePacket.bufferSize() + sizeof(FwPacketDescriptorType)));
-
-    // Serialize the packet descriptor FW_PACKET_FILE to the buffer
-    Fw::SerializeStatus status =
-        buffer.getSerializer().serializeFrom(static_cast<FwPacketDescriptorType>(Fw::ComPacketType::FW_PACKET_FILE));
-    FW_ASSERT(status == Fw::FW_SERIALIZE_OK);
-    Fw::Buffer offsetBuffer(buffer.getData() + sizeof(FwPacketDescriptorType),
-                            buffer.getSize() - static_cast<Fw::Buffer::SizeType>(sizeof(FwPacketDescriptorType)));
-    // Serialize the filePacket content into the buffer
-    status = filePacket.toBuffer(offsetBuffer);
-    FW_ASSERT(status == Fw::FW_SERIALIZE_OK);
-    this->bufferSendOut_out(0, buffer);
-    this->m_packetsSent.packetSent();
+    this->sendFilePacket(filePacket);
 }
 
 void FileDownlink ::sendEndPacket() {
@@ -390,24 +410,22 @@ void FileDownlink ::sendStartPacket() {
 
 void FileDownlink ::sendFilePacket(const Fw::FilePacket& filePacket) {
     const U32 bufferSize = filePacket.bufferSize() + static_cast<U32>(sizeof(FwPacketDescriptorType));
-    FW_ASSERT(this->m_buffer.getData() != nullptr);
-    FW_ASSERT(this->m_buffer.getSize() >= bufferSize, static_cast<FwAssertArgType>(bufferSize),
-              static_cast<FwAssertArgType>(this->m_buffer.getSize()));
+    Fw::Buffer buffer;
+    this->getBuffer(buffer);
+    FW_ASSERT(buffer.getSize() >= bufferSize, static_cast<FwAssertArgType>(bufferSize),
+              static_cast<FwAssertArgType>(buffer.getSize()));
     // Serialize packet descriptor FW_PACKET_FILE to the buffer
-    Fw::SerializeStatus status = this->m_buffer.getSerializer().serializeFrom(
-        static_cast<FwPacketDescriptorType>(Fw::ComPacketType::FW_PACKET_FILE));
+    Fw::SerializeStatus status =
+        buffer.getSerializer().serializeFrom(static_cast<FwPacketDescriptorType>(Fw::ComPacketType::FW_PACKET_FILE));
     FW_ASSERT(status == Fw::FW_SERIALIZE_OK);
     // Serialize the filePacket content into the buffer, offset by the size of the packet descriptor
-    Fw::Buffer offsetBuffer(
-        this->m_buffer.getData() + sizeof(FwPacketDescriptorType),
-        this->m_buffer.getSize() - static_cast<Fw::Buffer::SizeType>(sizeof(FwPacketDescriptorType)));
+    Fw::Buffer offsetBuffer(buffer.getData() + sizeof(FwPacketDescriptorType),
+                            buffer.getSize() - static_cast<Fw::Buffer::SizeType>(sizeof(FwPacketDescriptorType)));
     status = filePacket.toBuffer(offsetBuffer);
     FW_ASSERT(status == Fw::FW_SERIALIZE_OK);
     // set the buffer size to the packet size
-    this->m_buffer.setSize(bufferSize);
-    this->bufferSendOut_out(0, this->m_buffer);
-    // restore buffer size to max
-    this->m_buffer.setSize(FILEDOWNLINK_INTERNAL_BUFFER_SIZE);
+    buffer.setSize(bufferSize);
+    this->bufferSendOut_out(0, buffer);
     this->m_packetsSent.packetSent();
 }
 
@@ -423,28 +441,33 @@ void FileDownlink ::downlinkPacket() {
               static_cast<FwAssertArgType>(this->m_lastCompletedType));
     FW_ASSERT(this->m_mode.get() == Mode::CANCEL || this->m_mode.get() == Mode::DOWNLINK,
               static_cast<FwAssertArgType>(this->m_mode.get()));
-    // If canceled mode and currently downlinking data then send a cancel packet
-    if (this->m_mode.get() == Mode::CANCEL && this->m_lastCompletedType == Fw::FilePacket::T_START) {
-        this->sendCancelPacket();
-        this->m_lastCompletedType = Fw::FilePacket::T_CANCEL;
-    }
-    // If in downlink mode and currently downlinking data then continue with the next packer
-    else if (this->m_mode.get() == Mode::DOWNLINK && this->m_lastCompletedType == Fw::FilePacket::T_START) {
-        // Send the next packet, or fail doing so
-        const Os::File::Status status = this->sendDataPacket(this->m_byteOffset);
-        if (status != Os::File::OP_OK) {
-            this->log_WARNING_HI_SendDataFail(this->m_file.getSourceName(), this->m_byteOffset);
-            this->enterCooldown();
-            this->sendResponse(FILEDOWNLINK_COMMAND_FAILURES_DISABLED ? SendFileStatus::STATUS_OK
-                                                                      : SendFileStatus::STATUS_ERROR);
-            // Don't go to wait state
-            return;
+    // Send packets until the window, less the buffers out of service, is full or the last packet has been sent
+    while ((this->m_inFlight + this->m_stranded) < FILEDOWNLINK_WINDOW_SIZE) {
+        // If canceled mode and currently downlinking data then send a cancel packet
+        if (this->m_mode.get() == Mode::CANCEL && this->m_lastCompletedType == Fw::FilePacket::T_START) {
+            this->sendCancelPacket();
+            this->m_lastCompletedType = Fw::FilePacket::T_CANCEL;
+        }
+        // If in downlink mode and currently downlinking data then continue with the next packer
+        else if (this->m_mode.get() == Mode::DOWNLINK && this->m_lastCompletedType == Fw::FilePacket::T_START) {
+            // Send the next packet, or fail doing so
+            const Os::File::Status status = this->sendDataPacket(this->m_byteOffset);
+            if (status != Os::File::OP_OK) {
+                this->log_WARNING_HI_SendDataFail(this->m_file.getSourceName(), this->m_byteOffset);
+                this->enterCooldown();
+                this->sendResponse(FILEDOWNLINK_COMMAND_FAILURES_DISABLED ? SendFileStatus::STATUS_OK
+                                                                          : SendFileStatus::STATUS_ERROR);
+                // Don't go to wait state
+                return;
+            }
+        }
+        // If in downlink mode or cancel and finished downlinking data then send the last packet
+        else if (this->m_lastCompletedType == Fw::FilePacket::T_DATA) {
+            this->sendEndPacket();
+            this->m_lastCompletedType = Fw::FilePacket::T_END;
+        } else {
+            break;
         }
-    }
-    // If in downlink mode or cancel and finished downlinking data then send the last packet
-    else if (this->m_lastCompletedType == Fw::FilePacket::T_DATA) {
-        this->sendEndPacket();
-        this->m_lastCompletedType = Fw::FilePacket::T_END;
     }
     this->m_mode.set(Mode::WAIT);
     this->m_curTimer = 0;
@@ -462,14 +485,54 @@ void FileDownlink ::finishHelper(bool cancel) {
     sendResponse(SendFileStatus::STATUS_OK);
 }
 
-void FileDownlink ::getBuffer(Fw::Buffer& buffer, PacketType type) {
-    // Check type is correct
-    FW_ASSERT(type < COUNT_PACKET_TYPE && type >= 0, static_cast<FwAssertArgType>(type));
+void FileDownlink ::getBuffer(Fw::Buffer& buffer) {
+    // Find a buffer that is not in flight
+    U32 slot = 0;
+    while ((slot < FILEDOWNLINK_WINDOW_SIZE) && this->m_slots[slot].inFlight) {
+        slot++;
+    }
+    FW_ASSERT(slot < FILEDOWNLINK_WINDOW_SIZE, static_cast<FwAssertArgType>(this->m_inFlight));
     // Wrap the buffer around our indexed memory.
-    buffer.setData(this->m_memoryStore[type]);
+    buffer.setData(this->m_memoryStore[slot]);
     buffer.setSize(FILEDOWNLINK_INTERNAL_BUFFER_SIZE);
     // Set a known ID to look for later
     buffer.setContext(m_lastBufferId);
+    this->m_slots[slot].bufferId = m_lastBufferId;
+    this->m_slots[slot].inFlight = true;
+    this->m_inFlight++;
     m_lastBufferId++;
 }
+
+void FileDownlink ::strandBuffers() {
+    // Keep the buffers in flight out of service, as a downstream component may still own them, until they return
+    const U32 count = this->m_inFlight;
+    for (U32 slot = 0; slot < FILEDOWNLINK_WINDOW_SIZE; slot++) {
+        if (this->m_slots[slot].inFlight) {
+            this->m_slots[slot].stranded = true;
+        }
+    }
+    this->m_stranded += this->m_inFlight;
+    this->m_inFlight = 0;
+    this->m_curTimer = 0;
+    this->m_warnings.buffersStranded(count);
+}
+
+bool FileDownlink ::releaseBuffer(const Fw::Buffer& buffer) {
+    for (U32 slot = 0; slot < FILEDOWNLINK_WINDOW_SIZE; slot++) {
+        if (this->m_slots[slot].inFlight && (this->m_slots[slot].bufferId == buffer.getContext())) {
+            this->m_slots[slot].inFlight = false;
+            // A buffer out of service only returns to service, and is not a packet of the current downlink
+            if (this->m_slots[slot].stranded) {
+                this->m_slots[slot].stranded = false;
+                FW_ASSERT(this->m_stranded > 0);
+                this->m_stranded--;
+                return false;
+            }
+            FW_ASSERT(this->m_inFlight > 0);
+            this->m_inFlight--;
+            return true;
+        }
+    }
+    return false;
+}
 }  // end namespace Svc
@@ -72,9 +72,26 @@ class FileDownlink final : public FileDownlinkComponentBase {
 
       public:
         //! Constructor
-        File() : m_size(0) {}
+        File();
 
       private:
+        //! A block of the file read ahead of packetization
+        struct ReadAheadBlock {
+            FwFileOffsetType offset;                       //!< Offset in the file of the first byte of the block
+            U32 size;                                      //!< Number of bytes held, 0 when the block is empty
+            U8 data[FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE];  //!< The bytes of the block
+        };
+
+        //! Find the read-ahead block holding a byte of the file
+        //! \return The block, or nullptr if no block holds the byte
+        const ReadAheadBlock* findBlock(const FwFileOffsetType byteOffset  //!< The offset of the byte in the file
+        ) const;
+
+        //! Read the aligned block holding a byte of the file into the least recently filled read-ahead block
+        Os::File::Status fillBlock(const FwFileOffsetType byteOffset,  //!< The offset of the byte in the file
+                                   const ReadAheadBlock*& block        //!< The block filled
+        );
+
         //! The source file name
         Fw::LogStringArg m_sourceName;
 
@@ -85,19 +102,25 @@ class FileDownlink final : public FileDownlinkComponentBase {
         Os::File m_osFile;
 
         //! The file size
-        U32 m_size;
+        FwFileOffsetType m_size;
 
         //! The checksum for the file
         CFDP::Checksum m_checksum;
 
+        //! The blocks read ahead of packetization
+        ReadAheadBlock m_blocks[2];
+
+        //! Index of the block filled next
+        U32 m_nextBlock;
+
       public:
         //! Open the OS file for reading and initialize the checksum
         Os::File::Status open(const char* const sourceFileName,  //!< The source file name
                               const char* const destFileName     //!< The destination file name
         );
 
-        //! Read bytes from the OS file and update the checksum
-        Os::File::Status read(U8* const data, const U32 byteOffset, const U32 size);
+        //! Read bytes from the read-ahead blocks, filling them from the OS file as needed, and update the checksum
+        Os::File::Status read(U8* const data, const FwFileOffsetType byteOffset, const U32 size);
 
         //! Get the checksum
         void getChecksum(CFDP::Checksum& checksum) { checksum = this->m_checksum; }
@@ -112,7 +135,7 @@ class FileDownlink final : public FileDownlinkComponentBase {
         Os::File& getOsFile(void) { return this->m_osFile; }
 
         //! Get the file size
-        U32 getSize(void) { return this->m_size; }
+        FwFileOffsetType getSize(void) { return this->m_size; }
     };
 
     //! Class to record files sent
@@ -176,6 +199,9 @@ class FileDownlink final : public FileDownlinkComponentBase {
         //! Issue a File Read Error warning
         void fileRead(const Os::File::Status status);
 
+        //! Issue a Buffers Stranded warning
+        void buffersStranded(const U32 count);
+
       private:
         //! Record a warning
         void warning() {
@@ -198,17 +224,20 @@ class FileDownlink final : public FileDownlinkComponentBase {
     struct FileEntry {
         char srcFilename[Fw::FileNameString::STRING_SIZE];   // Name of requested file
         char destFilename[Fw::FileNameString::STRING_SIZE];  // Name of requested file
-        U32 offset;
-        U32 length;
+        FwFileOffsetType offset;
+        FwFileOffsetType length;
         CallerSource source;  // Source of the downlink request
         FwOpcodeType opCode;  // Op code of command, only set for CMD sources.
         U32 cmdSeq;           // CmdSeq number, only set for CMD sources.
         U32 context;          // Context id of request, only set for PORT sources.
     };
 
-    //! Enumeration for packet types
-    //! Each type has a buffer to store it.
-    enum PacketType { FILE_PACKET, CANCEL_PACKET, COUNT_PACKET_TYPE };
+    //! Tracks one internal buffer of the send window
+    struct BufferSlot {
+        U32 bufferId;   // Context of the buffer while it is in flight
+        bool inFlight;  // Whether the buffer has been sent and not yet returned
+        bool stranded;  // Whether the buffer was not returned in time and is out of service until it returns
+    };
 
   public:
     // ----------------------------------------------------------------------
@@ -256,8 +285,8 @@ class FileDownlink final : public FileDownlinkComponentBase {
         const FwIndexType portNum,            /*!< The port number*/
         const Fw::StringBase& sourceFilename, /*!< Path of file to downlink*/
         const Fw::StringBase& destFilename,   /*!< Path to store downlinked file at*/
-        U32 offset, /*!< Amount of data in bytes to downlink from file. 0 to read until end of file*/
-        U32 length  /*!< Amount of data in bytes to downlink from file. 0 to read until end of file*/
+        FwFileOffsetType offset, /*!< Amount of data in bytes to downlink from file. 0 to read until end of file*/
+        FwFileOffsetType length  /*!< Amount of data in bytes to downlink from file. 0 to read until end of file*/
     );
 
     //! Handler implementation for bufferReturn
@@ -297,8 +326,9 @@ class FileDownlink final : public FileDownlinkComponentBase {
         U32 cmdSeq,                              //!< The command sequence number
         const Fw::CmdStringArg& sourceFilename,  //!< The name of the on-board file to send
         const Fw::CmdStringArg& destFilename,    //!< The name of the destination file on the ground
-        U32 startOffset,                         //!< Starting offset of the source file
-        U32 length  //!< Number of bytes to send from starting offset. Length of 0 implies until the end of the file
+        FwFileOffsetType startOffset,            //!< Starting offset of the source file
+        FwFileOffsetType length  //!< Number of bytes to send from starting offset. Length of 0 implies until the end
+                                 //!< of the file
     );
 
   private:
@@ -307,14 +337,15 @@ class FileDownlink final : public FileDownlinkComponentBase {
     // ----------------------------------------------------------------------
 
     void sendFile(
-        const char* sourceFilename,  //!< The name of the on-board file to send
-        const char* destFilename,    //!< The name of the destination file on the ground
-        U32 startOffset,             //!< Starting offset of the source file
-        U32 length  //!< Number of bytes to send from starting offset. Length of 0 implies until the end of the file
+        const char* sourceFilename,    //!< The name of the on-board file to send
+        const char* destFilename,      //!< The name of the destination file on the ground
+        FwFileOffsetType startOffset,  //!< Starting offset of the source file
+        FwFileOffsetType length  //!< Number of bytes to send from starting offset. Length of 0 implies until the end
+                                 //!< of the file
     );
 
     // Individual packet transfer functions
-    Os::File::Status sendDataPacket(U32& byteOffset);
+    Os::File::Status sendDataPacket(FwFileOffsetType& byteOffset);
     void sendCancelPacket();
     void sendEndPacket();
     void sendStartPacket();
@@ -324,9 +355,14 @@ class FileDownlink final : public FileDownlinkComponentBase {
     void exitFileTransfer();
     void enterCooldown();
 
-    // Function to acquire a buffer internally
-    void getBuffer(Fw::Buffer& buffer, PacketType type);
-    // Downlink the "next" packet
+    // Function to acquire a free buffer of the send window
+    void getBuffer(Fw::Buffer& buffer);
+    // Release the window buffer of a returned buffer. Returns false if the buffer is not in flight for the current
+    // downlink.
+    bool releaseBuffer(const Fw::Buffer& buffer);
+    // Take the window buffers that were not returned in time out of service until they return
+    void strandBuffers();
+    // Downlink the "next" packets, until the send window is full
     void downlinkPacket();
     // Finish the file transfer
     void finishHelper(bool is_cancel);
@@ -346,8 +382,17 @@ class FileDownlink final : public FileDownlinkComponentBase {
     //! File downlink queue
     Os::Queue m_fileQueue;
 
-    //! Buffer's memory backing
-    U8 m_memoryStore[COUNT_PACKET_TYPE][FILEDOWNLINK_INTERNAL_BUFFER_SIZE];
+    //! Buffer's memory backing, one buffer per packet of the send window
+    U8 m_memoryStore[FILEDOWNLINK_WINDOW_SIZE][FILEDOWNLINK_INTERNAL_BUFFER_SIZE];
+
+    //! State of the buffers of the send window
+    BufferSlot m_slots[FILEDOWNLINK_WINDOW_SIZE];
+
+    //! Number of buffers sent and not yet returned, excluding those out of service
+    U32 m_inFlight;
+
+    //! Number of buffers not returned in time, out of service until they return
+    U32 m_stranded;
 
     //! The mode
     Mode m_mode;
@@ -379,22 +424,19 @@ class FileDownlink final : public FileDownlinkComponentBase {
     //! rate (milliseconds) at which we are running
     U32 m_cycleTime;
 
-    ////! Buffer for sending file data
-    Fw::Buffer m_buffer;
-
     //! Buffer size for file data
     U32 m_bufferSize;
 
     //! Current byte offset in file
-    U32 m_byteOffset;
+    FwFileOffsetType m_byteOffset;
 
     //! Amount of bytes left to read
-    U32 m_endOffset;
+    FwFileOffsetType m_endOffset;
 
     //! Set to true when all data packets have been sent
     Fw::FilePacket::Type m_lastCompletedType;
 
-    //! Last buffer used
+    //! Context of the next buffer sent, unique to each packet
     U32 m_lastBufferId;
 
     //! Current in progress file entry from queue
@@ -22,4 +22,9 @@ void FileDownlink::Warnings ::fileRead(const Os::File::Status status) {
     this->warning();
 }
 
+void FileDownlink::Warnings ::buffersStranded(const U32 count) {
+    this->m_fileDownlink->log_WARNING_HI_BuffersStranded(count);
+    this->warning();
+}
+
 }  // namespace Svc
@@ -34,6 +34,26 @@ TEST(FileDownlink, SendFilePort) {
     tester.sendFilePort();
 }
 
+TEST(FileDownlink, DownlinkWindow) {
+    Svc::FileDownlinkTester tester;
+    tester.downlinkWindow();
+}
+
+TEST(FileDownlink, StrandBuffers) {
+    Svc::FileDownlinkTester tester;
+    tester.strandBuffers();
+}
+
+TEST(FileDownlink, NoBuffers) {
+    Svc::FileDownlinkTester tester;
+    tester.noBuffers();
+}
+
+TEST(FileDownlink, ReadAhead) {
+    Svc::FileDownlinkTester tester;
+    tester.readAhead();
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -11,6 +11,8 @@
 
 #include <unistd.h>
 #include <cerrno>
+#include <cstring>
+#include <limits>
 
 #include "FileDownlinkTester.hpp"
 
@@ -28,7 +30,10 @@ namespace Svc {
 // ----------------------------------------------------------------------
 
 FileDownlinkTester ::FileDownlinkTester()
-    : FileDownlinkGTestBase("Tester", MAX_HISTORY_SIZE), component("FileDownlink"), buffers_index(0) {
+    : FileDownlinkGTestBase("Tester", MAX_HISTORY_SIZE), component("FileDownlink"),
+      buffers_index(0),
+      holdBuffers(false),
+      heldCount(0) {
     this->component.configure(COOLDOWN_MS, CYCLE_MS, 10);
     this->connectPorts();
     this->initComponents();
@@ -226,6 +231,22 @@ void FileDownlinkTester ::downlinkPartial() {
     // Assert idle mode
     ASSERT_EQ(FileDownlink::Mode::IDLE, this->component.m_mode.get());
 
+    // A length reaching past the largest file offset is clamped to the end of the file
+    this->clearHistory();
+    const FwFileOffsetType largest = std::numeric_limits<FwFileOffsetType>::max();
+    const U32 tailSize = static_cast<U32>(sizeof(data)) - offset;
+    this->sendFilePartial(sourceFileName, destFileName, Fw::CmdResponse::OK, offset, largest);
+    ASSERT_EVENTS_DownlinkPartialWarning_SIZE(1);
+    ASSERT_EVENTS_DownlinkPartialWarning(0, offset, largest, sizeof(data), sourceFileName, destFileName);
+    ASSERT_EVENTS_SendStarted_SIZE(1);
+    ASSERT_EVENTS_SendStarted(0, tailSize, sourceFileName, destFileName);
+    History<Fw::FilePacket::DataPacket> tailPackets(MAX_HISTORY_SIZE);
+    CFDP::Checksum tailChecksum;
+    tailChecksum.update(&data[offset], offset, tailSize);
+    validatePacketHistory(*this->fromPortHistory_bufferSendOut, tailPackets, Fw::FilePacket::T_END, 3, tailChecksum,
+                          offset);
+    ASSERT_EQ(FileDownlink::Mode::IDLE, this->component.m_mode.get());
+
     // Remove the outgoing file
     this->removeFile(sourceFileName);
 }
@@ -286,6 +307,260 @@ void FileDownlinkTester ::sendFilePort() {
     this->removeFile(sourceFileName);
 }
 
+void FileDownlinkTester ::downlinkWindow() {
+    // Create a file spanning several data packets
+    const char* const sourceFileName = "source.bin";
+    const char* const destFileName = "dest.bin";
+    U8 data[1800];
+    for (U32 i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<U8>(i * 7);
+    }
+    FileBuffer fileBufferOut(data, sizeof(data));
+    fileBufferOut.write(sourceFileName);
+    const U32 dataSize = static_cast<U32>(FILEDOWNLINK_INTERNAL_BUFFER_SIZE - Fw::FilePacket::DataPacket::HEADERSIZE -
+                                          sizeof(FwPacketDescriptorType));
+    const U32 numDataPackets = static_cast<U32>((sizeof(data) + dataSize - 1) / dataSize);
+    const U32 numPackets = numDataPackets + 2;
+    ASSERT_LE(numPackets, MAX_HISTORY_SIZE);
+
+    // Hold the sent buffers so that the test chooses when and in which order they return
+    this->holdBuffers = true;
+    Fw::CmdStringArg sourceCmdStringArg(sourceFileName);
+    Fw::CmdStringArg destCmdStringArg(destFileName);
+    this->sendCmd_SendFile(INSTANCE, CMD_SEQ, sourceCmdStringArg, destCmdStringArg);
+    this->component.doDispatch();
+    this->component.Run_handler(0, 0);
+
+    // The start packet is sent alone
+    ASSERT_from_bufferSendOut_SIZE(1);
+    ASSERT_EQ(FileDownlink::Mode::WAIT, this->component.m_mode.get());
+    this->returnHeldBuffer(0);
+
+    // The data and end packets then keep the window full. Return the newest packet first.
+    bool duplicateReturned = false;
+    while (this->heldCount > 0) {
+        const U32 sent = static_cast<U32>(this->fromPortHistory_bufferSendOut->size());
+        const U32 unreturned = numPackets - sent + this->heldCount;
+        ASSERT_EQ(FW_MIN(FILEDOWNLINK_WINDOW_SIZE, unreturned), this->heldCount);
+        ASSERT_EQ(this->heldCount, this->component.m_inFlight);
+        ASSERT_EQ(FileDownlink::Mode::WAIT, this->component.m_mode.get());
+        const Fw::Buffer returned = this->heldBuffers[this->heldCount - 1];
+        this->returnHeldBuffer(this->heldCount - 1);
+        // A second return of the same buffer is ignored
+        if (not duplicateReturned && this->heldCount > 0) {
+            const U32 inFlight = this->component.m_inFlight;
+            Fw::Buffer duplicate = returned;
+            this->invoke_to_bufferReturn(0, duplicate);
+            this->component.doDispatch();
+            ASSERT_EQ(inFlight, this->component.m_inFlight);
+            duplicateReturned = true;
+        }
+    }
+    ASSERT_EQ(FileDownlink::Mode::COOLDOWN, this->component.m_mode.get());
+    ASSERT_EQ(0U, this->component.m_inFlight);
+
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, FileDownlink::OPCODE_SENDFILE, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_FileSent_SIZE(1);
+    ASSERT_EVENTS_FileSent(0, sourceFileName, destFileName);
+
+    // Validate the packet history
+    History<Fw::FilePacket::DataPacket> dataPackets(MAX_HISTORY_SIZE);
+    CFDP::Checksum checksum;
+    fileBufferOut.getChecksum(checksum);
+    validatePacketHistory(*this->fromPortHistory_bufferSendOut, dataPackets, Fw::FilePacket::T_END, numPackets,
+                          checksum, 0);
+
+    // Compare the outgoing and incoming files
+    FileBuffer fileBufferIn(dataPackets);
+    ASSERT_EQ(true, FileBuffer::compare(fileBufferIn, fileBufferOut));
+
+    // Remove the outgoing file
+    this->removeFile(sourceFileName);
+}
+
+void FileDownlinkTester ::strandBuffers() {
+    // Create a file of more data packets than fit in the window
+    const char* const sourceFileName = "source.bin";
+    const char* const destFileName = "dest.bin";
+    U8 data[4000];
+    for (U32 i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<U8>(i * 11);
+    }
+    Os::File osFile;
+    ASSERT_EQ(Os::File::OP_OK, osFile.open(sourceFileName, Os::File::OPEN_CREATE, Os::File::OVERWRITE));
+    FwSizeType size = sizeof(data);
+    ASSERT_EQ(Os::File::OP_OK, osFile.write(data, size));
+    osFile.close();
+
+    // Fill the window with data packets and hold them
+    this->holdBuffers = true;
+    Fw::CmdStringArg sourceCmdStringArg(sourceFileName);
+    Fw::CmdStringArg destCmdStringArg(destFileName);
+    this->sendCmd_SendFile(INSTANCE, CMD_SEQ, sourceCmdStringArg, destCmdStringArg);
+    this->component.doDispatch();
+    this->component.Run_handler(0, 0);
+    this->returnHeldBuffer(0);
+    ASSERT_EQ(FILEDOWNLINK_WINDOW_SIZE, this->heldCount);
+
+    // Make the next read fail: drop the blocks read ahead and close the file
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(this->component.m_file.m_blocks); i++) {
+        this->component.m_file.m_blocks[i].size = 0;
+    }
+    this->component.m_file.getOsFile().close();
+    this->returnHeldBuffer(0);
+    ASSERT_EQ(FileDownlink::Mode::COOLDOWN, this->component.m_mode.get());
+    ASSERT_EVENTS_SendDataFail_SIZE(1);
+    const U32 stale = this->heldCount;
+    ASSERT_GT(stale, 0U);
+    ASSERT_EQ(stale, this->component.m_inFlight);
+
+    // Queue the next file and wait out the cooldown
+    this->clearHistory();
+    this->sendCmd_SendFile(INSTANCE, CMD_SEQ, sourceCmdStringArg, destCmdStringArg);
+    this->component.doDispatch();
+    while (this->component.m_mode.get() == FileDownlink::Mode::COOLDOWN) {
+        this->component.Run_handler(0, 0);
+    }
+
+    // The next file waits for the buffers of the failed downlink until the timeout
+    for (U32 waited = 0; waited < FILEDOWNLINK_BUFFER_RETURN_TIMEOUT; waited += CYCLE_MS) {
+        this->component.Run_handler(0, 0);
+    }
+    ASSERT_from_bufferSendOut_SIZE(0);
+    ASSERT_EVENTS_BuffersStranded_SIZE(0);
+    ASSERT_EQ(FileDownlink::Mode::IDLE, this->component.m_mode.get());
+
+    // Then the buffers go out of service with a warning and the next file starts in the rest of the window
+    this->component.Run_handler(0, 0);
+    ASSERT_EVENTS_BuffersStranded_SIZE(1);
+    ASSERT_EVENTS_BuffersStranded(0, stale);
+    ASSERT_from_bufferSendOut_SIZE(1);
+    ASSERT_EQ(FileDownlink::Mode::WAIT, this->component.m_mode.get());
+    ASSERT_EQ(1U, this->component.m_inFlight);
+    ASSERT_EQ(stale, this->component.m_stranded);
+
+    // Packets of the next file never reuse a buffer out of service, and the window holds only the free buffers
+    const U32 window = FILEDOWNLINK_WINDOW_SIZE - stale;
+    this->returnHeldBuffer(stale);
+    ASSERT_EQ(stale + window, this->heldCount);
+    for (U32 i = stale; i < this->heldCount; i++) {
+        for (U32 j = 0; j < stale; j++) {
+            ASSERT_NE(this->heldBuffers[j].getData(), this->heldBuffers[i].getData());
+        }
+    }
+
+    // A buffer returned late goes back into service and widens the window from the next return on
+    const Fw::Buffer late = this->heldBuffers[0];
+    this->returnHeldBuffer(0);
+    ASSERT_EQ(stale - 1, this->component.m_stranded);
+    ASSERT_EQ(window, this->component.m_inFlight);
+    ASSERT_EQ(FileDownlink::Mode::WAIT, this->component.m_mode.get());
+    this->returnHeldBuffer(stale - 1);
+    ASSERT_EQ(window + 1, this->component.m_inFlight);
+    bool reused = false;
+    for (U32 i = stale - 1; i < this->heldCount; i++) {
+        reused = reused || (this->heldBuffers[i].getData() == late.getData());
+    }
+    ASSERT_TRUE(reused);
+
+    // The next file completes while the other buffers are still out of service
+    while (this->heldCount > stale - 1) {
+        this->returnHeldBuffer(stale - 1);
+    }
+    ASSERT_EQ(FileDownlink::Mode::COOLDOWN, this->component.m_mode.get());
+    ASSERT_EQ(0U, this->component.m_inFlight);
+    ASSERT_EQ(stale - 1, this->component.m_stranded);
+    ASSERT_EVENTS_FileSent_SIZE(1);
+    ASSERT_EVENTS_FileSent(0, sourceFileName, destFileName);
+
+    // The remaining buffers return to service
+    while (this->heldCount > 0) {
+        this->returnHeldBuffer(0);
+    }
+    ASSERT_EQ(0U, this->component.m_stranded);
+    ASSERT_EQ(FileDownlink::Mode::COOLDOWN, this->component.m_mode.get());
+
+    // Remove the outgoing file
+    this->removeFile(sourceFileName);
+}
+
+void FileDownlinkTester ::noBuffers() {
+    // Take every buffer out of service
+    for (U32 slot = 0; slot < FILEDOWNLINK_WINDOW_SIZE; slot++) {
+        this->component.m_slots[slot].inFlight = true;
+        this->component.m_slots[slot].stranded = true;
+    }
+    this->component.m_stranded = FILEDOWNLINK_WINDOW_SIZE;
+
+    // The next file fails without sending a packet
+    const char* const sourceFileName = "source.bin";
+    const char* const destFileName = "dest.bin";
+    Fw::CmdStringArg sourceCmdStringArg(sourceFileName);
+    Fw::CmdStringArg destCmdStringArg(destFileName);
+    this->sendCmd_SendFile(INSTANCE, CMD_SEQ, sourceCmdStringArg, destCmdStringArg);
+    this->component.doDispatch();
+    this->component.Run_handler(0, 0);
+    ASSERT_from_bufferSendOut_SIZE(0);
+    ASSERT_EVENTS_NoBuffers_SIZE(1);
+    ASSERT_EVENTS_NoBuffers(0, sourceFileName, destFileName);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, FileDownlink::OPCODE_SENDFILE, CMD_SEQ,
+                        (FILEDOWNLINK_COMMAND_FAILURES_DISABLED) ? Fw::CmdResponse::OK
+                                                                 : Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EQ(FileDownlink::Mode::IDLE, this->component.m_mode.get());
+}
+
+void FileDownlinkTester ::readAhead() {
+    // Create a file of several blocks that does not end on a block boundary
+    const char* const sourceFileName = "source.bin";
+    const U32 fileSize = 3 * FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE + 123;
+    U8* const data = new U8[fileSize];
+    for (U32 i = 0; i < fileSize; i++) {
+        data[i] = static_cast<U8>((i * 31) ^ (i >> 8));
+    }
+    Os::File osFile;
+    ASSERT_EQ(Os::File::OP_OK, osFile.open(sourceFileName, Os::File::OPEN_CREATE, Os::File::OVERWRITE));
+    FwSizeType size = fileSize;
+    ASSERT_EQ(Os::File::OP_OK, osFile.write(data, size));
+    osFile.close();
+
+    // Packet sized reads from start to end give the bytes and checksum of the file
+    FileDownlink::File file;
+    ASSERT_EQ(Os::File::OP_OK, file.open(sourceFileName, "dest.bin"));
+    ASSERT_EQ(fileSize, file.getSize());
+    const U32 packetSize = static_cast<U32>(FILEDOWNLINK_INTERNAL_BUFFER_SIZE - Fw::FilePacket::DataPacket::HEADERSIZE -
+                                            sizeof(FwPacketDescriptorType));
+    U8 buffer[3 * FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE];
+    for (U32 offset = 0; offset < fileSize; offset += packetSize) {
+        const U32 count = FW_MIN(packetSize, fileSize - offset);
+        ASSERT_EQ(Os::File::OP_OK, file.read(buffer, offset, count));
+        ASSERT_EQ(0, ::memcmp(buffer, &data[offset], count)) << offset;
+    }
+    CFDP::Checksum expected;
+    expected.update(data, 0, fileSize);
+    CFDP::Checksum checksum;
+    file.getChecksum(checksum);
+    ASSERT_EQ(expected, checksum);
+
+    // Reads backwards, across block boundaries, and larger than both blocks give the bytes of the file
+    const U32 block = FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE;
+    const U32 reads[][2] = {{0, 1},         {block - 1, 2},     {2 * block - 10, 20}, {5, block},
+                            {block, block}, {fileSize - 1, 1}, {1, sizeof(buffer)},  {fileSize - 200, 200}};
+    for (const auto& read : reads) {
+        ASSERT_EQ(Os::File::OP_OK, file.read(buffer, read[0], read[1]));
+        ASSERT_EQ(0, ::memcmp(buffer, &data[read[0]], read[1])) << read[0] << " " << read[1];
+    }
+
+    // Reads past the end of the file fail
+    ASSERT_EQ(Os::File::BAD_SIZE, file.read(buffer, fileSize - 10, 11));
+    ASSERT_EQ(Os::File::BAD_SIZE, file.read(buffer, fileSize + block, 1));
+
+    file.getOsFile().close();
+    delete[] data;
+    this->removeFile(sourceFileName);
+}
+
 // ----------------------------------------------------------------------
 // Handlers for from ports
 // ----------------------------------------------------------------------
@@ -300,7 +575,13 @@ void FileDownlinkTester ::from_bufferSendOut_handler(const FwIndexType portNum,
     Fw::Buffer buffer_new = buffer;
     buffer_new.setData(data);
     pushFromPortEntry_bufferSendOut(buffer_new);
-    invoke_to_bufferReturn(0, buffer);
+    if (this->holdBuffers) {
+        ASSERT_LT(this->heldCount, FW_NUM_ARRAY_ELEMENTS(this->heldBuffers));
+        this->heldBuffers[this->heldCount] = buffer;
+        this->heldCount++;
+    } else {
+        invoke_to_bufferReturn(0, buffer);
+    }
 }
 
 void FileDownlinkTester ::from_pingOut_handler(const FwIndexType portNum, U32 key) {
@@ -383,8 +664,8 @@ void FileDownlinkTester ::sendFile(const char* const sourceFileName,
 void FileDownlinkTester ::sendFilePartial(const char* const sourceFileName,  //!< The source file name
                                           const char* const destFileName,    //!< The destination file name
                                           const Fw::CmdResponse response,    //!< The expected command response
-                                          U32 startIndex,                    //!< The starting index
-                                          U32 length                         //!< The amount of bytes to downlink
+                                          FwFileOffsetType startIndex,       //!< The starting index
+                                          FwFileOffsetType length            //!< The amount of bytes to downlink
 ) {
     Fw::CmdStringArg sourceCmdStringArg(sourceFileName);
     Fw::CmdStringArg destCmdStringArg(destFileName);
@@ -413,6 +694,17 @@ void FileDownlinkTester ::cancel(const Fw::CmdResponse response) {
     ASSERT_CMD_RESPONSE(0, FileDownlink::OPCODE_CANCEL, CMD_SEQ, response);
 }
 
+void FileDownlinkTester ::returnHeldBuffer(const U32 index) {
+    ASSERT_LT(index, this->heldCount);
+    Fw::Buffer buffer = this->heldBuffers[index];
+    for (U32 i = index + 1; i < this->heldCount; i++) {
+        this->heldBuffers[i - 1] = this->heldBuffers[i];
+    }
+    this->heldCount--;
+    this->invoke_to_bufferReturn(0, buffer);
+    this->component.doDispatch();
+}
+
 void FileDownlinkTester ::removeFile(const char* const name) {
     const int status = ::unlink(name);
     if (status != 0) {
@@ -430,7 +722,7 @@ void FileDownlinkTester ::validatePacketHistory(const History<FromPortEntry_buff
                                                 const Fw::FilePacket::Type finalPacketType,
                                                 const size_t numPackets,
                                                 const CFDP::Checksum& checksum,
-                                                U32 startOffset) {
+                                                FwFileOffsetType startOffset) {
     FW_ASSERT(numPackets > 0);
 
     const size_t size = historyIn.size();
@@ -483,7 +775,7 @@ void FileDownlinkTester ::validateStartPacket(const Fw::Buffer& buffer) {
 void FileDownlinkTester ::validateDataPacket(const Fw::Buffer& buffer,
                                              Fw::FilePacket::DataPacket& dataPacket,
                                              const U32 sequenceIndex,
-                                             U32& byteOffset) {
+                                             FwFileOffsetType& byteOffset) {
     Fw::FilePacket filePacket;
     validateFilePacket(buffer, filePacket);
     const Fw::FilePacket::Header& header = filePacket.asHeader();
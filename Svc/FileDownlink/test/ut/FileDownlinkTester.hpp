@@ -17,8 +17,9 @@
 #include <Svc/FileDownlink/FileDownlink.hpp>
 #include "FileDownlinkGTestBase.hpp"
 
-#define MAX_HISTORY_SIZE 10
-#define FILE_BUFFER_CAPACITY 100
+// The window tests compare files of up to 1800 bytes, sent as more packets than the send window holds
+#define MAX_HISTORY_SIZE 20
+#define FILE_BUFFER_CAPACITY 2048
 
 namespace Svc {
 
@@ -107,6 +108,27 @@ class FileDownlinkTester : public FileDownlinkGTestBase {
     //!
     void sendFilePort();
 
+    //! Downlink a file of several data packets, holding the sent buffers
+    //! and returning them out of order
+    //! Verify that the send window is filled and the file is complete
+    //!
+    void downlinkWindow();
+
+    //! Fail a downlink while packets are in flight and return them late
+    //! Verify that the next file starts without reusing them after the timeout, and uses them once returned
+    //!
+    void strandBuffers();
+
+    //! Send a file while every buffer is out of service
+    //! Verify that the file fails without sending a packet
+    //!
+    void noBuffers();
+
+    //! Read a file spanning several read-ahead blocks in packet sized pieces and at scattered offsets
+    //! Verify the bytes read, the checksum, and the error past the end of the file
+    //!
+    void readAhead();
+
   private:
     // ----------------------------------------------------------------------
     // Handlers for from ports
@@ -152,8 +174,8 @@ class FileDownlinkTester : public FileDownlinkGTestBase {
     void sendFilePartial(const char* const sourceFileName,  //!< The source file name
                          const char* const destFileName,    //!< The destination file name
                          const Fw::CmdResponse response,    //!< The expected command response
-                         U32 startIndex,                    //!< The starting index
-                         U32 length                         //!< The amount of bytes to downlink
+                         FwFileOffsetType startIndex,       //!< The starting index
+                         FwFileOffsetType length            //!< The amount of bytes to downlink
     );
 
     //! Command the FileDownlink component to cancel a file downlink
@@ -167,6 +189,11 @@ class FileDownlinkTester : public FileDownlinkGTestBase {
     void removeFile(const char* const name  //!< The file name
     );
 
+    //! Return a held buffer to the component and dispatch the return
+    //!
+    void returnHeldBuffer(const U32 index  //!< The index of the held buffer
+    );
+
     // ----------------------------------------------------------------------
     // Private static methods
     // ----------------------------------------------------------------------
@@ -178,7 +205,7 @@ class FileDownlinkTester : public FileDownlinkGTestBase {
                                       const Fw::FilePacket::Type endPacketType,  //!< The expected ending packet type
                                       const size_t numPackets,                   //!< The expected number of packets
                                       const CFDP::Checksum& checksum,            //!< The expected checksum,
-                                      U32 startOffset                            //!< Starting byte offset
+                                      FwFileOffsetType startOffset               //!< Starting byte offset
     );
 
     //! Validate a file packet buffer and convert it to a file packet
@@ -198,7 +225,7 @@ class FileDownlinkTester : public FileDownlinkGTestBase {
     static void validateDataPacket(const Fw::Buffer& buffer,                //!< The buffer
                                    Fw::FilePacket::DataPacket& dataPacket,  //!< The buffer as a data packet
                                    const U32 sequenceIndex,                 //!< The expected sequence index
-                                   U32& byteOffset                          //!< The expected byte offset
+                                   FwFileOffsetType& byteOffset             //!< The expected byte offset
     );
 
     //! Validate an end data packet buffer
@@ -233,6 +260,18 @@ class FileDownlinkTester : public FileDownlinkGTestBase {
     //! The current sequence index
     //!
     U32 sequenceIndex;
+
+    //! Whether sent buffers are held instead of returned immediately
+    //!
+    bool holdBuffers;
+
+    //! Sent buffers not yet returned
+    //!
+    Fw::Buffer heldBuffers[MAX_HISTORY_SIZE];
+
+    //! Number of held buffers
+    //!
+    U32 heldCount;
 };
 
 }  // end namespace Svc
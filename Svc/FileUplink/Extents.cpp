@@ -0,0 +1,90 @@
+// ======================================================================
+// \title  Extents.cpp
+// \brief  cpp file for FileUplink::Extents
+// ======================================================================
+
+#include <Fw/Types/Assert.hpp>
+#include <Svc/FileUplink/FileUplink.hpp>
+
+namespace Svc {
+
+static_assert(FILEUPLINK_MAX_EXTENTS > 0, "FileUplink must track at least one received range");
+
+bool FileUplink::Extents::canInsert(const FwFileOffsetType start, const FwFileOffsetType end) const {
+    FW_ASSERT(start <= end);
+    if ((start == end) || (this->m_count < FILEUPLINK_MAX_EXTENTS)) {
+        return true;
+    }
+    // A full set can still take a range that merges with one it holds
+    const U32 index = this->firstReaching(start);
+    return (index < this->m_count) && (this->m_extents[index].start <= end);
+}
+
+bool FileUplink::Extents::insert(const FwFileOffsetType start, const FwFileOffsetType end) {
+    if (not this->canInsert(start, end)) {
+        return false;
+    }
+    if (start == end) {
+        return true;
+    }
+    // The ranges in [first, last) overlap or touch the new range
+    const U32 first = this->firstReaching(start);
+    U32 last = first;
+    while ((last < this->m_count) && (this->m_extents[last].start <= end)) {
+        ++last;
+    }
+    if (first == last) {
+        for (U32 i = this->m_count; i > first; --i) {
+            this->m_extents[i] = this->m_extents[i - 1];
+        }
+        this->m_extents[first].start = start;
+        this->m_extents[first].end = end;
+        ++this->m_count;
+        return true;
+    }
+    Extent& merged = this->m_extents[first];
+    merged.start = FW_MIN(merged.start, start);
+    merged.end = FW_MAX(this->m_extents[last - 1].end, end);
+    const U32 removed = last - first - 1;
+    for (U32 i = first + 1; i + removed < this->m_count; ++i) {
+        this->m_extents[i] = this->m_extents[i + removed];
+    }
+    this->m_count -= removed;
+    return true;
+}
+
+bool FileUplink::Extents::findGap(const FwFileOffsetType from,
+                                  const FwFileOffsetType to,
+                                  FwFileOffsetType& gapStart,
+                                  FwFileOffsetType& gapEnd) const {
+    FwFileOffsetType position = from;
+    U32 index = this->firstReaching(from);
+    if ((index < this->m_count) && (this->m_extents[index].start <= position)) {
+        // Ranges never touch, so the next range starts after the end of this one
+        position = this->m_extents[index].end;
+        ++index;
+    }
+    if (position >= to) {
+        return false;
+    }
+    gapStart = position;
+    gapEnd = (index < this->m_count) ? FW_MIN(this->m_extents[index].start, to) : to;
+    return true;
+}
+
+U32 FileUplink::Extents::firstReaching(const FwFileOffsetType offset) const {
+    // Ranges are disjoint and sorted, so their ends are increasing
+    U32 low = 0;
+    U32 high = this->m_count;
+    while (low < high) {
+        const U32 middle = low + (high - low) / 2;
+        if (this->m_extents[middle].end < offset) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+}  // namespace Svc
@@ -15,6 +15,7 @@
 #include <Svc/FileUplink/FileUplink.hpp>
 
 #include <cstring>
+#include <limits>
 namespace Svc {
 
 Os::File::Status FileUplink::File::open(const Fw::FilePacket::StartPacket& startPacket) {
@@ -27,12 +28,16 @@ Os::File::Status FileUplink::File::open(const Fw::FilePacket::StartPacket& start
     this->size = startPacket.getFileSize();
     CFDP::Checksum checksum;
     this->m_checksum = checksum;
+    // Data is placed by seeking to its offset, so every offset in the file must be a valid seek offset
+    if (this->size > static_cast<FwFileOffsetType>(std::numeric_limits<FwSignedSizeType>::max())) {
+        return Os::File::BAD_SIZE;
+    }
     return this->osFile.open(path, Os::File::OPEN_WRITE);
 }
 
-Os::File::Status FileUplink::File::write(const U8* const data, const U32 byteOffset, const U32 length) {
+Os::File::Status FileUplink::File::write(const U8* const data, const FwFileOffsetType byteOffset, const U32 length) {
     Os::File::Status status;
-    status = this->osFile.seek(byteOffset, Os::File::SeekType::ABSOLUTE);
+    status = this->osFile.seek(static_cast<FwSignedSizeType>(byteOffset), Os::File::SeekType::ABSOLUTE);
     if (status != Os::File::OP_OK) {
         return status;
     }
@@ -45,7 +50,6 @@ Os::File::Status FileUplink::File::write(const U8* const data, const U32 byteOff
     }
 
     FW_ASSERT(static_cast<U32>(intLength) == length, static_cast<FwAssertArgType>(intLength));
-    this->m_checksum.update(data, byteOffset, length);
     return Os::File::OP_OK;
 }
 
@@ -26,11 +26,38 @@ FileUplink::FileUplink(const char* const name)
       m_receiveMode(START),
       m_lastSequenceIndex(0),
       m_lastPacketWriteStatus(Os::File::MAX_STATUS),
+      m_waitForResend(false),
+      m_endReceived(false),
+      m_writeFailed(false),
       m_filesReceived(this),
       m_packetsReceived(this),
       m_warnings(this) {}
 
-FileUplink::~FileUplink() {}
+FileUplink::~FileUplink() {
+    this->m_writeBehind.stop();
+}
+
+// ----------------------------------------------------------------------
+// Write-behind
+// ----------------------------------------------------------------------
+
+void FileUplink::startWriteBehind(const FwTaskPriorityType priority,
+                                  const Os::Task::ParamType stackSize,
+                                  const Os::Task::ParamType cpuAffinity) {
+    this->m_writeBehind.start(this->m_file.osFile, priority, stackSize, cpuAffinity);
+}
+
+void FileUplink::stopWriteBehind() {
+    this->m_writeBehind.stop();
+}
+
+// ----------------------------------------------------------------------
+// Selective resend
+// ----------------------------------------------------------------------
+
+void FileUplink::setWaitForResend(const bool waitForResend) {
+    this->m_waitForResend = waitForResend;
+}
 
 // ----------------------------------------------------------------------
 // Handler implementations for user-defined typed input ports
@@ -101,8 +128,11 @@ void FileUplink::handleStartPacket(const Fw::FilePacket::StartPacket& startPacke
     this->log_WARNING_HI_InvalidReceiveMode_ThrottleClear();
     this->log_WARNING_HI_PacketOutOfBounds_ThrottleClear();
     this->log_WARNING_HI_PacketOutOfOrder_ThrottleClear();
+    this->log_WARNING_HI_TooManyExtents_ThrottleClear();
+    this->log_WARNING_HI_StagedWriteError_ThrottleClear();
     this->m_packetsReceived.packetReceived();
     if (this->m_receiveMode != START) {
+        (void)this->flushWrites();
         this->m_file.osFile.close();
         this->m_warnings.invalidReceiveMode(Fw::FilePacket::T_START);
     }
@@ -124,40 +154,83 @@ void FileUplink::handleDataPacket(const Fw::FilePacket::DataPacket& dataPacket)
 
     const U32 sequenceIndex = dataPacket.asHeader().getSequenceIndex();
 
-    // skip this packet if it is a duplicate and it has already been written
-    if (this->m_lastPacketWriteStatus == Os::File::OP_OK && this->checkDuplicatedPacket(sequenceIndex)) {
-        return;
+    // Packets resent to fill gaps after the end packet are outside the packet sequence
+    if (not this->m_endReceived) {
+        // skip this packet if it is a duplicate and it has already been written
+        if (this->m_lastPacketWriteStatus == Os::File::OP_OK && this->checkDuplicatedPacket(sequenceIndex)) {
+            return;
+        }
+        this->checkSequenceIndex(sequenceIndex);
     }
 
-    this->checkSequenceIndex(sequenceIndex);
-    const U32 byteOffset = dataPacket.getByteOffset();
+    const FwFileOffsetType byteOffset = dataPacket.getByteOffset();
     const U32 dataSize = dataPacket.getDataSize();
-    if (byteOffset + dataSize > this->m_file.size) {
+    if ((dataSize > this->m_file.size) || (byteOffset > this->m_file.size - dataSize)) {
         this->m_warnings.packetOutOfBounds(sequenceIndex, this->m_file.name);
         return;
     }
-    const Os::File::Status status = this->m_file.write(dataPacket.getData(), byteOffset, dataSize);
+    const FwFileOffsetType endOffset = byteOffset + dataSize;
+
+    // skip this packet if all of its data has already been received
+    FwFileOffsetType gapStart = byteOffset;
+    FwFileOffsetType gapEnd = byteOffset;
+    if ((dataSize > 0) && not this->m_extents.findGap(byteOffset, endOffset, gapStart, gapEnd)) {
+        this->m_warnings.packetDuplicate(sequenceIndex);
+        return;
+    }
+    // drop this packet if its range cannot be tracked, leaving a gap to be resent
+    if (not this->m_extents.canInsert(byteOffset, endOffset)) {
+        this->m_warnings.tooManyExtents(this->m_file.name, byteOffset);
+        return;
+    }
+
+    const U8* const data = dataPacket.getData();
+    const Os::File::Status status = this->writeData(data, byteOffset, dataSize);
+    this->m_lastPacketWriteStatus = status;
     if (status != Os::File::OP_OK) {
         this->m_warnings.fileWrite(this->m_file.name);
+        return;
     }
 
-    this->m_lastPacketWriteStatus = status;
+    // Add each byte of the file to the checksum once, whatever the order and overlap of the packets
+    FwFileOffsetType position = byteOffset;
+    while (this->m_extents.findGap(position, endOffset, gapStart, gapEnd)) {
+        this->m_file.updateChecksum(&data[gapStart - byteOffset], gapStart, static_cast<U32>(gapEnd - gapStart));
+        position = gapEnd;
+    }
+    const bool inserted = this->m_extents.insert(byteOffset, endOffset);
+    FW_ASSERT(inserted);
+
+    // A file waiting for resent data is finished by the packet that fills its last gap
+    if (this->m_endReceived && not this->m_extents.findGap(0, this->m_file.size, gapStart, gapEnd)) {
+        this->tlmWrite_FileGaps(0);
+        this->tlmWrite_MissingBytes(0);
+        this->finishFile();
+    }
 }
 
 void FileUplink::handleEndPacket(const Fw::FilePacket::EndPacket& endPacket) {
     this->m_packetsReceived.packetReceived();
-    if (this->m_receiveMode == DATA) {
-        this->m_filesReceived.fileReceived();
-        this->checkSequenceIndex(endPacket.asHeader().getSequenceIndex());
-        this->compareChecksums(endPacket);
-        this->log_ACTIVITY_HI_FileReceived(this->m_file.name);
-        if (this->isConnected_fileAnnounce_OutputPort(0)) {
-            this->fileAnnounce_out(0, this->m_file.name);
-        }
-    } else {
+    if (this->m_receiveMode != DATA) {
         this->m_warnings.invalidReceiveMode(Fw::FilePacket::T_END);
+        this->goToStartMode();
+        return;
+    }
+    // An end packet resent while gaps are being filled is outside the packet sequence
+    if (not this->m_endReceived) {
+        this->checkSequenceIndex(endPacket.asHeader().getSequenceIndex());
+    }
+    this->m_endReceived = true;
+    endPacket.getChecksum(this->m_endChecksum);
+    // A file with data that could not be written is finished at once, since resent data cannot repair it
+    if ((this->flushWrites() != Os::File::OP_OK) || this->m_writeFailed) {
+        this->finishFile();
+        return;
+    }
+    // When waiting for resends, stay in DATA mode until the missing data is resent
+    if ((this->reportGaps() == 0) || not this->m_waitForResend) {
+        this->finishFile();
     }
-    this->goToStartMode();
 }
 
 void FileUplink::handleCancelPacket() {
@@ -183,26 +256,103 @@ bool FileUplink::checkDuplicatedPacket(const U32 sequenceIndex) {
     return false;
 }
 
-void FileUplink::compareChecksums(const Fw::FilePacket::EndPacket& endPacket) {
-    CFDP::Checksum computed, stored;
+void FileUplink::compareChecksums() {
+    CFDP::Checksum computed;
     this->m_file.getChecksum(computed);
-    endPacket.getChecksum(stored);
-    if (computed != stored) {
-        this->m_warnings.badChecksum(computed.getValue(), stored.getValue());
+    if (computed != this->m_endChecksum) {
+        this->m_warnings.badChecksum(computed.getValue(), this->m_endChecksum.getValue());
+    }
+}
+
+U32 FileUplink::reportGaps() {
+    U32 gaps = 0;
+    FwFileOffsetType missing = 0;
+    FwFileOffsetType position = 0;
+    FwFileOffsetType gapStart = 0;
+    FwFileOffsetType gapEnd = 0;
+    while (this->m_extents.findGap(position, this->m_file.size, gapStart, gapEnd)) {
+        this->log_ACTIVITY_LO_FileGap(this->m_file.name, gapStart, gapEnd - gapStart);
+        ++gaps;
+        missing += gapEnd - gapStart;
+        position = gapEnd;
+    }
+    if (gaps > 0) {
+        this->log_WARNING_LO_FileIncomplete(this->m_file.name, gaps, missing);
+        this->tlmWrite_FileGaps(gaps);
+        this->tlmWrite_MissingBytes(missing);
+    }
+    return gaps;
+}
+
+void FileUplink::finishFile() {
+    const Os::File::Status status = this->flushWrites();
+    if ((status != Os::File::OP_OK) || this->m_writeFailed) {
+        this->m_warnings.fileNotAnnounced(this->m_file.name);
+        this->goToStartMode();
+        return;
+    }
+    this->m_filesReceived.fileReceived();
+    this->compareChecksums();
+    this->log_ACTIVITY_HI_FileReceived(this->m_file.name);
+    if (this->isConnected_fileAnnounce_OutputPort(0)) {
+        this->fileAnnounce_out(0, this->m_file.name);
+    }
+    this->goToStartMode();
+}
+
+Os::File::Status FileUplink::writeData(const U8* const data, const FwFileOffsetType byteOffset, const U32 length) {
+    if (not this->m_writeBehind.isRunning()) {
+        return this->m_file.write(data, byteOffset, length);
+    }
+    // Staged data is accepted; a write that fails later fails the whole file
+    this->m_writeBehind.stage(data, byteOffset, length);
+    U32 depth = 0;
+    U32 latency = 0;
+    this->m_writeBehind.getStatistics(depth, latency);
+    this->tlmWrite_WriteBehindDepth(depth);
+    this->tlmWrite_WriteLatency(latency);
+    (void)this->takeWriteFailure();
+    return Os::File::OP_OK;
+}
+
+Os::File::Status FileUplink::takeWriteFailure() {
+    FwFileOffsetType byteOffset = 0;
+    U32 length = 0;
+    const Os::File::Status status = this->m_writeBehind.takeFailure(byteOffset, length);
+    if (status != Os::File::OP_OK) {
+        // The range is already counted as received, so the file cannot be completed by resending it
+        this->m_writeFailed = true;
+        this->m_warnings.stagedWrite(this->m_file.name, byteOffset, length);
+    }
+    return status;
+}
+
+Os::File::Status FileUplink::flushWrites() {
+    if (not this->m_writeBehind.isRunning()) {
+        return Os::File::OP_OK;
     }
+    this->m_writeBehind.drain();
+    return this->takeWriteFailure();
 }
 
 void FileUplink::goToStartMode() {
+    (void)this->flushWrites();
     this->m_file.osFile.close();
     this->m_receiveMode = START;
     this->m_lastSequenceIndex = 0;
     this->m_lastPacketWriteStatus = Os::File::MAX_STATUS;
+    this->m_extents.clear();
+    this->m_endReceived = false;
+    this->m_writeFailed = false;
 }
 
 void FileUplink::goToDataMode() {
     this->m_receiveMode = DATA;
     this->m_lastSequenceIndex = 0;
     this->m_lastPacketWriteStatus = Os::File::MAX_STATUS;
+    this->m_extents.clear();
+    this->m_endReceived = false;
+    this->m_writeFailed = false;
 }
 
 }  // namespace Svc
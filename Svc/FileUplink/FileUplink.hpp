@@ -14,8 +14,12 @@
 #define Svc_FileUplink_HPP
 
 #include <Fw/FilePacket/FilePacket.hpp>
+#include <Os/Condition.hpp>
 #include <Os/File.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
 #include <Svc/FileUplink/FileUplinkComponentAc.hpp>
+#include <config/FileUplinkCfg.hpp>
 
 namespace Svc {
 
@@ -36,7 +40,7 @@ class FileUplink final : public FileUplinkComponentBase {
 
       public:
         //! The file size
-        U32 size;
+        FwFileOffsetType size;
 
         //! The file name
         Fw::LogStringArg name;
@@ -52,13 +56,172 @@ class FileUplink final : public FileUplinkComponentBase {
         //! Open the OS file for writing and initialize the checksum
         Os::File::Status open(const Fw::FilePacket::StartPacket& startPacket);
 
-        //! Write bytes into the OS file and update the checksum
-        Os::File::Status write(const U8* const data, const U32 byteOffset, const U32 length);
+        //! Write bytes into the OS file
+        Os::File::Status write(const U8* const data, const FwFileOffsetType byteOffset, const U32 length);
+
+        //! Add bytes at an offset in the file to the checksum. Each byte of the file must be added once.
+        void updateChecksum(const U8* const data, const FwFileOffsetType byteOffset, const U32 length) {
+            this->m_checksum.update(data, byteOffset, length);
+        }
 
         //! Get the checksum
         void getChecksum(::CFDP::Checksum& checksum) { checksum = this->m_checksum; }
     };
 
+    //! The byte ranges of the file received so far, kept sorted and merged so that no two ranges overlap or touch
+    class Extents {
+        friend class FileUplinkTester;
+
+      public:
+        //! Construct an empty set of ranges
+        Extents() : m_count(0) {}
+
+      public:
+        //! Remove all ranges
+        void clear() { this->m_count = 0; }
+
+        //! Get the number of ranges
+        U32 getCount() const { return this->m_count; }
+
+        //! Check whether the range [start, end) can be added without exceeding FILEUPLINK_MAX_EXTENTS
+        bool canInsert(const FwFileOffsetType start, const FwFileOffsetType end) const;
+
+        //! Add the range [start, end), merging it with the ranges it overlaps or touches
+        //! \return false, leaving the set unchanged, if the range cannot be added
+        bool insert(const FwFileOffsetType start, const FwFileOffsetType end);
+
+        //! Find the first range of bytes in [from, to) that is not in the set
+        //! \return true if such a range was found and stored in gapStart and gapEnd
+        bool findGap(const FwFileOffsetType from,  //!< The start of the range searched
+                     const FwFileOffsetType to,    //!< The end of the range searched
+                     FwFileOffsetType& gapStart,   //!< The start of the gap found
+                     FwFileOffsetType& gapEnd      //!< The end of the gap found
+        ) const;
+
+      private:
+        //! A range [start, end) of the file
+        struct Extent {
+            FwFileOffsetType start;  //!< Offset of the first byte of the range
+            FwFileOffsetType end;    //!< Offset one past the last byte of the range
+        };
+
+        //! Find the first range that ends at or after an offset
+        //! \return The index of the range, or the number of ranges if there is none
+        U32 firstReaching(const FwFileOffsetType offset) const;
+
+        //! The ranges in increasing order
+        Extent m_extents[FILEUPLINK_MAX_EXTENTS];
+
+        //! The number of ranges
+        U32 m_count;
+    };
+
+    //! A task that writes received data to the file behind the component thread. Data is copied into a staging
+    //! arena and queued, so the buffer holding it can be returned before the write completes.
+    class WriteBehind {
+        friend class FileUplinkTester;
+
+      public:
+        //! Construct a stopped write-behind task
+        WriteBehind();
+
+      public:
+        //! Start the task writing to a file
+        void start(Os::File& osFile,                    //!< The file written
+                   const FwTaskPriorityType priority,    //!< The task priority
+                   const Os::Task::ParamType stackSize,  //!< The task stack size
+                   const Os::Task::ParamType cpuAffinity  //!< The task CPU affinity
+        );
+
+        //! Stop the task once it has written all queued data, and wait for it to exit
+        void stop();
+
+        //! Check whether the task is running
+        bool isRunning() const { return this->m_running; }
+
+        //! Copy data into the arena and queue it to be written at an offset in the file, waiting while the queue
+        //! or the arena is full
+        void stage(const U8* const data, const FwFileOffsetType byteOffset, const U32 length);
+
+        //! Wait until all queued data has been written
+        void drain();
+
+        //! Take the first write that failed since the last call
+        //! \return The status of the failed write, or OP_OK if no write failed
+        Os::File::Status takeFailure(FwFileOffsetType& byteOffset,  //!< The offset in the file of the failed write
+                                     U32& length                    //!< The length of the failed write
+        );
+
+        //! Get the number of queued writes and the longest write in microseconds since the last call
+        void getStatistics(U32& depth, U32& maxLatency);
+
+      private:
+        //! A write waiting in the queue
+        struct Pending {
+            FwFileOffsetType byteOffset;  //!< The offset in the file of the data
+            U32 arenaOffset;              //!< The offset in the arena of the data
+            U32 length;                   //!< The length of the data
+        };
+
+        //! The task entry point
+        static void taskEntry(void* ptr);
+
+        //! Write queued data until stopped
+        void run();
+
+        //! Find space for data in the arena. Must be called with the mutex held.
+        //! \return true if the space was found and stored in arenaOffset
+        bool allocate(const U32 length, U32& arenaOffset) const;
+
+        //! The file written
+        Os::File* m_osFile;
+
+        //! The task
+        Os::Task m_task;
+
+        //! Protects the queue, the arena allocation and the statistics
+        Os::Mutex m_mutex;
+
+        //! Signaled when a write is queued or the task is stopped
+        Os::ConditionVariable m_queued;
+
+        //! Signaled when a write completes
+        Os::ConditionVariable m_written;
+
+        //! The queued writes in order, starting at m_head
+        Pending m_queue[FILEUPLINK_WRITE_BEHIND_QUEUE_DEPTH];
+
+        //! The index of the oldest queued write
+        U32 m_head;
+
+        //! The number of queued writes
+        U32 m_count;
+
+        //! The offset in the arena one past the data of the newest queued write
+        U32 m_arenaEnd;
+
+        //! The status of the first write that failed since it was last taken
+        Os::File::Status m_status;
+
+        //! The offset in the file of the first write that failed since it was last taken
+        FwFileOffsetType m_failedOffset;
+
+        //! The length of the first write that failed since it was last taken
+        U32 m_failedLength;
+
+        //! The longest write in microseconds since the statistics were last read
+        U32 m_maxLatency;
+
+        //! Whether the task is running
+        bool m_running;
+
+        //! Whether the task has been asked to stop
+        bool m_quit;
+
+        //! The staging arena holding the queued data
+        U8 m_arena[FILEUPLINK_WRITE_BEHIND_ARENA_SIZE];
+    };
+
     //! Object to record files received
     class FilesReceived {
         friend class FileUplinkTester;
@@ -135,6 +298,15 @@ class FileUplink final : public FileUplinkComponentBase {
         //! Record a Bad Checksum warning
         void badChecksum(const U32 computed, const U32 read);
 
+        //! Record a Too Many Extents warning
+        void tooManyExtents(Fw::LogStringArg& fileName, const FwFileOffsetType byteOffset);
+
+        //! Record a Staged Write Error warning
+        void stagedWrite(Fw::LogStringArg& fileName, const FwFileOffsetType byteOffset, const U32 length);
+
+        //! Record a File Not Announced warning
+        void fileNotAnnounced(Fw::LogStringArg& fileName);
+
       private:
         //! Record a warning
         void warning() {
@@ -160,10 +332,36 @@ class FileUplink final : public FileUplinkComponentBase {
     FileUplink(const char* const name  //!< The component name
     );
 
-    //! Destroy object FileUplink
+    //! Destroy object FileUplink, stopping the write-behind task if it is running
     //!
     ~FileUplink();
 
+  public:
+    // ----------------------------------------------------------------------
+    // Write-behind
+    // ----------------------------------------------------------------------
+
+    //! Start a task that writes received data to files, so that packet buffers are returned once their data is
+    //! staged rather than once it is written. Without it, data is written on the component thread.
+    void startWriteBehind(const FwTaskPriorityType priority = Os::Task::TASK_PRIORITY_DEFAULT,  //!< The priority
+                          const Os::Task::ParamType stackSize = Os::Task::TASK_DEFAULT,  //!< The stack size
+                          const Os::Task::ParamType cpuAffinity = Os::Task::TASK_DEFAULT  //!< The CPU affinity
+    );
+
+    //! Stop the write-behind task once it has written all staged data. Call after the component task has exited.
+    void stopWriteBehind();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Selective resend
+    // ----------------------------------------------------------------------
+
+    //! Set whether a file whose END packet arrives with data missing stays open until the missing data is resent.
+    //! Off by default: the END packet reports the missing ranges and finishes the file, which then fails its
+    //! checksum. Turn it on only when the ground resends missing ranges, or cancels the uplink, on FileIncomplete.
+    void setWaitForResend(const bool waitForResend  //!< Whether to wait for missing data to be resent
+    );
+
   private:
     // ----------------------------------------------------------------------
     // Handler implementations for user-defined typed input ports
@@ -204,8 +402,28 @@ class FileUplink final : public FileUplinkComponentBase {
     //! Check if a received packet is a duplicate
     bool checkDuplicatedPacket(const U32 sequenceIndex);
 
-    //! Compare checksums
-    void compareChecksums(const Fw::FilePacket::EndPacket& endPacket);
+    //! Compare the computed checksum to the checksum of the end packet
+    void compareChecksums();
+
+    //! Report the ranges of the file not yet received
+    //! \return The number of ranges missing
+    U32 reportGaps();
+
+    //! Check, close and announce a file once its data and end packet have all been received. A file with data
+    //! that could not be written is closed without being announced.
+    void finishFile();
+
+    //! Write data received to the file, directly or through the write-behind task
+    //! \return The status of the write, or OP_OK once the data is staged for the write-behind task
+    Os::File::Status writeData(const U8* const data, const FwFileOffsetType byteOffset, const U32 length);
+
+    //! Report a staged write that failed and mark the file as failed
+    //! \return The status of the failed write, or OP_OK if no staged write failed
+    Os::File::Status takeWriteFailure();
+
+    //! Wait for the write-behind task to write all staged data to the file
+    //! \return The status of a staged write that failed, or OP_OK
+    Os::File::Status flushWrites();
 
     //! Go to START mode
     void goToStartMode();
@@ -230,6 +448,21 @@ class FileUplink final : public FileUplinkComponentBase {
     //! The file being assembled
     File m_file;
 
+    //! The byte ranges of the file received
+    Extents m_extents;
+
+    //! Whether a file with data missing at its end packet waits for the missing data to be resent
+    bool m_waitForResend;
+
+    //! Whether the end packet of the file has been received
+    bool m_endReceived;
+
+    //! Whether data staged for the file could not be written
+    bool m_writeFailed;
+
+    //! The checksum carried by the end packet
+    CFDP::Checksum m_endChecksum;
+
     //! The total number of files received
     FilesReceived m_filesReceived;
 
@@ -238,6 +471,9 @@ class FileUplink final : public FileUplinkComponentBase {
 
     //! The total number of warnings
     Warnings m_warnings;
+
+    //! The write-behind task
+    WriteBehind m_writeBehind;
 };
 
 }  // namespace Svc
@@ -50,4 +50,21 @@ void FileUplink::Warnings::badChecksum(const U32 computed, const U32 read) {
     this->warning();
 }
 
+void FileUplink::Warnings::tooManyExtents(Fw::LogStringArg& fileName, const FwFileOffsetType byteOffset) {
+    this->m_fileUplink->log_WARNING_HI_TooManyExtents(fileName, byteOffset);
+    this->warning();
+}
+
+void FileUplink::Warnings::stagedWrite(Fw::LogStringArg& fileName,
+                                       const FwFileOffsetType byteOffset,
+                                       const U32 length) {
+    this->m_fileUplink->log_WARNING_HI_StagedWriteError(fileName, byteOffset, length);
+    this->warning();
+}
+
+void FileUplink::Warnings::fileNotAnnounced(Fw::LogStringArg& fileName) {
+    this->m_fileUplink->log_WARNING_HI_FileNotAnnounced(fileName);
+    this->warning();
+}
+
 }  // namespace Svc
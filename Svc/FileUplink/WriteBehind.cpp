@@ -0,0 +1,172 @@
+// ======================================================================
+// \title  WriteBehind.cpp
+// \brief  cpp file for FileUplink::WriteBehind
+// ======================================================================
+
+#include <Fw/Types/Assert.hpp>
+#include <Os/RawTime.hpp>
+#include <Os/TaskString.hpp>
+#include <Svc/FileUplink/FileUplink.hpp>
+
+#include <cstring>
+
+namespace Svc {
+
+static_assert(FILEUPLINK_WRITE_BEHIND_QUEUE_DEPTH > 0, "The write-behind queue must hold at least one write");
+static_assert(FILEUPLINK_WRITE_BEHIND_ARENA_SIZE >= FW_FILE_BUFFER_MAX_SIZE,
+              "The write-behind arena must hold the data of any file packet");
+
+FileUplink::WriteBehind::WriteBehind()
+    : m_osFile(nullptr),
+      m_head(0),
+      m_count(0),
+      m_arenaEnd(0),
+      m_status(Os::File::OP_OK),
+      m_failedOffset(0),
+      m_failedLength(0),
+      m_maxLatency(0),
+      m_running(false),
+      m_quit(false) {}
+
+void FileUplink::WriteBehind::start(Os::File& osFile,
+                                    const FwTaskPriorityType priority,
+                                    const Os::Task::ParamType stackSize,
+                                    const Os::Task::ParamType cpuAffinity) {
+    FW_ASSERT(not this->m_running);
+    this->m_osFile = &osFile;
+    this->m_quit = false;
+    Os::TaskString name("FileUplinkWB");
+    Os::Task::Arguments arguments(name, taskEntry, this, priority, stackSize, cpuAffinity);
+    const Os::Task::Status status = this->m_task.start(arguments);
+    FW_ASSERT(status == Os::Task::OP_OK, status);
+    this->m_running = true;
+}
+
+void FileUplink::WriteBehind::stop() {
+    if (not this->m_running) {
+        return;
+    }
+    this->m_mutex.lock();
+    this->m_quit = true;
+    this->m_queued.notify();
+    this->m_mutex.unLock();
+    (void)this->m_task.join();
+    this->m_running = false;
+}
+
+void FileUplink::WriteBehind::stage(const U8* const data, const FwFileOffsetType byteOffset, const U32 length) {
+    FW_ASSERT(data != nullptr);
+    FW_ASSERT(length <= FILEUPLINK_WRITE_BEHIND_ARENA_SIZE, static_cast<FwAssertArgType>(length));
+    Os::ScopeLock lock(this->m_mutex);
+    U32 arenaOffset = 0;
+    while (not this->allocate(length, arenaOffset)) {
+        this->m_written.wait(this->m_mutex);
+    }
+    (void)::memcpy(&this->m_arena[arenaOffset], data, length);
+    Pending& pending = this->m_queue[(this->m_head + this->m_count) % FILEUPLINK_WRITE_BEHIND_QUEUE_DEPTH];
+    pending.byteOffset = byteOffset;
+    pending.arenaOffset = arenaOffset;
+    pending.length = length;
+    ++this->m_count;
+    this->m_arenaEnd = arenaOffset + length;
+    this->m_queued.notify();
+}
+
+void FileUplink::WriteBehind::drain() {
+    Os::ScopeLock lock(this->m_mutex);
+    while (this->m_count > 0) {
+        this->m_written.wait(this->m_mutex);
+    }
+}
+
+Os::File::Status FileUplink::WriteBehind::takeFailure(FwFileOffsetType& byteOffset, U32& length) {
+    Os::ScopeLock lock(this->m_mutex);
+    const Os::File::Status status = this->m_status;
+    byteOffset = this->m_failedOffset;
+    length = this->m_failedLength;
+    this->m_status = Os::File::OP_OK;
+    return status;
+}
+
+void FileUplink::WriteBehind::getStatistics(U32& depth, U32& maxLatency) {
+    Os::ScopeLock lock(this->m_mutex);
+    depth = this->m_count;
+    maxLatency = this->m_maxLatency;
+    this->m_maxLatency = 0;
+}
+
+void FileUplink::WriteBehind::taskEntry(void* ptr) {
+    FW_ASSERT(ptr != nullptr);
+    static_cast<WriteBehind*>(ptr)->run();
+}
+
+void FileUplink::WriteBehind::run() {
+    this->m_mutex.lock();
+    while (true) {
+        while ((this->m_count == 0) && not this->m_quit) {
+            this->m_queued.wait(this->m_mutex);
+        }
+        // Queued data is written before stopping
+        if (this->m_count == 0) {
+            break;
+        }
+        const Pending pending = this->m_queue[this->m_head];
+        // The arena bytes of a queued write are not reused until it completes, so they are written unlocked
+        this->m_mutex.unLock();
+
+        Os::RawTime start;
+        (void)start.now();
+        FwSizeType size = pending.length;
+        const Os::File::Status status =
+            this->m_osFile->writeAt(&this->m_arena[pending.arenaOffset], size,
+                                    static_cast<FwSizeType>(pending.byteOffset), Os::File::WaitType::NO_WAIT);
+        FW_ASSERT((status != Os::File::OP_OK) || (size == pending.length), static_cast<FwAssertArgType>(size));
+        Os::RawTime end;
+        (void)end.now();
+        U32 latency = 0;
+        (void)end.getDiffUsec(start, latency);
+
+        this->m_mutex.lock();
+        if ((this->m_status == Os::File::OP_OK) && (status != Os::File::OP_OK)) {
+            this->m_status = status;
+            this->m_failedOffset = pending.byteOffset;
+            this->m_failedLength = pending.length;
+        }
+        this->m_maxLatency = FW_MAX(this->m_maxLatency, latency);
+        this->m_head = (this->m_head + 1) % FILEUPLINK_WRITE_BEHIND_QUEUE_DEPTH;
+        --this->m_count;
+        this->m_written.notifyAll();
+    }
+    this->m_mutex.unLock();
+}
+
+bool FileUplink::WriteBehind::allocate(const U32 length, U32& arenaOffset) const {
+    if (this->m_count == 0) {
+        arenaOffset = 0;
+        return true;
+    }
+    if (this->m_count == FILEUPLINK_WRITE_BEHIND_QUEUE_DEPTH) {
+        return false;
+    }
+    // Data is queued in arena order, so the data in use runs from the oldest write to the end of the newest,
+    // wrapping to the start of the arena when the newest write ends at or before the oldest one starts
+    const U32 arenaStart = this->m_queue[this->m_head].arenaOffset;
+    if (this->m_arenaEnd > arenaStart) {
+        if (FILEUPLINK_WRITE_BEHIND_ARENA_SIZE - this->m_arenaEnd >= length) {
+            arenaOffset = this->m_arenaEnd;
+            return true;
+        }
+        if (arenaStart >= length) {
+            arenaOffset = 0;
+            return true;
+        }
+        return false;
+    }
+    if (arenaStart - this->m_arenaEnd >= length) {
+        arenaOffset = this->m_arenaEnd;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace Svc
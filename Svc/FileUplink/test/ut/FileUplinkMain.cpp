@@ -44,6 +44,11 @@ TEST(FileUplink, PacketOutOfBounds) {
     tester.packetOutOfBounds();
 }
 
+TEST(FileUplink, PacketEndOutOfBounds) {
+    Svc::FileUplinkTester tester;
+    tester.packetEndOutOfBounds();
+}
+
 TEST(FileUplink, PacketOutOfOrder) {
     Svc::FileUplinkTester tester;
     tester.packetOutOfOrder();
@@ -64,6 +69,26 @@ TEST(FileUplink, CancelPacketInDataMode) {
     tester.cancelPacketInDataMode();
 }
 
+TEST(FileUplink, Extents) {
+    Svc::FileUplinkTester tester;
+    tester.extents();
+}
+
+TEST(FileUplink, FileGaps) {
+    Svc::FileUplinkTester tester;
+    tester.fileGaps();
+}
+
+TEST(FileUplink, FileGapsNoResend) {
+    Svc::FileUplinkTester tester;
+    tester.fileGapsNoResend();
+}
+
+TEST(FileUplink, WriteBehind) {
+    Svc::FileUplinkTester tester;
+    tester.writeBehind();
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
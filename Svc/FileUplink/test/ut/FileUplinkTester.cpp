@@ -60,7 +60,7 @@ void FileUplinkTester ::sendFile() {
 
     // Send the data packets
     for (size_t i = 0; i < numPackets; ++i) {
-        const size_t byteOffset = i * PACKET_SIZE;
+        const FwFileOffsetType byteOffset = static_cast<FwFileOffsetType>(i * PACKET_SIZE);
         this->sendDataPacket(byteOffset, packetData[i]);
         ASSERT_TLM_SIZE(1);
         ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
@@ -107,7 +107,7 @@ void FileUplinkTester ::badChecksum() {
 
     // Send the data packets
     for (size_t i = 0; i < numPackets; ++i) {
-        const size_t byteOffset = i * PACKET_SIZE;
+        const FwFileOffsetType byteOffset = static_cast<FwFileOffsetType>(i * PACKET_SIZE);
         this->sendDataPacket(byteOffset, packetData[i]);
         ASSERT_TLM_SIZE(1);
         ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
@@ -164,7 +164,7 @@ void FileUplinkTester ::fileWriteError() {
     this->component.m_file.osFile.close();
 
     // Send the data packet (packet 1)
-    const size_t byteOffset = PACKET_SIZE;
+    const FwFileOffsetType byteOffset = PACKET_SIZE;
     this->sendDataPacket(byteOffset, packetData);
     ASSERT_TLM_SIZE(2);
     ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
@@ -198,7 +198,7 @@ void FileUplinkTester ::startPacketInDataMode() {
 
 void FileUplinkTester ::dataPacketInStartMode() {
     U8 packetData[PACKET_SIZE];
-    const size_t byteOffset = 0;
+    const FwFileOffsetType byteOffset = 0;
     this->sendDataPacket(byteOffset, packetData);
 
     ASSERT_TLM_SIZE(2);
@@ -233,7 +233,7 @@ void FileUplinkTester ::packetOutOfBounds() {
     ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
     ASSERT_EVENTS_SIZE(0);
 
-    const size_t byteOffset = 0;
+    const FwFileOffsetType byteOffset = 0;
     U8 packetData[PACKET_SIZE];
     this->sendDataPacket(byteOffset, packetData);
 
@@ -247,6 +247,41 @@ void FileUplinkTester ::packetOutOfBounds() {
     this->removeFile(destPath);
 }
 
+void FileUplinkTester ::packetEndOutOfBounds() {
+    const char* const sourcePath = "source.bin";
+    const char* const destPath = "dest.bin";
+    const size_t fileSize = PACKET_SIZE;
+
+    this->sendStartPacket(sourcePath, destPath, fileSize);
+    ASSERT_TLM_SIZE(1);
+    ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
+    ASSERT_EVENTS_SIZE(0);
+
+    // The packet ends one byte past the end of the file
+    U8 packetData[PACKET_SIZE] = {};
+    this->sendDataPacket(1, packetData);
+
+    ASSERT_TLM_SIZE(2);
+    ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
+    ASSERT_TLM_Warnings(0, 1);
+
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_PacketOutOfBounds(0, 1, destPath);
+
+    // The end of the packet wraps past the largest file offset
+    this->clearHistory();
+    this->sendDataPacket(std::numeric_limits<FwFileOffsetType>::max() - 1, packetData);
+
+    ASSERT_TLM_SIZE(2);
+    ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
+    ASSERT_TLM_Warnings(0, 2);
+
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_PacketOutOfBounds(0, 2, destPath);
+
+    this->removeFile(destPath);
+}
+
 void FileUplinkTester ::packetOutOfOrder() {
     const char* const sourcePath = "source.bin";
     const char* const destPath = "dest.bin";
@@ -263,7 +298,7 @@ void FileUplinkTester ::packetOutOfOrder() {
     ++this->sequenceIndex;
 
     // Send the data packet (packet 2)
-    const size_t byteOffset = PACKET_SIZE;
+    const FwFileOffsetType byteOffset = PACKET_SIZE;
     this->sendDataPacket(byteOffset, packetData);
     ASSERT_TLM_SIZE(2);
     ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
@@ -292,7 +327,7 @@ void FileUplinkTester ::packetDuplicated() {
     ASSERT_EQ(Os::File::MAX_STATUS, component.m_lastPacketWriteStatus);
 
     // Send data packet 1
-    const size_t byteOffset = 0;
+    const FwFileOffsetType byteOffset = 0;
     this->sendDataPacket(byteOffset, packetData);
     ASSERT_TLM_SIZE(1);
     ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
@@ -361,7 +396,7 @@ void FileUplinkTester ::cancelPacketInDataMode() {
     ASSERT_EVENTS_SIZE(0);
 
     // Send the data packet (packet 1)
-    const size_t byteOffset = PACKET_SIZE;
+    const FwFileOffsetType byteOffset = PACKET_SIZE;
     this->sendDataPacket(byteOffset, packetData);
     ASSERT_TLM_SIZE(1);
     ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
@@ -382,6 +417,213 @@ void FileUplinkTester ::cancelPacketInDataMode() {
     this->removeFile("test.bin");
 }
 
+void FileUplinkTester ::extents() {
+    FileUplink::Extents extents;
+    FwFileOffsetType gapStart = 0;
+    FwFileOffsetType gapEnd = 0;
+
+    // With nothing received the whole range is a gap
+    ASSERT_TRUE(extents.findGap(0, 50, gapStart, gapEnd));
+    ASSERT_EQ(0U, gapStart);
+    ASSERT_EQ(50U, gapEnd);
+
+    // Separate ranges leave gaps between them
+    ASSERT_TRUE(extents.insert(30, 40));
+    ASSERT_TRUE(extents.insert(10, 20));
+    ASSERT_EQ(2U, extents.getCount());
+    ASSERT_TRUE(extents.findGap(0, 50, gapStart, gapEnd));
+    ASSERT_EQ(0U, gapStart);
+    ASSERT_EQ(10U, gapEnd);
+    ASSERT_TRUE(extents.findGap(15, 50, gapStart, gapEnd));
+    ASSERT_EQ(20U, gapStart);
+    ASSERT_EQ(30U, gapEnd);
+    ASSERT_TRUE(extents.findGap(35, 50, gapStart, gapEnd));
+    ASSERT_EQ(40U, gapStart);
+    ASSERT_EQ(50U, gapEnd);
+    ASSERT_FALSE(extents.findGap(32, 40, gapStart, gapEnd));
+
+    // Empty ranges change nothing, and ranges that overlap or touch are merged
+    ASSERT_TRUE(extents.insert(25, 25));
+    ASSERT_EQ(2U, extents.getCount());
+    ASSERT_TRUE(extents.insert(5, 12));
+    ASSERT_EQ(2U, extents.getCount());
+    ASSERT_TRUE(extents.insert(20, 30));
+    ASSERT_EQ(1U, extents.getCount());
+    ASSERT_FALSE(extents.findGap(5, 40, gapStart, gapEnd));
+    ASSERT_TRUE(extents.findGap(0, 40, gapStart, gapEnd));
+    ASSERT_EQ(0U, gapStart);
+    ASSERT_EQ(5U, gapEnd);
+
+    // A full set takes only ranges that merge with ranges it holds
+    extents.clear();
+    ASSERT_EQ(0U, extents.getCount());
+    for (U32 i = 0; i < FILEUPLINK_MAX_EXTENTS; ++i) {
+        ASSERT_TRUE(extents.insert(2 * i, 2 * i + 1));
+    }
+    ASSERT_EQ(FILEUPLINK_MAX_EXTENTS, extents.getCount());
+    const FwFileOffsetType end = 2 * FILEUPLINK_MAX_EXTENTS;
+    ASSERT_FALSE(extents.canInsert(end + 1, end + 2));
+    ASSERT_FALSE(extents.insert(end + 1, end + 2));
+    ASSERT_EQ(FILEUPLINK_MAX_EXTENTS, extents.getCount());
+    ASSERT_TRUE(extents.insert(end - 1, end + 2));
+    ASSERT_EQ(FILEUPLINK_MAX_EXTENTS, extents.getCount());
+    ASSERT_TRUE(extents.insert(0, end));
+    ASSERT_EQ(1U, extents.getCount());
+    ASSERT_FALSE(extents.findGap(0, end + 2, gapStart, gapEnd));
+}
+
+void FileUplinkTester ::fileGaps() {
+    const char* const sourcePath = "source.bin";
+    const char* const destPath = "dest.bin";
+    U8 fileData[4 * PACKET_SIZE];
+    for (U32 i = 0; i < sizeof(fileData); ++i) {
+        fileData[i] = static_cast<U8>(i * 7 + 3);
+    }
+    const size_t fileSize = sizeof(fileData);
+    CFDP::Checksum checksum;
+    checksum.update(fileData, 0, fileSize);
+
+    this->component.setWaitForResend(true);
+
+    // Send the start packet
+    this->sendStartPacket(sourcePath, destPath, fileSize);
+    ASSERT_EVENTS_SIZE(0);
+
+    // Send the data packets out of file order, with one overlapping two others and the last one lost
+    const FwFileOffsetType offsets[] = {2 * PACKET_SIZE, 0, PACKET_SIZE / 2, PACKET_SIZE};
+    for (const FwFileOffsetType byteOffset : offsets) {
+        this->sendDataPacket(byteOffset, &fileData[byteOffset]);
+        ASSERT_TLM_SIZE(1);
+        ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
+        ASSERT_EVENTS_SIZE(0);
+    }
+
+    // The end packet reports the missing range and leaves the file open
+    this->sendEndPacket(checksum);
+    ASSERT_TLM_SIZE(3);
+    ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
+    ASSERT_TLM_FileGaps(0, 1);
+    ASSERT_TLM_MissingBytes(0, PACKET_SIZE);
+    ASSERT_TLM_FilesReceived_SIZE(0);
+    ASSERT_EVENTS_SIZE(2);
+    ASSERT_EVENTS_FileGap(0, destPath, 3 * PACKET_SIZE, PACKET_SIZE);
+    ASSERT_EVENTS_FileIncomplete(0, destPath, 1, PACKET_SIZE);
+    ASSERT_from_fileAnnounce_SIZE(0);
+    ASSERT_EQ(FileUplink::DATA, this->component.m_receiveMode);
+
+    // Resent data is outside the packet sequence, and data already received is dropped
+    this->sequenceIndex = 100;
+    this->sendDataPacket(0, fileData);
+    ASSERT_TLM_Warnings(0, 1);
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_PacketDuplicate(0, 100);
+
+    // Resending the missing packet completes the file
+    this->sendDataPacket(3 * PACKET_SIZE, &fileData[3 * PACKET_SIZE]);
+    ASSERT_TLM_FileGaps(0, 0);
+    ASSERT_TLM_MissingBytes(0, 0);
+    ASSERT_TLM_FilesReceived(0, 1);
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_FileReceived(0, destPath);
+    ASSERT_from_fileAnnounce_SIZE(1);
+    ASSERT_EQ(FileUplink::START, this->component.m_receiveMode);
+
+    this->verifyFileData(destPath, fileData, fileSize);
+    this->removeFile(destPath);
+}
+
+void FileUplinkTester ::fileGapsNoResend() {
+    const char* const sourcePath = "source.bin";
+    const char* const destPath = "dest.bin";
+    U8 fileData[3 * PACKET_SIZE];
+    for (U32 i = 0; i < sizeof(fileData); ++i) {
+        fileData[i] = static_cast<U8>(i * 7 + 3);
+    }
+    const size_t fileSize = sizeof(fileData);
+    CFDP::Checksum checksum;
+    checksum.update(fileData, 0, fileSize);
+    CFDP::Checksum received;
+    received.update(fileData, 0, 2 * PACKET_SIZE);
+
+    // Send the file with the last data packet lost
+    this->sendStartPacket(sourcePath, destPath, fileSize);
+    this->sendDataPacket(0, fileData);
+    this->sendDataPacket(PACKET_SIZE, &fileData[PACKET_SIZE]);
+    ASSERT_EVENTS_SIZE(0);
+
+    // Without waiting for resends, the end packet reports the missing range and finishes the file
+    this->sendEndPacket(checksum);
+    ASSERT_TLM_FileGaps(0, 1);
+    ASSERT_TLM_MissingBytes(0, PACKET_SIZE);
+    ASSERT_TLM_FilesReceived(0, 1);
+    ASSERT_EVENTS_SIZE(4);
+    ASSERT_EVENTS_FileGap(0, destPath, 2 * PACKET_SIZE, PACKET_SIZE);
+    ASSERT_EVENTS_FileIncomplete(0, destPath, 1, PACKET_SIZE);
+    ASSERT_EVENTS_BadChecksum(0, destPath, received.getValue(), checksum.getValue());
+    ASSERT_EVENTS_FileReceived(0, destPath);
+    ASSERT_from_fileAnnounce_SIZE(1);
+    ASSERT_EQ(FileUplink::START, this->component.m_receiveMode);
+
+    this->removeFile(destPath);
+}
+
+void FileUplinkTester ::writeBehind() {
+    const char* const sourcePath = "source.bin";
+    const char* const destPath = "dest.bin";
+    const U32 numPackets = 3;
+    U8 packetData[numPackets][PACKET_SIZE] = {{0, 1, 2, 3, 4}, {5, 6, 7, 8, 9}, {10, 11, 12, 13, 14}};
+    const U8* const linearPacketData = reinterpret_cast<U8*>(packetData);
+    const size_t fileSize = sizeof(packetData);
+    CFDP::Checksum checksum;
+    checksum.update(linearPacketData, 0, fileSize);
+
+    this->component.startWriteBehind();
+
+    // Staged data packets report the write-behind queue
+    this->sendStartPacket(sourcePath, destPath, fileSize);
+    ASSERT_EVENTS_SIZE(0);
+    for (U32 i = 0; i < numPackets; ++i) {
+        this->sendDataPacket(i * PACKET_SIZE, packetData[i]);
+        ASSERT_TLM_SIZE(3);
+        ASSERT_TLM_PacketsReceived(0, ++this->expectedPacketsReceived);
+        ASSERT_TLM_WriteBehindDepth_SIZE(1);
+        ASSERT_TLM_WriteLatency_SIZE(1);
+        ASSERT_EVENTS_SIZE(0);
+    }
+
+    // The end packet waits for the staged data to be written before announcing the file
+    this->sendEndPacket(checksum);
+    ASSERT_TLM_FilesReceived(0, 1);
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_FileReceived(0, destPath);
+    ASSERT_from_fileAnnounce_SIZE(1);
+    this->verifyFileData(destPath, linearPacketData, fileSize);
+
+    // A staged write that fails fails the file. The end packet finishes it without waiting for the missing
+    // packet, and the file is not announced.
+    this->sendStartPacket(sourcePath, destPath, fileSize);
+    this->sendDataPacket(0, packetData[0]);
+    this->component.m_writeBehind.drain();
+    this->component.m_file.osFile.close();
+    this->sendDataPacket(PACKET_SIZE, packetData[1]);
+    // The staged packet is accepted, and its write is reported as failed by this packet or by the end packet
+    ASSERT_EVENTS_FileWriteError_SIZE(0);
+    FwSizeType writeErrors = this->eventHistory_StagedWriteError->size();
+    this->sendEndPacket(checksum);
+    writeErrors += this->eventHistory_StagedWriteError->size();
+    ASSERT_EQ(1U, writeErrors);
+    ASSERT_EVENTS_FileIncomplete_SIZE(0);
+    ASSERT_EVENTS_FileNotAnnounced_SIZE(1);
+    ASSERT_EVENTS_FileNotAnnounced(0, destPath);
+    ASSERT_EVENTS_FileReceived_SIZE(0);
+    ASSERT_TLM_FilesReceived_SIZE(0);
+    ASSERT_from_fileAnnounce_SIZE(0);
+    ASSERT_EQ(FileUplink::START, this->component.m_receiveMode);
+
+    // The component stops the write-behind task when it is destroyed
+    this->removeFile(destPath);
+}
+
 // ----------------------------------------------------------------------
 // Handlers for from ports
 // ----------------------------------------------------------------------
@@ -467,9 +709,9 @@ void FileUplinkTester ::sendStartPacket(const char* const sourcePath,
     this->sequenceIndex = 1;
 }
 
-void FileUplinkTester ::sendDataPacket(const size_t byteOffset, U8* const packetData) {
+void FileUplinkTester ::sendDataPacket(const FwFileOffsetType byteOffset, U8* const packetData) {
     Fw::FilePacket::DataPacket tempDataPacket;
-    tempDataPacket.initialize(this->sequenceIndex++, static_cast<U32>(byteOffset), PACKET_SIZE, packetData);
+    tempDataPacket.initialize(this->sequenceIndex++, byteOffset, PACKET_SIZE, packetData);
     const Fw::FilePacket::DataPacket dataPacket = tempDataPacket;
 
     Fw::FilePacket filePacket;
@@ -71,6 +71,10 @@ class FileUplinkTester : public FileUplinkGTestBase {
     //!
     void packetOutOfBounds();
 
+    //! Send a file with packets that end past the end of the file or the largest offset
+    //!
+    void packetEndOutOfBounds();
+
     //! Send a file with an out-of-order packet
     //!
     void packetOutOfOrder();
@@ -87,6 +91,22 @@ class FileUplinkTester : public FileUplinkGTestBase {
     //!
     void cancelPacketInDataMode();
 
+    //! Insert received ranges and find the gaps between them
+    //!
+    void extents();
+
+    //! Send a file out of order with a missing packet, then resend it
+    //!
+    void fileGaps();
+
+    //! Send a file with a missing packet without waiting for it to be resent
+    //!
+    void fileGapsNoResend();
+
+    //! Send a file through the write-behind task, with a write that fails
+    //!
+    void writeBehind();
+
   private:
     // ----------------------------------------------------------------------
     // Handlers for from ports
@@ -129,7 +149,7 @@ class FileUplinkTester : public FileUplinkGTestBase {
 
     //! Send a DataPacket
     //!
-    void sendDataPacket(const size_t byteOffset, U8* const packetData);
+    void sendDataPacket(const FwFileOffsetType byteOffset, U8* const packetData);
 
     //! Send an EndPacket
     //!
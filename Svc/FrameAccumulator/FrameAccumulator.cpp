@@ -166,11 +166,15 @@ void FrameAccumulator ::processRing() {
         }
         // No frame was detected or an unknown status was received
         else {
-            // Discard a single byte of data and start again
-            (void)this->m_inRing.rotate(1);
-            FW_ASSERT(m_inRing.get_allocated_size() == remaining - 1,
+            // Discard the data the detector reports may be skipped, or a single byte when it reports nothing usable,
+            // and start again
+            const FwSizeType discard =
+                ((status == FrameDetector::NO_FRAME_DETECTED) && (size_out > 0) && (size_out <= remaining)) ? size_out
+                                                                                                            : 1;
+            (void)this->m_inRing.rotate(discard);
+            FW_ASSERT(m_inRing.get_allocated_size() == remaining - discard,
                       static_cast<FwAssertArgType>(m_inRing.get_allocated_size()),
-                      static_cast<FwAssertArgType>(remaining));
+                      static_cast<FwAssertArgType>(remaining), static_cast<FwAssertArgType>(discard));
         }
     }
 }
@@ -33,7 +33,9 @@ class FrameDetector {
     //!     size_out must be set to the size of the frame from that location.
     //!
     //!  2. NO_FRAME_DETECTED status implies no frame is possible at the current offset of the circular buffer.
-    //!     e.g. no start word is found at the current offset. size_out is ignored.
+    //!     e.g. no start word is found at the current offset. size_out may be set to the number of bytes that can be
+    //!     discarded before the next possible frame, which lets the caller skip data it would otherwise discard one
+    //!     byte at a time. Values of 0 or larger than the available data discard a single byte.
     //!
     //!  3. MORE_DATA_NEEDED status implies that a frame might be possible but more data is needed before a
     //!     determination is possible. size_out must be set to the total amount of data needed.
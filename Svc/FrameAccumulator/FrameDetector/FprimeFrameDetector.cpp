@@ -5,10 +5,61 @@
 // ======================================================================
 
 #include "Svc/FrameAccumulator/FrameDetector/FprimeFrameDetector.hpp"
+#include <cstring>
+#include "Fw/Types/Assert.hpp"
 
 namespace Svc {
 namespace FrameDetectors {
 
+// The header is the start word followed by the length field, and the trailer is the CRC. The fields are read directly
+// from the circular buffer as big endian U32 values, in the format of the FPP autocoded FrameHeader/FrameTrailer types.
+static_assert(FprimeProtocol::FrameHeader::SERIALIZED_SIZE == 2 * sizeof(U32), "Unexpected F Prime header format");
+static_assert(FprimeProtocol::FrameTrailer::SERIALIZED_SIZE == sizeof(U32), "Unexpected F Prime trailer format");
+
+namespace {
+//! Offset of the length field within the header
+constexpr FwSizeType LENGTH_FIELD_OFFSET = sizeof(U32);
+
+//! Start word expected at the beginning of each frame (default start_word value in the FPP object)
+U32 startWord() {
+    return FprimeProtocol::FrameHeader().get_startWord();
+}
+}  // namespace
+
+FprimeFrameDetector::FprimeFrameDetector() : m_hashedFrame(nullptr), m_hashedLength(0), m_hashedSize(0) {}
+
+void FprimeFrameDetector::resetPartialHash() const {
+    this->m_hashedFrame = nullptr;
+    this->m_hashedLength = 0;
+    this->m_hashedSize = 0;
+}
+
+FwSizeType FprimeFrameDetector::findStartWord(const Types::CircularBuffer& data, FwSizeType from) {
+    const U32 start_word = startWord();
+    const U8 first_byte = static_cast<U8>(start_word >> 24);
+    const FwSizeType allocated = data.get_allocated_size();
+    FwSizeType offset = from;
+    while (offset < allocated) {
+        // Search each contiguous span of the ring for the first byte of the start word
+        FwSizeType span_size = 0;
+        const U8* const span = data.contiguous_read_span(span_size, offset);
+        FW_ASSERT(span_size > 0, static_cast<FwAssertArgType>(offset));
+        const void* const found = ::memchr(span, first_byte, static_cast<size_t>(span_size));
+        if (found == nullptr) {
+            offset += span_size;
+            continue;
+        }
+        offset += static_cast<FwSizeType>(static_cast<const U8*>(found) - span);
+        // A candidate too close to the end to hold the whole start word is kept until more data arrives
+        U32 word = 0;
+        if ((data.peek(word, offset) != Fw::FW_SERIALIZE_OK) || (word == start_word)) {
+            return offset;
+        }
+        offset++;
+    }
+    return allocated;
+}
+
 FrameDetector::Status FprimeFrameDetector::detect(const Types::CircularBuffer& data, FwSizeType& size_out) const {
     // If not enough data for header + trailer, report MORE_DATA_NEEDED
     if (data.get_allocated_size() <
@@ -17,41 +68,52 @@ FrameDetector::Status FprimeFrameDetector::detect(const Types::CircularBuffer& d
         return Status::MORE_DATA_NEEDED;
     }
 
-    // NOTE: it is understood and accepted that the following code is not as efficient as it could technically be
-    // We are leveraging the FPP autocoded types to do the deserialization for us.
-    // In its current implementation, CircularBuffer is not a SerializeBufferBase, which prevents us from deserializing
-    // directly from the CircularBuffer into FrameHeader/FrameTrailer. Instead, we have to copy the data into
-    // a temporary SerializeBuffer, and then deserialize from that buffer into the FrameHeader/FrameTrailer objects.
-    // A better implementation would be to have CircularBuffer implement a shared interface with SerializeBufferBase,
-    // and then we could pass the CircularBuffer directly into the FrameHeader/FrameTrailer deserializers. This is left
-    // as a TODO for future improvement as it is a significant refactor
-
-    FprimeProtocol::FrameHeader header;
-    FprimeProtocol::FrameTrailer trailer;
-
     // ---------------- Frame Header ----------------
-    // Copy CircularBuffer data into linear buffer, for serialization into FrameHeader object
-    U8 header_data[FprimeProtocol::FrameHeader::SERIALIZED_SIZE];
-    Fw::SerializeStatus status = data.peek(header_data, FprimeProtocol::FrameHeader::SERIALIZED_SIZE, 0);
-    if (status != Fw::FW_SERIALIZE_OK) {
+    U32 start_word = 0;
+    U32 length_field = 0;
+    Fw::SerializeStatus status = data.peek(start_word, 0);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, static_cast<FwAssertArgType>(status));
+    // Check that the start word matches; otherwise report how much data may be skipped to reach the next candidate
+    if (start_word != startWord()) {
+        this->resetPartialHash();
+        size_out = findStartWord(data, 1);
         return Status::NO_FRAME_DETECTED;
     }
-    Fw::ExternalSerializeBuffer header_ser_buffer(header_data, FprimeProtocol::FrameHeader::SERIALIZED_SIZE);
-    status = header_ser_buffer.setBuffLen(FprimeProtocol::FrameHeader::SERIALIZED_SIZE);
+    status = data.peek(length_field, LENGTH_FIELD_OFFSET);
     FW_ASSERT(status == Fw::FW_SERIALIZE_OK, static_cast<FwAssertArgType>(status));
-    // Attempt to deserialize data into the FrameHeader object
-    status = header.deserializeFrom(header_ser_buffer);
-    if (status != Fw::FW_SERIALIZE_OK) {
-        return Status::NO_FRAME_DETECTED;
+
+    // We expect the frame size to be size of header + body (of size specified in header) + trailer
+    const FwSizeType hash_field_size = FprimeProtocol::FrameHeader::SERIALIZED_SIZE + length_field;
+    const FwSizeType expected_frame_size = hash_field_size + FprimeProtocol::FrameTrailer::SERIALIZED_SIZE;
+    // A frame that can never fit in the ring is dropped by the caller, so do not hash it
+    if (expected_frame_size > data.get_capacity()) {
+        this->resetPartialHash();
+        size_out = expected_frame_size;
+        return Status::MORE_DATA_NEEDED;
     }
-    // Check that deserialized start_word token matches expected value (default start_word value in the FPP object)
-    FprimeProtocol::FrameHeader default_value;
-    if (header.get_startWord() != default_value.get_startWord()) {
-        return Status::NO_FRAME_DETECTED;
+
+    // ---------------- Frame CRC ----------------
+    // Continue the partial CRC when this is the same incomplete frame as the last call: the frame is still at the head
+    // of the ring, and the ring has not shrunk below the hashed data.
+    FwSizeType head_size = 0;
+    const U8* const frame = data.contiguous_read_span(head_size);
+    if ((this->m_hashedFrame != frame) || (this->m_hashedLength != length_field) ||
+        (this->m_hashedSize > data.get_allocated_size())) {
+        this->m_hash.init();
+        this->m_hashedFrame = frame;
+        this->m_hashedLength = length_field;
+        this->m_hashedSize = 0;
     }
-    // We expect the frame size to be size of header + body (of size specified in header) + trailer
-    const FwSizeType expected_frame_size = FprimeProtocol::FrameHeader::SERIALIZED_SIZE + header.get_lengthField() +
-                                           FprimeProtocol::FrameTrailer::SERIALIZED_SIZE;
+    // Compute CRC over the transmitted data (header + body) received so far
+    const FwSizeType hash_end = FW_MIN(hash_field_size, data.get_allocated_size());
+    while (this->m_hashedSize < hash_end) {
+        FwSizeType span_size = 0;
+        const U8* const span = data.contiguous_read_span(span_size, this->m_hashedSize);
+        span_size = FW_MIN(span_size, hash_end - this->m_hashedSize);
+        this->m_hash.update(span, span_size);
+        this->m_hashedSize += span_size;
+    }
+
     // If the current allocated size can't hold the expected_frame_size -> MORE_DATA_NEEDED
     if (data.get_allocated_size() < expected_frame_size) {
         size_out = expected_frame_size;
@@ -59,39 +121,19 @@ FrameDetector::Status FprimeFrameDetector::detect(const Types::CircularBuffer& d
     }
 
     // ---------------- Frame Trailer ----------------
-    U8 trailer_data[FprimeProtocol::FrameTrailer::SERIALIZED_SIZE];
-    Fw::ExternalSerializeBuffer trailer_ser_buffer(trailer_data, FprimeProtocol::FrameTrailer::SERIALIZED_SIZE);
-    status = data.peek(trailer_data, FprimeProtocol::FrameTrailer::SERIALIZED_SIZE,
-                       FprimeProtocol::FrameHeader::SERIALIZED_SIZE + header.get_lengthField());
-    if (status != Fw::FW_SERIALIZE_OK) {
-        return Status::NO_FRAME_DETECTED;
-    }
-    status = trailer_ser_buffer.setBuffLen(FprimeProtocol::FrameTrailer::SERIALIZED_SIZE);
+    U32 crc_field = 0;
+    status = data.peek(crc_field, hash_field_size);
     FW_ASSERT(status == Fw::FW_SERIALIZE_OK, static_cast<FwAssertArgType>(status));
-    // Deserialize trailer from circular buffer (peeked data) into trailer object
-    status = trailer.deserializeFrom(trailer_ser_buffer);
-    if (status != Fw::FW_SERIALIZE_OK) {
-        return Status::NO_FRAME_DETECTED;
-    }
-
-    Utils::Hash hash;
     Utils::HashBuffer hashBuffer;
-    // Compute CRC over the transmitted data (header + body)
-    FwSizeType hash_field_size = header.get_lengthField() + FprimeProtocol::FrameHeader::SERIALIZED_SIZE;
-    hash.init();
-    for (U32 i = 0; i < hash_field_size; i++) {
-        U8 byte = 0;
-        status = data.peek(byte, i);
-        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
-        hash.update(&byte, 1);
-    }
-    hash.final(hashBuffer);
+    this->m_hash.final(hashBuffer);
+    this->resetPartialHash();
 
     // Compare the transmitted CRC with the computed one
-    if (trailer.get_crcField() != hashBuffer.asBigEndianU32()) {
+    if (crc_field != hashBuffer.asBigEndianU32()) {
         // CRC mismatch - there likely was data corruption. The F Prime protocol
         // being very simple, we don't have a way to recover from this.
-        // So we report NO_FRAME_DETECTED and drop the frame
+        // So we report NO_FRAME_DETECTED, drop data up to the next start word, and resynchronize there
+        size_out = findStartWord(data, 1);
         return Status::NO_FRAME_DETECTED;
     }
     // All checks passed - we have detected a frame of size expected_frame_size
@@ -18,9 +18,19 @@
 namespace Svc {
 namespace FrameDetectors {
 
-//! \brief interface class used to codify what must be supported to allow frame detection
+//! \brief frame detector for the F Prime communications protocol
+//!
+//! Detection is a single pass over the received data. When no frame starts at the current offset, the detector
+//! searches ahead for the next start word with memchr and reports how many bytes may be discarded, rather than having
+//! the caller discard one byte per call. While a frame is incomplete, the detector keeps the CRC of the bytes seen so
+//! far and continues it on the next call, so each byte is hashed once.
+//!
+//! \warning the partial CRC is kept in the detector, so an instance must serve a single FrameAccumulator
 class FprimeFrameDetector : public FrameDetector {
   public:
+    //! \brief construct the detector with no partial CRC
+    FprimeFrameDetector();
+
     //! \brief detect if a frame is available within the circular buffer
     //!
     //! Function implemented by sub classes used to determine if a frame is available at the current position of the
@@ -31,7 +41,8 @@ class FprimeFrameDetector : public FrameDetector {
     //!     size_out must be set to the size of the frame from that location.
     //!
     //!  2. NO_FRAME_DETECTED status implies no frame is possible at the current offset of the circular buffer.
-    //!     e.g. no start word is found at the current offset. size_out is ignored.
+    //!     e.g. no start word is found at the current offset. size_out is set to the offset of the next possible
+    //!     start word, or to the allocated size when there is none.
     //!
     //!  3. MORE_DATA_NEEDED status implies that a frame might be possible but more data is needed before a
     //!     determination is possible. size_out must be set to the total amount of data needed.
@@ -45,6 +56,26 @@ class FprimeFrameDetector : public FrameDetector {
     //! \return status of the detection to be paired with size_out
     Status detect(const Types::CircularBuffer& data, FwSizeType& size_out) const override;
 
+  private:
+    //! \brief find the next possible start word
+    //!
+    //! \param data: circular buffer to search
+    //! \param from: offset to start searching at
+    //! \return offset of the first full start word, or of a start word prefix at the end of the data, at or after
+    //!         from. The allocated size when there is none.
+    static FwSizeType findStartWord(const Types::CircularBuffer& data, FwSizeType from);
+
+    //! \brief forget the partial CRC
+    void resetPartialHash() const;
+
+    //! CRC of the first m_hashedSize bytes of the incomplete frame at m_hashedFrame
+    mutable Utils::Hash m_hash;
+    //! Address in the ring of the incomplete frame, nullptr when no partial CRC is held
+    mutable const U8* m_hashedFrame;
+    //! Length field of the incomplete frame
+    mutable U32 m_hashedLength;
+    //! Number of bytes of the incomplete frame included in m_hash
+    mutable FwSizeType m_hashedSize;
 };  // class FprimeFrameDetector
 }  // namespace FrameDetectors
 }  // namespace Svc
@@ -22,6 +22,11 @@ TEST(FrameAccumulator, TestNoFrameDetected) {
     tester.testNoFrameDetected();
 }
 
+TEST(FrameAccumulator, TestNoFrameDetectedSkip) {
+    Svc::FrameAccumulatorTester tester;
+    tester.testNoFrameDetectedSkip();
+}
+
 TEST(FrameAccumulator, TestReceiveZeroSizeBuffer) {
     Svc::FrameAccumulatorTester tester;
     tester.testReceiveZeroSizeBuffer();
@@ -79,6 +79,26 @@ void FrameAccumulatorTester ::testNoFrameDetected() {
     ASSERT_EQ(this->component.m_inRing.get_allocated_size(), 0);  // all data was consumed and discarded
 }
 
+void FrameAccumulatorTester ::testNoFrameDetectedSkip() {
+    // Prepare a random size buffer
+    U32 buffer_size = STest::Random::lowerUpper(2, 1024);
+    U8 data[buffer_size];
+    Fw::Buffer buffer(data, buffer_size);
+    ComCfg::FrameContext context;
+    // Set the mock detector to report that all but the last byte may be discarded
+    this->mockDetector.set_next_result(FrameDetector::Status::NO_FRAME_DETECTED, buffer_size - 1);
+    this->mockDetector.detect_count = 0;
+    // Receive the buffer on dataIn
+    this->invoke_to_dataIn(0, buffer, context);
+    // Checks
+    ASSERT_from_dataReturnOut_SIZE(1);                            // input buffer ownership was returned
+    ASSERT_from_dataOut_SIZE(0);                                  // No frame was sent out
+    ASSERT_EQ(this->component.m_inRing.get_allocated_size(), 0);  // all data was consumed and discarded
+    // One detection skipped buffer_size - 1 bytes; the size reported for the last byte is too large, so it is
+    // discarded on its own
+    ASSERT_EQ(this->mockDetector.detect_count, 2);
+}
+
 void FrameAccumulatorTester ::testReceiveZeroSizeBuffer() {
     // Prepare a zero size buffer
     U8 data[1] = {0};
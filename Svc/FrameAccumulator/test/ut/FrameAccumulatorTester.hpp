@@ -51,6 +51,9 @@ class FrameAccumulatorTester : public FrameAccumulatorGTestBase {
     //! No frame detected
     void testNoFrameDetected();
 
+    //! No frame detected, with the detector reporting how much data to discard
+    void testNoFrameDetectedSkip();
+
     //! Receive a zero size buffer
     void testReceiveZeroSizeBuffer();
 
@@ -102,6 +105,7 @@ class FrameAccumulatorTester : public FrameAccumulatorGTestBase {
     class MockDetector : public FrameDetector {
       public:
         Status detect(const Types::CircularBuffer& data, FwSizeType& size_out) const override {
+            this->detect_count++;
             size_out = this->next_size_out;
             return next_status;
         }
@@ -113,6 +117,7 @@ class FrameAccumulatorTester : public FrameAccumulatorGTestBase {
 
         Status next_status = Status::FRAME_DETECTED;
         FwSizeType next_size_out = 0;
+        mutable FwSizeType detect_count = 0;
     };
 
     //! Instances required by the component under test
@@ -160,6 +160,87 @@ TEST(FprimeFrameDetector, TestMoreDataNeeded) {
     EXPECT_EQ(status, Svc::FrameDetector::Status::MORE_DATA_NEEDED);
 }
 
+TEST(FprimeFrameDetector, TestResynchronizeOnStartWord) {
+    Svc::FrameDetectors::FprimeFrameDetector fprime_detector;
+    U8 buffer[CIRCULAR_BUFFER_TEST_SIZE];
+    ::memset(buffer, 0, CIRCULAR_BUFFER_TEST_SIZE);
+    Types::CircularBuffer circular_buffer(buffer, CIRCULAR_BUFFER_TEST_SIZE);
+
+    // Noise ending in a partial start word, followed by a frame
+    const U8 noise[] = {0x00, 0xDE, 0x11, 0xDE, 0xAD, 0x22, 0xDE, 0xAD, 0xBE, 0x33, 0xFF, 0xDE, 0xAD};
+    circular_buffer.serialize(noise, sizeof(noise));
+    const FwSizeType frame_size = generate_random_fprime_frame(circular_buffer);
+
+    // A single detection skips all the noise
+    FwSizeType size_out = 0;
+    EXPECT_EQ(fprime_detector.detect(circular_buffer, size_out), Svc::FrameDetector::Status::NO_FRAME_DETECTED);
+    EXPECT_EQ(size_out, sizeof(noise));
+    circular_buffer.rotate(size_out);
+    EXPECT_EQ(fprime_detector.detect(circular_buffer, size_out), Svc::FrameDetector::Status::FRAME_DETECTED);
+    EXPECT_EQ(size_out, frame_size);
+}
+
+TEST(FprimeFrameDetector, TestNoStartWord) {
+    Svc::FrameDetectors::FprimeFrameDetector fprime_detector;
+    U8 buffer[CIRCULAR_BUFFER_TEST_SIZE];
+    ::memset(buffer, 0, CIRCULAR_BUFFER_TEST_SIZE);
+    Types::CircularBuffer circular_buffer(buffer, CIRCULAR_BUFFER_TEST_SIZE);
+
+    // Data without a start word may be discarded entirely, except for a start word prefix at the end
+    U8 noise[64];
+    for (FwSizeType i = 0; i < sizeof(noise); i++) {
+        noise[i] = static_cast<U8>(STest::Random::lowerUpper(0, 0xDD));
+    }
+    noise[sizeof(noise) - 1] = 0xDE;
+    circular_buffer.serialize(noise, sizeof(noise));
+    FwSizeType size_out = 0;
+    EXPECT_EQ(fprime_detector.detect(circular_buffer, size_out), Svc::FrameDetector::Status::NO_FRAME_DETECTED);
+    EXPECT_EQ(size_out, sizeof(noise) - 1);
+}
+
+TEST(FprimeFrameDetector, TestIncrementalDetection) {
+    Svc::FrameDetectors::FprimeFrameDetector fprime_detector;
+    U8 buffer[CIRCULAR_BUFFER_TEST_SIZE];
+    ::memset(buffer, 0, CIRCULAR_BUFFER_TEST_SIZE);
+    Types::CircularBuffer circular_buffer(buffer, CIRCULAR_BUFFER_TEST_SIZE);
+    U8 frames_buffer[CIRCULAR_BUFFER_TEST_SIZE];
+    Types::CircularBuffer frames(frames_buffer, CIRCULAR_BUFFER_TEST_SIZE);
+
+    for (U32 iteration = 0; iteration < 100; iteration++) {
+        // Generate a frame, optionally corrupting one byte of the header or body
+        const FwSizeType frame_size = generate_random_fprime_frame(frames);
+        U8 frame[CIRCULAR_BUFFER_TEST_SIZE];
+        ASSERT_EQ(frames.peek(frame, frame_size), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(frames.rotate(frame_size), Fw::FW_SERIALIZE_OK);
+        const bool corrupt = (iteration % 2) == 1;
+        if (corrupt) {
+            frame[STest::Random::lowerUpper(Svc::FprimeProtocol::FrameHeader::SERIALIZED_SIZE,
+                                            static_cast<U32>(frame_size) - 5)] ^= 0x01;
+        }
+
+        // Deliver the frame in random chunks; the detector needs more data until the last chunk
+        FwSizeType delivered = 0;
+        FwSizeType size_out = 0;
+        Svc::FrameDetector::Status status = Svc::FrameDetector::Status::MORE_DATA_NEEDED;
+        while (delivered < frame_size) {
+            ASSERT_EQ(status, Svc::FrameDetector::Status::MORE_DATA_NEEDED);
+            const FwSizeType pick = STest::Random::lowerUpper(1, 100);
+            const FwSizeType chunk = FW_MIN(frame_size - delivered, pick);
+            ASSERT_EQ(circular_buffer.serialize(&frame[delivered], chunk), Fw::FW_SERIALIZE_OK);
+            delivered += chunk;
+            status = fprime_detector.detect(circular_buffer, size_out);
+        }
+        if (corrupt) {
+            ASSERT_EQ(status, Svc::FrameDetector::Status::NO_FRAME_DETECTED);
+            ASSERT_EQ(circular_buffer.rotate(circular_buffer.get_allocated_size()), Fw::FW_SERIALIZE_OK);
+        } else {
+            ASSERT_EQ(status, Svc::FrameDetector::Status::FRAME_DETECTED);
+            ASSERT_EQ(size_out, frame_size);
+            ASSERT_EQ(circular_buffer.rotate(size_out), Fw::FW_SERIALIZE_OK);
+        }
+    }
+}
+
 int main(int argc, char** argv) {
     STest::Random::seed();
     ::testing::InitGoogleTest(&argc, argv);
@@ -73,17 +73,16 @@ void PrmDbImpl::readParamFile() {
 // If there are a lot of accesses, perhaps an interrupt lock could be used instead of guarded ports
 
 Fw::ParamValid PrmDbImpl::getPrm_handler(FwIndexType portNum, FwPrmIdType id, Fw::ParamBuffer& val) {
-    // search for entry
+    // look up entry
     Fw::ParamValid stat = Fw::ParamValid::INVALID;
 
-    for (FwSizeType entry = 0; entry < PRMDB_NUM_DB_ENTRIES; entry++) {
-        if (this->m_activeDb[entry].used) {
-            if (this->m_activeDb[entry].id == id) {
-                val = this->m_activeDb[entry].val;
-                stat = Fw::ParamValid::VALID;
-                break;
-            }
-        }
+    FwSizeType entry = 0;
+    if (this->getIndexPtr(PrmDbType::DB_ACTIVE)->slots.find(id, entry) == Fw::Success::SUCCESS) {
+        FW_ASSERT(entry < PRMDB_NUM_DB_ENTRIES, static_cast<FwAssertArgType>(entry));
+        FW_ASSERT(this->m_activeDb[entry].used and (this->m_activeDb[entry].id == id),
+                  static_cast<FwAssertArgType>(entry));
+        val = this->m_activeDb[entry].val;
+        stat = Fw::ParamValid::VALID;
     }
 
     // if unable to find parameter, send error message
@@ -295,6 +294,7 @@ void PrmDbImpl::PRM_COMMIT_STAGED_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
 
     // Swap active and staging databases, safely w.r.t. prmGet
     this->lock();
+    // Each index belongs to its database store, so it follows the swap
     t_dbStruct* temp = this->m_activeDb;
     this->m_activeDb = this->m_stagingDb;
     this->unLock();
@@ -460,32 +460,31 @@ PrmDbImpl::PrmLoadStatus PrmDbImpl::readParamFileImpl(const Fw::StringBase& file
 
 PrmDbImpl::PrmUpdateType PrmDbImpl::updateAddPrmImpl(FwPrmIdType id, Fw::ParamBuffer& val, PrmDbType prmDbType) {
     t_dbStruct* db = getDbPtr(prmDbType);
+    t_dbIndex* index = getIndexPtr(prmDbType);
 
     PrmUpdateType updateStatus = NO_SLOTS;
 
     this->lock();
-    // search for existing entry
-    bool existingEntry = false;
-
-    for (FwSizeType entry = 0; entry < PRMDB_NUM_DB_ENTRIES; entry++) {
-        if ((db[entry].used) && (id == db[entry].id)) {
-            db[entry].val = val;
-            existingEntry = true;
-            updateStatus = PARAM_UPDATED;
-            break;
+    // look up existing entry
+    FwSizeType entry = 0;
+    if (index->slots.find(id, entry) == Fw::Success::SUCCESS) {
+        FW_ASSERT(entry < PRMDB_NUM_DB_ENTRIES, static_cast<FwAssertArgType>(entry));
+        db[entry].val = val;
+        updateStatus = PARAM_UPDATED;
+    } else {
+        // if there is no existing entry, add one in the lowest free slot
+        entry = index->firstFree;
+        while ((entry < PRMDB_NUM_DB_ENTRIES) && db[entry].used) {
+            entry++;
         }
-    }
-
-    // if there is no existing entry, add one
-    if (!existingEntry) {
-        for (FwSizeType entry = 0; entry < PRMDB_NUM_DB_ENTRIES; entry++) {
-            if (!(db[entry].used)) {
-                db[entry].val = val;
-                db[entry].id = id;
-                db[entry].used = true;
-                updateStatus = PARAM_ADDED;
-                break;
-            }
+        if (entry < PRMDB_NUM_DB_ENTRIES) {
+            db[entry].val = val;
+            db[entry].id = id;
+            db[entry].used = true;
+            const Fw::Success status = index->slots.insert(id, entry);
+            FW_ASSERT(status == Fw::Success::SUCCESS, static_cast<FwAssertArgType>(entry));
+            index->firstFree = entry + 1;
+            updateStatus = PARAM_ADDED;
         }
     }
 
@@ -503,6 +502,9 @@ void PrmDbImpl::clearDb(PrmDbType prmDbType) {
         db[entry].used = false;
         db[entry].id = 0;
     }
+    t_dbIndex* index = getIndexPtr(prmDbType);
+    index->slots.clear();
+    index->firstFree = 0;
 }
 
 bool PrmDbImpl::dbEqual() {
@@ -515,9 +517,15 @@ bool PrmDbImpl::dbEqual() {
 }
 
 void PrmDbImpl::dbCopy(PrmDbType dest, PrmDbType src) {
+    t_dbStruct* srcPtr = getDbPtr(src);
+    t_dbStruct* destPtr = getDbPtr(dest);
     for (FwSizeType i = 0; i < PRMDB_NUM_DB_ENTRIES; i++) {
-        dbCopySingle(dest, src, i);
+        destPtr[i].used = srcPtr[i].used;
+        destPtr[i].id = srcPtr[i].id;
+        destPtr[i].val = srcPtr[i].val;
     }
+    // the slots match, so the index does too
+    *getIndexPtr(dest) = *getIndexPtr(src);
     this->log_ACTIVITY_HI_PrmDbCopyAllComplete(getDbString(src), getDbString(dest));
 }
 
@@ -526,9 +534,38 @@ void PrmDbImpl::dbCopySingle(PrmDbType dest, PrmDbType src, FwSizeType index) {
     t_dbStruct* destPtr = getDbPtr(dest);
 
     FW_ASSERT(index < PRMDB_NUM_DB_ENTRIES);
+    const bool replaced = destPtr[index].used;
+    const FwPrmIdType replacedId = destPtr[index].id;
     destPtr[index].used = srcPtr[index].used;
     destPtr[index].id = srcPtr[index].id;
     destPtr[index].val = srcPtr[index].val;
+
+    // the entry may replace one the index points at, or hold an id the destination already has
+    if (replaced) {
+        this->reindexPrm(dest, replacedId);
+    }
+    if (destPtr[index].used) {
+        this->reindexPrm(dest, destPtr[index].id);
+    } else {
+        t_dbIndex* destIndex = getIndexPtr(dest);
+        destIndex->firstFree = FW_MIN(destIndex->firstFree, index);
+    }
+}
+
+void PrmDbImpl::reindexPrm(PrmDbType dbType, FwPrmIdType id) {
+    t_dbStruct* db = getDbPtr(dbType);
+    t_dbIndex* index = getIndexPtr(dbType);
+
+    FwSizeType entry = 0;
+    (void)index->slots.remove(id, entry);
+    // the lowest slot is the one a search of the slots would find first
+    for (entry = 0; entry < PRMDB_NUM_DB_ENTRIES; entry++) {
+        if (db[entry].used && (db[entry].id == id)) {
+            const Fw::Success status = index->slots.insert(id, entry);
+            FW_ASSERT(status == Fw::Success::SUCCESS, static_cast<FwAssertArgType>(entry));
+            break;
+        }
+    }
 }
 
 PrmDbImpl::t_dbStruct* PrmDbImpl::getDbPtr(PrmDbType dbType) {
@@ -539,6 +576,10 @@ PrmDbImpl::t_dbStruct* PrmDbImpl::getDbPtr(PrmDbType dbType) {
     return m_stagingDb;
 }
 
+PrmDbImpl::t_dbIndex* PrmDbImpl::getIndexPtr(PrmDbType dbType) {
+    return (getDbPtr(dbType) == this->m_dbStore1) ? &this->m_dbIndex1 : &this->m_dbIndex2;
+}
+
 Fw::String PrmDbImpl::getDbString(PrmDbType dbType) {
     FW_ASSERT(dbType == PrmDbType::DB_ACTIVE or dbType == PrmDbType::DB_STAGING);
     if (dbType == PrmDbType::DB_ACTIVE) {
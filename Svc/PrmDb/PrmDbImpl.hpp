@@ -13,6 +13,7 @@
 #ifndef PRMDBIMPL_HPP_
 #define PRMDBIMPL_HPP_
 
+#include <Fw/DataStructures/RedBlackTreeMap.hpp>
 #include <Fw/Types/String.hpp>
 #include <Os/Mutex.hpp>
 #include <Svc/PrmDb/PrmDbComponentAc.hpp>
@@ -118,6 +119,17 @@ class PrmDbImpl final : public PrmDbComponentBase {
     t_dbStruct m_dbStore1[PRMDB_NUM_DB_ENTRIES];
     t_dbStruct m_dbStore2[PRMDB_NUM_DB_ENTRIES];
 
+    // Index of the entries in a database store, so parameters are found without
+    // searching the slots. Each store has its own index, which follows the store
+    // when the active and staging databases are swapped.
+    struct t_dbIndex {
+        Fw::RedBlackTreeMap<FwPrmIdType, FwSizeType, PRMDB_NUM_DB_ENTRIES> slots;  //!< lowest slot holding each id
+        FwSizeType firstFree;  //!< all slots below this one are used
+    };
+
+    t_dbIndex m_dbIndex1;  //!< Index of m_dbStore1
+    t_dbIndex m_dbIndex2;  //!< Index of m_dbStore2
+
     //! ----------------------------------------------------------------------
     //! Port & Command Handlers
     //! ----------------------------------------------------------------------
@@ -225,6 +237,21 @@ class PrmDbImpl final : public PrmDbComponentBase {
     //!  \return Pointer to the database array to be set
     t_dbStruct* getDbPtr(PrmDbType dbType);
 
+    //!  \brief PrmDb get db index pointer function
+    //!  This function returns a pointer to the index of the requested database
+    //!  \param dbType The type of database requested (active or staging)
+    //!  \return Pointer to the index of the database
+    t_dbIndex* getIndexPtr(PrmDbType dbType);
+
+    //!  \brief PrmDb reindex parameter function
+    //!
+    //!  This function points the index of a database at the lowest slot holding a parameter,
+    //!  after the slots have been changed without going through the index
+    //!
+    //!  \param dbType The type of database to reindex (active or staging)
+    //!  \param id The identifier of the parameter to reindex
+    void reindexPrm(PrmDbType dbType, FwPrmIdType id);
+
     //!  \brief PrmDb get db string function
     //!  This function returns a string for the requested database
     //!  \param dbType The type of database requested (active or staging)
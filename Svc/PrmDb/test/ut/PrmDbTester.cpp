@@ -12,6 +12,7 @@
 #include <Os/Delegate.hpp>
 #include <Os/Stub/test/File.hpp>
 #include <Svc/PrmDb/test/ut/PrmDbTester.hpp>
+#include <chrono>
 #include <cstdio>
 #include "Os/Stub/Directory.hpp"
 #include "Os/Stub/FileSystem.hpp"
@@ -1287,6 +1288,139 @@ void PrmDbTester::runPrmFileLoadIllegal() {
     ASSERT_EVENTS_PrmIdAdded_SIZE(1);
 }
 
+void PrmDbTester::runDbIndexTest() {
+    // Apply a pseudo-random mix of database operations and check every lookup against a search of the slots
+    static const U32 NUM_OPERATIONS = 20000;
+    static const FwPrmIdType NUM_IDS = 2 * PRMDB_NUM_DB_ENTRIES;
+
+    this->m_impl.clearDb(PrmDbType::DB_ACTIVE);
+    this->m_impl.clearDb(PrmDbType::DB_STAGING);
+
+    U32 seed = 0x12345678;
+    for (U32 op = 0; op < NUM_OPERATIONS; op++) {
+        seed = seed * 1664525 + 1013904223;
+        const U32 rand = seed >> 8;
+        const PrmDbType db = ((rand >> 4) & 1) ? PrmDbType::DB_ACTIVE : PrmDbType::DB_STAGING;
+        const PrmDbType other = (db == PrmDbType::DB_ACTIVE) ? PrmDbType::DB_STAGING : PrmDbType::DB_ACTIVE;
+        const FwPrmIdType id = static_cast<FwPrmIdType>((rand >> 5) % NUM_IDS);
+
+        switch (rand % 16) {
+            case 0:
+                this->m_impl.clearDb(db);
+                break;
+            case 1:
+                this->m_impl.dbCopy(db, other);
+                EXPECT_TRUE(this->m_impl.dbEqual());
+                break;
+            case 2:
+                // swap the databases the way a commit does
+                this->m_impl.m_state = PrmDbFileLoadState::FILE_UPDATES_STAGED;
+                this->sendCmd_PRM_COMMIT_STAGED(0, op);
+                EXPECT_EQ(this->m_impl.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+                this->clearHistory();
+                break;
+            case 3:
+            case 4:
+            case 5:
+                this->m_impl.dbCopySingle(db, other, (rand >> 5) % PRMDB_NUM_DB_ENTRIES);
+                break;
+            default: {
+                FwSizeType slot = 0;
+                const bool found = this->findSlot(db, id, slot);
+                // a new parameter goes in the lowest free slot
+                FwSizeType freeSlot = 0;
+                const PrmDbImpl::t_dbStruct* dbPtr = this->m_impl.getDbPtr(db);
+                while ((freeSlot < PRMDB_NUM_DB_ENTRIES) && dbPtr[freeSlot].used) {
+                    freeSlot++;
+                }
+                Fw::ParamBuffer pBuff;
+                EXPECT_EQ(Fw::FW_SERIALIZE_OK, pBuff.serializeFrom(op));
+                const PrmDbImpl::PrmUpdateType status = this->m_impl.updateAddPrmImpl(id, pBuff, db);
+                if (found) {
+                    EXPECT_EQ(PrmDbImpl::PARAM_UPDATED, status);
+                } else if (freeSlot < PRMDB_NUM_DB_ENTRIES) {
+                    EXPECT_EQ(PrmDbImpl::PARAM_ADDED, status);
+                    slot = freeSlot;
+                } else {
+                    EXPECT_EQ(PrmDbImpl::NO_SLOTS, status);
+                    break;
+                }
+                ASSERT_TRUE(dbPtr[slot].used);
+                EXPECT_EQ(id, dbPtr[slot].id);
+                EXPECT_EQ(pBuff, dbPtr[slot].val);
+                break;
+            }
+        }
+
+        // every parameter is found in the first slot holding it
+        for (FwPrmIdType check = 0; check < NUM_IDS; check++) {
+            FwSizeType slot = 0;
+            Fw::ParamBuffer pBuff;
+            if (this->findSlot(PrmDbType::DB_ACTIVE, check, slot)) {
+                ASSERT_EQ(Fw::ParamValid::VALID, this->m_impl.getPrm_handler(0, check, pBuff).e) << "op " << op;
+                EXPECT_EQ(this->m_impl.m_activeDb[slot].val, pBuff);
+            } else {
+                ASSERT_EQ(Fw::ParamValid::INVALID, this->m_impl.getPrm_handler(0, check, pBuff).e) << "op " << op;
+            }
+            this->clearEvents();
+        }
+    }
+    this->clearHistory();
+}
+
+void PrmDbTester::runDbIndexLoad(U32 numParameters, bool report) {
+    // Simulate startup loading parameters, in rounds that each fill the database
+    const U32 NUM_ROUNDS = (numParameters + PRMDB_NUM_DB_ENTRIES - 1) / PRMDB_NUM_DB_ENTRIES;
+
+    Fw::ParamBuffer pBuff;
+    F64 loadTime = 0.0;
+    F64 getTime = 0.0;
+    for (U32 round = 0; round < NUM_ROUNDS; round++) {
+        this->m_impl.clearDb(PrmDbType::DB_ACTIVE);
+
+        // parameter ids are sparse and arrive out of order, as they do from a parameter file
+        const auto start = std::chrono::steady_clock::now();
+        for (U32 entry = 0; entry < PRMDB_NUM_DB_ENTRIES; entry++) {
+            const FwPrmIdType id = static_cast<FwPrmIdType>(((entry * 7919) % PRMDB_NUM_DB_ENTRIES) * 0x100 + round);
+            pBuff.resetSer();
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK, pBuff.serializeFrom(id));
+            ASSERT_EQ(PrmDbImpl::PARAM_ADDED, this->m_impl.updateAddPrmImpl(id, pBuff, PrmDbType::DB_ACTIVE));
+        }
+        const auto loaded = std::chrono::steady_clock::now();
+
+        // each component then gets its parameters
+        for (U32 entry = 0; entry < PRMDB_NUM_DB_ENTRIES; entry++) {
+            const FwPrmIdType id = static_cast<FwPrmIdType>(entry * 0x100 + round);
+            ASSERT_EQ(Fw::ParamValid::VALID, this->invoke_to_getPrm(0, id, pBuff).e);
+            FwPrmIdType value = 0;
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK, pBuff.deserializeTo(value));
+            ASSERT_EQ(id, value);
+        }
+        const auto got = std::chrono::steady_clock::now();
+
+        loadTime += std::chrono::duration<F64>(loaded - start).count();
+        getTime += std::chrono::duration<F64>(got - loaded).count();
+    }
+
+    if (!report) {
+        return;
+    }
+    const U32 total = NUM_ROUNDS * PRMDB_NUM_DB_ENTRIES;
+    (void)printf("%u parameters in a %u entry database: loaded in %.3f ms, got in %.3f ms\n",
+                 static_cast<unsigned int>(total), static_cast<unsigned int>(PRMDB_NUM_DB_ENTRIES), loadTime * 1000.0,
+                 getTime * 1000.0);
+}
+
+bool PrmDbTester::findSlot(PrmDb_PrmDbType dbType, FwPrmIdType id, FwSizeType& slot) {
+    const PrmDbImpl::t_dbStruct* db = this->m_impl.getDbPtr(dbType);
+    for (slot = 0; slot < PRMDB_NUM_DB_ENTRIES; slot++) {
+        if (db[slot].used && (db[slot].id == id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 PrmDbTester* PrmDbTester::PrmDbTestFile::s_tester = nullptr;
 
 void PrmDbTester::PrmDbTestFile::setTester(Svc::PrmDbTester* tester) {
@@ -32,6 +32,8 @@ class PrmDbTester : public PrmDbGTestBase {
     void runPrmFileLoadNominal();
     void runPrmFileLoadWithErrors();
     void runPrmFileLoadIllegal();
+    void runDbIndexTest();
+    void runDbIndexLoad(U32 numParameters, bool report = false);
 
     void runRefPrmFile();
 
@@ -75,6 +77,11 @@ class PrmDbTester : public PrmDbGTestBase {
     };
 
     void printDb(PrmDb_PrmDbType dbType);
+
+  private:
+    //! Find the slot holding a parameter by searching the database slots
+    //! \return whether the parameter was found
+    bool findSlot(PrmDb_PrmDbType dbType, FwPrmIdType id, FwSizeType& slot);
 };
 
 }  // namespace Svc
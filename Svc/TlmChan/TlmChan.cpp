@@ -19,38 +19,48 @@ namespace Svc {
 // Definition of TLMCHAN_HASH_BUCKETS is >= number of telemetry ids
 static_assert(std::numeric_limits<FwChanIdType>::max() >= TLMCHAN_HASH_BUCKETS,
               "Cannot have more hash buckets than maximum telemetry ids in the system");
-// TLMCHAN_HASH_BUCKETS >= TLMCHAN_NUM_TLM_HASH_SLOTS >= 0
-static_assert(std::numeric_limits<FwChanIdType>::max() >= TLMCHAN_NUM_TLM_HASH_SLOTS,
-              "Cannot have more hash slots than maximum telemetry ids in the system");
-
-TlmChan::TlmChan(const char* name) : TlmChanComponentBase(name), m_activeBuffer(0) {
-    // clear slot pointers
-    for (FwChanIdType entry = 0; entry < TLMCHAN_NUM_TLM_HASH_SLOTS; entry++) {
-        this->m_tlmEntries[0].slots[entry] = nullptr;
-        this->m_tlmEntries[1].slots[entry] = nullptr;
+// TLMCHAN_INDEX_SLOTS is a power of two holding at least twice TLMCHAN_HASH_BUCKETS
+static_assert(TLMCHAN_INDEX_SLOTS >= 2 * TLMCHAN_HASH_BUCKETS, "Channel index must be at most half full");
+static_assert((TLMCHAN_INDEX_SLOTS & (TLMCHAN_INDEX_SLOTS - 1)) == 0, "Channel index size must be a power of two");
+
+TlmChan::TlmChan(const char* name) : TlmChanComponentBase(name), m_free(0), m_activeBuffer(0) {
+    // clear index
+    for (FwChanIdType slot = 0; slot < TLMCHAN_INDEX_SLOTS; slot++) {
+        this->m_index[slot].used = false;
+        this->m_index[slot].id = 0;
+        this->m_index[slot].bucket = 0;
     }
     // clear buckets
     for (FwChanIdType entry = 0; entry < TLMCHAN_HASH_BUCKETS; entry++) {
         this->m_tlmEntries[0].buckets[entry].used = false;
         this->m_tlmEntries[0].buckets[entry].updated = false;
-        this->m_tlmEntries[0].buckets[entry].bucketNo = entry;
-        this->m_tlmEntries[0].buckets[entry].next = nullptr;
         this->m_tlmEntries[0].buckets[entry].id = 0;
         this->m_tlmEntries[1].buckets[entry].used = false;
         this->m_tlmEntries[1].buckets[entry].updated = false;
-        this->m_tlmEntries[1].buckets[entry].bucketNo = entry;
-        this->m_tlmEntries[1].buckets[entry].next = nullptr;
         this->m_tlmEntries[1].buckets[entry].id = 0;
     }
-    // clear free index
-    this->m_tlmEntries[0].free = 0;
-    this->m_tlmEntries[1].free = 0;
+    // clear updated lists
+    this->m_tlmEntries[0].numUpdated = 0;
+    this->m_tlmEntries[1].numUpdated = 0;
 }
 
 TlmChan::~TlmChan() {}
 
 FwChanIdType TlmChan::doHash(FwChanIdType id) {
-    return (id % TLMCHAN_HASH_MOD_VALUE) % TLMCHAN_NUM_TLM_HASH_SLOTS;
+    // Multiplicative hash, folding the high bits down so that ids differing only in their
+    // component base still spread across the index
+    const U32 mixed = static_cast<U32>(id) * 2654435761U;
+    return static_cast<FwChanIdType>((mixed ^ (mixed >> 16)) & (TLMCHAN_INDEX_SLOTS - 1));
+}
+
+FwChanIdType TlmChan::findSlot(FwChanIdType id) {
+    FwChanIdType slot = this->doHash(id);
+    // Linear probe. The index is never more than half full, so an empty slot is always reached
+    // and the expected probe length is close to one.
+    while (this->m_index[slot].used && (this->m_index[slot].id != id)) {
+        slot = static_cast<FwChanIdType>((slot + 1) & (TLMCHAN_INDEX_SLOTS - 1));
+    }
+    return slot;
 }
 
 void TlmChan::pingIn_handler(const FwIndexType portNum, U32 key) {
@@ -59,37 +69,22 @@ void TlmChan::pingIn_handler(const FwIndexType portNum, U32 key) {
 }
 
 Fw::TlmValid TlmChan::TlmGet_handler(FwIndexType portNum, FwChanIdType id, Fw::Time& timeTag, Fw::TlmBuffer& val) {
-    // Compute index for entry
-
-    FwChanIdType index = this->doHash(id);
-
-    // Search to see if channel has been stored
-    // check both buffers
+    // Look up the bucket assigned to the channel
     // don't need to lock because this port is guarded
-    TlmEntry* activeEntry = this->m_tlmEntries[this->m_activeBuffer].slots[index];
-    for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-        if (activeEntry) {  // If bucket exists, check id
-            if (activeEntry->id == id) {
-                break;
-            } else {  // otherwise go to next bucket
-                activeEntry = activeEntry->next;
-            }
-        } else {  // no buckets left to search
-            break;
-        }
+    const IndexSlot& slot = this->m_index[this->findSlot(id)];
+    if (not slot.used) {
+        val.resetSer();
+        return Fw::TlmValid::INVALID;
     }
 
-    TlmEntry* inactiveEntry = this->m_tlmEntries[1 - this->m_activeBuffer].slots[index];
-    for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-        if (inactiveEntry) {  // If bucket exists, check id
-            if (inactiveEntry->id == id) {
-                break;
-            } else {  // otherwise go to next bucket
-                inactiveEntry = inactiveEntry->next;
-            }
-        } else {  // no buckets left to search
-            break;
-        }
+    // check both buffers
+    TlmEntry* activeEntry = &this->m_tlmEntries[this->m_activeBuffer].buckets[slot.bucket];
+    TlmEntry* inactiveEntry = &this->m_tlmEntries[1 - this->m_activeBuffer].buckets[slot.bucket];
+    if (not activeEntry->used) {
+        activeEntry = nullptr;
+    }
+    if (not inactiveEntry->used) {
+        inactiveEntry = nullptr;
     }
 
     if (activeEntry && inactiveEntry) {
@@ -136,45 +131,22 @@ Fw::TlmValid TlmChan::TlmGet_handler(FwIndexType portNum, FwChanIdType id, Fw::T
 }
 
 void TlmChan::TlmRecv_handler(FwIndexType portNum, FwChanIdType id, Fw::Time& timeTag, Fw::TlmBuffer& val) {
-    // Compute index for entry
-
-    FwChanIdType index = this->doHash(id);
-    TlmEntry* entryToUse = nullptr;
-    TlmEntry* prevEntry = nullptr;
-
-    // Search to see if channel has already been stored or a bucket needs to be added
-    if (this->m_tlmEntries[this->m_activeBuffer].slots[index]) {
-        entryToUse = this->m_tlmEntries[this->m_activeBuffer].slots[index];
-        // Loop one extra time so that we don't inadvertently fall through the end of the loop early.
-        for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS + 1; bucket++) {
-            if (entryToUse) {
-                if (entryToUse->id == id) {  // found the matching entry
-                    break;
-                } else {  // try next entry
-                    prevEntry = entryToUse;
-                    entryToUse = entryToUse->next;
-                }
-            } else {
-                // Make sure that we haven't run out of buckets
-                FW_ASSERT(this->m_tlmEntries[this->m_activeBuffer].free < TLMCHAN_HASH_BUCKETS);
-                // add new bucket from free list
-                entryToUse =
-                    &this->m_tlmEntries[this->m_activeBuffer].buckets[this->m_tlmEntries[this->m_activeBuffer].free++];
-                FW_ASSERT(prevEntry);
-                prevEntry->next = entryToUse;
-                // clear next pointer
-                entryToUse->next = nullptr;
-                break;
-            }
-        }
-    } else {
+    // Look up the bucket assigned to the channel, assigning a new one on first update
+    IndexSlot& slot = this->m_index[this->findSlot(id)];
+    if (not slot.used) {
         // Make sure that we haven't run out of buckets
-        FW_ASSERT(this->m_tlmEntries[this->m_activeBuffer].free < TLMCHAN_HASH_BUCKETS);
-        // create new entry at slot head
-        this->m_tlmEntries[this->m_activeBuffer].slots[index] =
-            &this->m_tlmEntries[this->m_activeBuffer].buckets[this->m_tlmEntries[this->m_activeBuffer].free++];
-        entryToUse = this->m_tlmEntries[this->m_activeBuffer].slots[index];
-        entryToUse->next = nullptr;
+        FW_ASSERT(this->m_free < TLMCHAN_HASH_BUCKETS, static_cast<FwAssertArgType>(id));
+        slot.used = true;
+        slot.id = id;
+        slot.bucket = this->m_free++;
+    }
+    TlmSet& activeSet = this->m_tlmEntries[this->m_activeBuffer];
+    TlmEntry* entryToUse = &activeSet.buckets[slot.bucket];
+
+    // add to the updated list the first time the entry is written in this cycle
+    if (not entryToUse->updated) {
+        FW_ASSERT(activeSet.numUpdated < TLMCHAN_HASH_BUCKETS, static_cast<FwAssertArgType>(activeSet.numUpdated));
+        activeSet.updated[activeSet.numUpdated++] = slot.bucket;
     }
 
     // copy into entry
@@ -196,41 +168,46 @@ void TlmChan::Run_handler(FwIndexType portNum, U32 context) {
     // so the data can be read without worrying about updates
     this->lock();
     this->m_activeBuffer = 1 - this->m_activeBuffer;
-    // set activeBuffer to not updated
-    for (U32 entry = 0; entry < TLMCHAN_HASH_BUCKETS; entry++) {
-        this->m_tlmEntries[this->m_activeBuffer].buckets[entry].updated = false;
+    // set activeBuffer to not updated. Entries are cleared as they are written out, so this
+    // list is normally already empty.
+    TlmSet& activeSet = this->m_tlmEntries[this->m_activeBuffer];
+    for (FwChanIdType entry = 0; entry < activeSet.numUpdated; entry++) {
+        activeSet.buckets[activeSet.updated[entry]].updated = false;
     }
+    activeSet.numUpdated = 0;
     this->unLock();
 
-    // go through each entry and send a packet if it has been updated
+    // go through each updated entry and send a packet
     Fw::TlmPacket pkt;
     pkt.resetPktSer();
 
-    for (U32 entry = 0; entry < TLMCHAN_HASH_BUCKETS; entry++) {
-        TlmEntry* p_entry = &this->m_tlmEntries[1 - this->m_activeBuffer].buckets[entry];
-        if ((p_entry->updated) && (p_entry->used)) {
-            Fw::SerializeStatus stat = pkt.addValue(p_entry->id, p_entry->lastUpdate, p_entry->buffer);
-
-            // check to see if this packet is full, if so, send it
-            if (Fw::FW_SERIALIZE_NO_ROOM_LEFT == stat) {
-                this->PktSend_out(0, pkt.getBuffer(), 0);
-                // reset packet for more entries
-                pkt.resetPktSer();
-                // add entry to new packet
-                stat = pkt.addValue(p_entry->id, p_entry->lastUpdate, p_entry->buffer);
-                // if this doesn't work, that means packet isn't big enough for
-                // even one channel, so assert
-                FW_ASSERT(Fw::FW_SERIALIZE_OK == stat, static_cast<FwAssertArgType>(stat));
-            } else if (Fw::FW_SERIALIZE_OK == stat) {
-                // if there was still room, do nothing move on to the next channel in the packet
-            } else  // any other status is an assert, since it shouldn't happen
-            {
-                FW_ASSERT(0, static_cast<FwAssertArgType>(stat));
-            }
-            // flag as updated
-            p_entry->updated = false;
-        }  // end if entry was updated
-    }  // end for each entry
+    TlmSet& inactiveSet = this->m_tlmEntries[1 - this->m_activeBuffer];
+    for (FwChanIdType entry = 0; entry < inactiveSet.numUpdated; entry++) {
+        TlmEntry* p_entry = &inactiveSet.buckets[inactiveSet.updated[entry]];
+        FW_ASSERT(p_entry->updated and p_entry->used, static_cast<FwAssertArgType>(inactiveSet.updated[entry]));
+
+        Fw::SerializeStatus stat = pkt.addValue(p_entry->id, p_entry->lastUpdate, p_entry->buffer);
+
+        // check to see if this packet is full, if so, send it
+        if (Fw::FW_SERIALIZE_NO_ROOM_LEFT == stat) {
+            this->PktSend_out(0, pkt.getBuffer(), 0);
+            // reset packet for more entries
+            pkt.resetPktSer();
+            // add entry to new packet
+            stat = pkt.addValue(p_entry->id, p_entry->lastUpdate, p_entry->buffer);
+            // if this doesn't work, that means packet isn't big enough for
+            // even one channel, so assert
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == stat, static_cast<FwAssertArgType>(stat));
+        } else if (Fw::FW_SERIALIZE_OK == stat) {
+            // if there was still room, do nothing move on to the next channel in the packet
+        } else  // any other status is an assert, since it shouldn't happen
+        {
+            FW_ASSERT(0, static_cast<FwAssertArgType>(stat));
+        }
+        // flag as written out
+        p_entry->updated = false;
+    }  // end for each updated entry
+    inactiveSet.numUpdated = 0;
 
     // send remnant entries
     if (pkt.getNumEntries() > 0) {
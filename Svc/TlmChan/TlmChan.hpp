@@ -19,6 +19,16 @@
 
 namespace Svc {
 
+//! Smallest power of two that is greater than or equal to value
+constexpr FwChanIdType tlmChanIndexSize(FwChanIdType value, FwChanIdType size = 1) {
+    return (size >= value) ? size : tlmChanIndexSize(value, static_cast<FwChanIdType>(size << 1));
+}
+
+//! Number of slots in the open-addressed channel index. Sized to a power of two that is at least
+//! twice the number of buckets so the index is never more than half full.
+static constexpr FwChanIdType TLMCHAN_INDEX_SLOTS =
+    tlmChanIndexSize(static_cast<FwChanIdType>(2 * TLMCHAN_HASH_BUCKETS));
+
 class TlmChan final : public TlmChanComponentBase {
     friend class TlmChanTester;
 
@@ -27,9 +37,15 @@ class TlmChan final : public TlmChanComponentBase {
     virtual ~TlmChan();
 
   protected:
-    // can be overridden for alternate algorithms
+    //! Map a channel id to its home slot in the channel index. findSlot probes linearly from the
+    //! home slot, so the result must be below TLMCHAN_INDEX_SLOTS and the same every time for an id.
+    //! \return home slot of the id
     FwChanIdType doHash(FwChanIdType id);
 
+    //! Find the index slot for a channel id
+    //! \return slot holding the id, or the empty slot where it would be inserted
+    FwChanIdType findSlot(FwChanIdType id);
+
   private:
     // Port functions
     void TlmRecv_handler(FwIndexType portNum, FwChanIdType id, Fw::Time& timeTag, Fw::TlmBuffer& val);
@@ -44,19 +60,27 @@ class TlmChan final : public TlmChanComponentBase {
     typedef struct tlmEntry {
         FwChanIdType id;  //!< telemetry id stored in slot
         bool updated;     //!< set whenever a value has been written. Used to skip if writing out values for downlinking
-        Fw::Time lastUpdate;    //!< last updated time
-        Fw::TlmBuffer buffer;   //!< buffer to store serialized telemetry
-        tlmEntry* next;         //!< pointer to next bucket in table
-        bool used;              //!< if entry has been used
-        FwChanIdType bucketNo;  //!< for testing
+        Fw::Time lastUpdate;   //!< last updated time
+        Fw::TlmBuffer buffer;  //!< buffer to store serialized telemetry
+        bool used;             //!< if entry has been used
     } TlmEntry;
 
     struct TlmSet {
-        TlmEntry* slots[TLMCHAN_NUM_TLM_HASH_SLOTS];  //!< set of hash slots in hash table
-        TlmEntry buckets[TLMCHAN_HASH_BUCKETS];       //!< set of buckets used in hash table
-        FwChanIdType free;                            //!< next free bucket
+        TlmEntry buckets[TLMCHAN_HASH_BUCKETS];  //!< set of buckets used in hash table
+        FwChanIdType updated[TLMCHAN_HASH_BUCKETS];  //!< buckets updated since the set was last written out
+        FwChanIdType numUpdated;                     //!< number of entries in the updated list
     } m_tlmEntries[2];
 
+    //! Slot in the channel index. A channel is assigned one bucket number that is shared by both
+    //! telemetry sets, so a single probe finds the channel in either buffer.
+    struct IndexSlot {
+        FwChanIdType id;      //!< telemetry id mapped by this slot
+        FwChanIdType bucket;  //!< bucket holding the channel in each telemetry set
+        bool used;            //!< if slot has been used
+    } m_index[TLMCHAN_INDEX_SLOTS];
+
+    FwChanIdType m_free;  //!< next free bucket
+
     U32 m_activeBuffer;  // !< which buffer is active for storing telemetry
 };
 
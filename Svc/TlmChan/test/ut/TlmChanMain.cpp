@@ -44,6 +44,34 @@ TEST(TlmChanTest, OffNominal) {
     tester.runOffNominal();
 }
 
+TEST(TlmChanTest, UpdatedOnly) {
+    COMMENT("Write a subset of channels and verify only updated channels are pushed.");
+
+    Svc::TlmChanTester tester;
+
+    // run test
+    tester.runUpdatedOnly();
+}
+
+TEST(TlmChanTest, FullTable) {
+    COMMENT("Fill every bucket with deployment-like ids and verify each channel is found in its own slot.");
+
+    Svc::TlmChanTester tester;
+
+    // run test
+    tester.runFullTable();
+}
+
+// Timing benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(TlmChanTest, DISABLED_Performance) {
+    COMMENT("Compare update and lookup cost of the channel index against the chained table.");
+
+    Svc::TlmChanTester tester;
+
+    // run test
+    tester.runPerformance();
+}
+
 // TEST(TlmChanTest,TooManyChannels) {
 
 //     COMMENT("Too Many Channel Test");
@@ -6,6 +6,7 @@
 
 #include "TlmChanTester.hpp"
 #include <Fw/Test/UnitTest.hpp>
+#include <chrono>
 
 #define INSTANCE 0
 #define MAX_HISTORY_SIZE 10
@@ -20,6 +21,78 @@ static constexpr FwSizeType INTEGER_DIVISION_ROUNDED_UP(FwSizeType a, FwSizeType
 
 namespace Svc {
 
+namespace {
+
+//! Reference copy of the chained hash table TlmChan used before the open-addressed index. Kept
+//! only so the performance test can compare lookup cost against it.
+class ChainedTlmTable {
+  public:
+    ChainedTlmTable() : m_free(0) {
+        for (FwChanIdType slot = 0; slot < SLOTS; slot++) {
+            this->m_slots[0][slot] = nullptr;
+            this->m_slots[1][slot] = nullptr;
+        }
+    }
+
+    void update(FwChanIdType id, const Fw::Time& timeTag, const Fw::TlmBuffer& val) {
+        Entry* entry = this->find(0, id);
+        if (entry == nullptr) {
+            FW_ASSERT(this->m_free < TLMCHAN_HASH_BUCKETS);
+            entry = &this->m_buckets[this->m_free++];
+            entry->id = id;
+            // chain new buckets at the tail, as TlmChan did
+            Entry** link = &this->m_slots[0][hash(id)];
+            while (*link != nullptr) {
+                link = &(*link)->next;
+            }
+            *link = entry;
+            entry->next = nullptr;
+        }
+        entry->lastUpdate = timeTag;
+        entry->buffer = val;
+    }
+
+    bool get(FwChanIdType id, Fw::Time& timeTag, Fw::TlmBuffer& val) {
+        // the chained table had to walk the chains of both telemetry sets
+        Entry* active = this->find(0, id);
+        Entry* inactive = this->find(1, id);
+        Entry* entry = (active != nullptr) ? active : inactive;
+        if (entry == nullptr) {
+            return false;
+        }
+        timeTag = entry->lastUpdate;
+        val = entry->buffer;
+        return true;
+    }
+
+  private:
+    static const FwChanIdType SLOTS = 15;
+    static const FwChanIdType MOD_VALUE = 99;
+
+    struct Entry {
+        FwChanIdType id;
+        Fw::Time lastUpdate;
+        Fw::TlmBuffer buffer;
+        Entry* next;
+    };
+
+    static FwChanIdType hash(FwChanIdType id) { return (id % MOD_VALUE) % SLOTS; }
+
+    Entry* find(U32 set, FwChanIdType id) {
+        Entry* entry = this->m_slots[set][hash(id)];
+        while ((entry != nullptr) && (entry->id != id)) {
+            entry = entry->next;
+        }
+        return entry;
+    }
+
+    Entry* m_slots[2][SLOTS];
+    Entry m_buckets[TLMCHAN_HASH_BUCKETS];
+    FwChanIdType m_free;
+};
+
+}  // namespace
+
 // ----------------------------------------------------------------------
 // Construction and destruction
 // ----------------------------------------------------------------------
@@ -135,6 +208,124 @@ void TlmChanTester::runOffNominal() {
     ASSERT_EQ(valid, Fw::TlmValid::INVALID);
 }
 
+void TlmChanTester::runUpdatedOnly() {
+    FwChanIdType ID_0[] = {0x100, 0x101, 0x102, 0x200, 0x201};
+
+    this->clearBuffs();
+    // send all updates
+    for (FwChanIdType n = 0; n < FW_NUM_ARRAY_ELEMENTS(ID_0); n++) {
+        this->sendBuff(ID_0[n], static_cast<U32>(n));
+    }
+    ASSERT_EQ(FW_NUM_ARRAY_ELEMENTS(ID_0), this->component.m_tlmEntries[0].numUpdated);
+    this->doRun(true);
+    for (FwChanIdType n = 0; n < FW_NUM_ARRAY_ELEMENTS(ID_0); n++) {
+        this->checkBuff(n, FW_NUM_ARRAY_ELEMENTS(ID_0), ID_0[n], static_cast<U32>(n));
+    }
+    ASSERT_EQ(0, this->component.m_tlmEntries[0].numUpdated);
+    ASSERT_EQ(0, this->component.m_tlmEntries[1].numUpdated);
+
+    // update a single channel twice, and only it should be sent
+    this->clearBuffs();
+    this->sendBuff(ID_0[3], 30);
+    this->sendBuff(ID_0[3], 31);
+    ASSERT_EQ(1, this->component.m_tlmEntries[1].numUpdated);
+    this->doRun(true);
+    ASSERT_EQ(1, this->m_numBuffs);
+    this->checkBuff(0, 1, ID_0[3], 31);
+
+    // nothing updated, so nothing should be sent
+    this->clearBuffs();
+    ASSERT_FALSE(this->doRun(false));
+    ASSERT_EQ(0, this->m_numBuffs);
+}
+
+namespace {
+
+//! Fill a table's worth of ids laid out like a deployment of components at 0x100 id spacing
+void fillDeploymentIds(FwChanIdType (&ids)[TLMCHAN_HASH_BUCKETS]) {
+    static const FwChanIdType CHANNELS_PER_COMPONENT = 20;
+    for (FwChanIdType n = 0; n < TLMCHAN_HASH_BUCKETS; n++) {
+        ids[n] = static_cast<FwChanIdType>(((n / CHANNELS_PER_COMPONENT) * 0x100) + (n % CHANNELS_PER_COMPONENT));
+    }
+}
+
+}  // namespace
+
+void TlmChanTester::runFullTable() {
+    FwChanIdType ids[TLMCHAN_HASH_BUCKETS];
+    fillDeploymentIds(ids);
+
+    Fw::TlmBuffer buff;
+    Fw::TlmBuffer readBack;
+    Fw::Time timeTag;
+    for (FwChanIdType n = 0; n < TLMCHAN_HASH_BUCKETS; n++) {
+        buff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, buff.serializeFrom(static_cast<U32>(n)));
+        this->component.TlmRecv_handler(0, ids[n], timeTag, buff);
+    }
+
+    // every channel reads back its own value from its own slot
+    U32 totalProbes = 0;
+    for (FwChanIdType n = 0; n < TLMCHAN_HASH_BUCKETS; n++) {
+        ASSERT_EQ(Fw::TlmValid::VALID, this->component.TlmGet_handler(0, ids[n], timeTag, readBack));
+        U32 value = 0;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, readBack.deserializeTo(value));
+        ASSERT_EQ(static_cast<U32>(n), value);
+
+        const FwChanIdType home = this->component.doHash(ids[n]);
+        ASSERT_LT(home, TLMCHAN_INDEX_SLOTS);
+        const FwChanIdType slot = this->component.findSlot(ids[n]);
+        ASSERT_TRUE(this->component.m_index[slot].used);
+        ASSERT_EQ(ids[n], this->component.m_index[slot].id);
+        totalProbes += static_cast<U32>(((slot - home) & (TLMCHAN_INDEX_SLOTS - 1)) + 1);
+    }
+    // a half-full index keeps linear probes short
+    ASSERT_LE(totalProbes, 2 * static_cast<U32>(TLMCHAN_HASH_BUCKETS));
+
+    // an id that was never written isn't found
+    ASSERT_EQ(Fw::TlmValid::INVALID, this->component.TlmGet_handler(0, 0xFFFF, timeTag, readBack));
+}
+
+void TlmChanTester::runPerformance() {
+    static const U32 ROUNDS = 200;
+    FwChanIdType ids[TLMCHAN_HASH_BUCKETS];
+    fillDeploymentIds(ids);
+
+    Fw::TlmBuffer buff;
+    Fw::TlmBuffer readBack;
+    Fw::Time timeTag;
+    buff.resetSer();
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, buff.serializeFrom(static_cast<U32>(0)));
+
+    auto* reference = new ChainedTlmTable();
+    auto start = std::chrono::steady_clock::now();
+    for (U32 round = 0; round < ROUNDS; round++) {
+        for (FwChanIdType n = 0; n < TLMCHAN_HASH_BUCKETS; n++) {
+            reference->update(ids[n], timeTag, buff);
+            ASSERT_TRUE(reference->get(ids[n], timeTag, readBack));
+        }
+    }
+    const auto chainedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    delete reference;
+
+    start = std::chrono::steady_clock::now();
+    for (U32 round = 0; round < ROUNDS; round++) {
+        for (FwChanIdType n = 0; n < TLMCHAN_HASH_BUCKETS; n++) {
+            this->component.TlmRecv_handler(0, ids[n], timeTag, buff);
+            ASSERT_EQ(Fw::TlmValid::VALID, this->component.TlmGet_handler(0, ids[n], timeTag, readBack));
+        }
+    }
+    const auto indexedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    const F64 operations = static_cast<F64>(ROUNDS) * static_cast<F64>(TLMCHAN_HASH_BUCKETS) * 2.0;
+    printf("TlmChan performance: %u channels, %u rounds\n", static_cast<unsigned int>(TLMCHAN_HASH_BUCKETS),
+           static_cast<unsigned int>(ROUNDS));
+    printf("  chained table: %.1f ns/op\n", static_cast<F64>(chainedNs) / operations);
+    printf("  channel index: %.1f ns/op\n", static_cast<F64>(indexedNs) / operations);
+}
+
 // ----------------------------------------------------------------------
 // Handlers for typed from ports
 // ----------------------------------------------------------------------
@@ -271,55 +462,21 @@ void TlmChanTester::dumpTlmEntry(TlmChan::TlmEntry* entry) {
     printf(
         "Entry "
         " Ptr: %p"
-        " id: 0x%" PRI_FwChanIdType " bucket: %" PRI_FwChanIdType " next: %p\n",
-        static_cast<void*>(entry), entry->id, entry->bucketNo, static_cast<void*>(entry->next));
+        " id: 0x%" PRI_FwChanIdType " used: %d updated: %d\n",
+        static_cast<void*>(entry), entry->id, entry->used, entry->updated);
 }
 
 void TlmChanTester::dumpHash() {
-    //        printf("**Buffer 0\n");
-    for (FwChanIdType slot = 0; slot < TLMCHAN_NUM_TLM_HASH_SLOTS; slot++) {
-        printf("Slot: %" PRI_FwChanIdType "\n", slot);
-        if (this->component.m_tlmEntries[0].slots[slot]) {
-            TlmChan::TlmEntry* entry = component.m_tlmEntries[0].slots[slot];
-            for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-                dumpTlmEntry(entry);
-                if (entry->next == nullptr) {
-                    break;
-                } else {
-                    entry = entry->next;
-                }
-            }
-        } else {
-            printf("EMPTY\n");
+    for (FwChanIdType slot = 0; slot < TLMCHAN_INDEX_SLOTS; slot++) {
+        if (this->component.m_index[slot].used) {
+            const FwChanIdType bucket = this->component.m_index[slot].bucket;
+            printf("Slot: %" PRI_FwChanIdType " home: %" PRI_FwChanIdType " bucket: %" PRI_FwChanIdType "\n", slot,
+                   this->component.doHash(this->component.m_index[slot].id), bucket);
+            dumpTlmEntry(&this->component.m_tlmEntries[0].buckets[bucket]);
+            dumpTlmEntry(&this->component.m_tlmEntries[1].buckets[bucket]);
         }
     }
     printf("\n");
-    //        for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-    //            printf("Bucket: %d ",bucket);
-    //            dumpTlmEntry(&m_impl.m_tlmEntries[0].buckets[bucket]);
-    //        }
-    //        printf("**Buffer 1\n");
-    //        for (FwChanIdType slot = 0; slot < TLMCHAN_NUM_TLM_HASH_SLOTS; slot++) {
-    //            printf("Slot: %d\n",slot);
-    //            if (m_impl.m_tlmEntries[1].slots[slot]) {
-    //                TlmChanImpl::TlmEntry* entry = m_impl.m_tlmEntries[1].slots[slot];
-    //                for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-    //                    dumpTlmEntry(entry);
-    //                    if (entry->next == 0) {
-    //                        break;
-    //                    } else {
-    //                        entry = entry->next;
-    //                    }
-    //                }
-    //            } else {
-    //                printf("EMPTY\n");
-    //            }
-    //        }
-    //        printf("\n");
-    //        for (FwChanIdType bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-    //            printf("Bucket: %d\n",bucket);
-    //            dumpTlmEntry(&m_impl.m_tlmEntries[1].buckets[bucket]);
-    //        }
 }
 
 void TlmChanTester ::connectPorts() {
@@ -34,6 +34,9 @@ class TlmChanTester : public TlmChanGTestBase {
     void runNominalChannel();
     void runMultiChannel();
     void runOffNominal();
+    void runUpdatedOnly();
+    void runFullTable();
+    void runPerformance();
 
   private:
     // ----------------------------------------------------------------------
@@ -31,6 +31,8 @@ TlmPacketizer ::TlmPacketizer(const char* const compName)
         this->m_tlmEntries.buckets[entry].bucketNo = entry;
         this->m_tlmEntries.buckets[entry].next = nullptr;
         this->m_tlmEntries.buckets[entry].id = 0;
+        this->m_tlmEntries.buckets[entry].firstPlacement = 0;
+        this->m_tlmEntries.buckets[entry].numPlacements = 0;
     }
     // clear free index
     this->m_tlmEntries.free = 0;
@@ -56,6 +58,34 @@ void TlmPacketizer::setPacketList(const TlmPacketizerPacketList& packetList,
     FW_ASSERT(packetList.list);
     FW_ASSERT(ignoreList.list);
     FW_ASSERT(packetList.numEntries <= MAX_PACKETIZER_PACKETS, static_cast<FwAssertArgType>(packetList.numEntries));
+    // clear the placements of any channel already stored, so the count below starts from zero
+    for (FwChanIdType bucket = 0; bucket < this->m_tlmEntries.free; bucket++) {
+        this->m_tlmEntries.buckets[bucket].firstPlacement = 0;
+        this->m_tlmEntries.buckets[bucket].numPlacements = 0;
+    }
+    // count the packets holding each channel so the placements of a channel can be stored contiguously
+    for (FwChanIdType pktEntry = 0; pktEntry < packetList.numEntries; pktEntry++) {
+        FW_ASSERT(packetList.list[pktEntry]->list, static_cast<FwAssertArgType>(pktEntry));
+        for (FwChanIdType tlmEntry = 0; tlmEntry < packetList.list[pktEntry]->numEntries; tlmEntry++) {
+            FwChanIdType id = packetList.list[pktEntry]->list[tlmEntry].id;
+            TlmEntry* entryToUse = this->findBucket(id);
+            FW_ASSERT(entryToUse);
+            entryToUse->used = true;
+            entryToUse->id = id;
+            entryToUse->numPlacements++;
+        }
+    }
+    // assign each channel its range of placements
+    FwChanIdType numPlacements = 0;
+    for (FwChanIdType bucket = 0; bucket < this->m_tlmEntries.free; bucket++) {
+        TlmEntry& entry = this->m_tlmEntries.buckets[bucket];
+        FW_ASSERT(entry.numPlacements <= TLMPACKETIZER_MAX_CHANNEL_PLACEMENTS - numPlacements,
+                  static_cast<FwAssertArgType>(entry.numPlacements), static_cast<FwAssertArgType>(numPlacements));
+        entry.firstPlacement = numPlacements;
+        numPlacements = static_cast<FwChanIdType>(numPlacements + entry.numPlacements);
+        // reset count so it can be used to fill the placements below
+        entry.numPlacements = 0;
+    }
     // validate packet sizes against maximum com buffer size and populate hash
     // table
     for (FwChanIdType pktEntry = 0; pktEntry < packetList.numEntries; pktEntry++) {
@@ -77,10 +107,10 @@ void TlmPacketizer::setPacketList(const TlmPacketizerPacketList& packetList,
             entryToUse->hasValue = false;
             entryToUse->channelSize = packetList.list[pktEntry]->list[tlmEntry].size;
             // the offset into the buffer will be the current packet length
-            // the offset must fit within FwSignedSizeType to allow for negative values
-            FW_ASSERT(packetLen <= static_cast<FwSizeType>(std::numeric_limits<FwSignedSizeType>::max()),
-                      static_cast<FwAssertArgType>(packetLen));
-            entryToUse->packetOffset[pktEntry] = static_cast<FwSignedSizeType>(packetLen);
+            PacketPlacement& placement =
+                this->m_placements[entryToUse->firstPlacement + entryToUse->numPlacements++];
+            placement.packet = pktEntry;
+            placement.offset = packetLen;
 
             packetLen += entryToUse->channelSize;
 
@@ -163,10 +193,8 @@ TlmPacketizer::TlmEntry* TlmPacketizer::findBucket(FwChanIdType id) {
                 prevEntry->next = entryToUse;
                 // clear next pointer
                 entryToUse->next = nullptr;
-                // set all packet offsets to -1 for new entry
-                for (FwChanIdType pktOffsetEntry = 0; pktOffsetEntry < MAX_PACKETIZER_PACKETS; pktOffsetEntry++) {
-                    entryToUse->packetOffset[pktOffsetEntry] = -1;
-                }
+                // new entry is not in any packets
+                entryToUse->numPlacements = 0;
                 break;
             }
         }
@@ -178,10 +206,8 @@ TlmPacketizer::TlmEntry* TlmPacketizer::findBucket(FwChanIdType id) {
         this->m_tlmEntries.slots[index] = &this->m_tlmEntries.buckets[this->m_tlmEntries.free++];
         entryToUse = this->m_tlmEntries.slots[index];
         entryToUse->next = nullptr;
-        // set all packet offsets to -1 for new entry
-        for (FwChanIdType pktOffsetEntry = 0; pktOffsetEntry < MAX_PACKETIZER_PACKETS; pktOffsetEntry++) {
-            entryToUse->packetOffset[pktOffsetEntry] = -1;
-        }
+        // new entry is not in any packets
+        entryToUse->numPlacements = 0;
     }
 
     return entryToUse;
@@ -228,21 +254,19 @@ void TlmPacketizer ::TlmRecv_handler(const FwIndexType portNum,
     }
 
     // copy telemetry value into active buffers
-    for (FwChanIdType pkt = 0; pkt < MAX_PACKETIZER_PACKETS; pkt++) {
-        // check if current packet has this channel
-        if (entryToUse->packetOffset[pkt] != -1) {
-            // get destination address
-            this->m_lock.lock();
-            this->m_fillBuffers[pkt].updated = true;
-            this->m_fillBuffers[pkt].latestTime = timeTag;
-            U8* ptr = &this->m_fillBuffers[pkt].buffer.getBuffAddr()[entryToUse->packetOffset[pkt]];
-            (void)memcpy(ptr, val.getBuffAddr(), static_cast<size_t>(val.getSize()));
-            // record that this chan has a value. could do this outside of the loop only once
-            // but then we'd need to grab the lock again.
-            entryToUse->hasValue = true;
-            this->m_lock.unLock();
-        }
+    // the lock is taken once for all of the packets holding the channel
+    this->m_lock.lock();
+    for (FwChanIdType placementNum = 0; placementNum < entryToUse->numPlacements; placementNum++) {
+        const PacketPlacement& placement = this->m_placements[entryToUse->firstPlacement + placementNum];
+        BufferEntry& fillBuffer = this->m_fillBuffers[placement.packet];
+        fillBuffer.updated = true;
+        fillBuffer.latestTime = timeTag;
+        U8* ptr = &fillBuffer.buffer.getBuffAddr()[placement.offset];
+        (void)memcpy(ptr, val.getBuffAddr(), static_cast<size_t>(val.getSize()));
     }
+    // record that this chan has a value
+    entryToUse->hasValue = true;
+    this->m_lock.unLock();
 }
 
 //! Handler for input port TlmGet
@@ -299,30 +323,20 @@ Fw::TlmValid TlmPacketizer ::TlmGet_handler(FwIndexType portNum,  //!< The port
               static_cast<FwAssertArgType>(val.getCapacity()));
 
     // okay, we have the matching entry.
-    // go over each packet and find the first one which stores this channel
+    // this was not an ignored channel so it must be in a packet somewhere
+    FW_ASSERT(entryToUse->numPlacements > 0, static_cast<FwAssertArgType>(entryToUse->id));
 
-    for (FwChanIdType pkt = 0; pkt < MAX_PACKETIZER_PACKETS; pkt++) {
-        // check if current packet has this channel
-        if (entryToUse->packetOffset[pkt] != -1) {
-            // okay, it has the channel. copy chan val into the tlm buf
-            this->m_lock.lock();
-            timeTag = this->m_fillBuffers[pkt].latestTime;
-            U8* ptr = &this->m_fillBuffers[pkt].buffer.getBuffAddr()[entryToUse->packetOffset[pkt]];
-            (void)memcpy(val.getBuffAddr(), ptr, static_cast<size_t>(entryToUse->channelSize));
-            // set buf len to the channelSize. keep in mind, this is the MAX serialized size of the channel.
-            // so we may actually be filling val with some junk after the value of the channel.
-            FW_ASSERT(val.setBuffLen(entryToUse->channelSize) == Fw::SerializeStatus::FW_SERIALIZE_OK);
-            this->m_lock.unLock();
-            return Fw::TlmValid::VALID;
-        }
-    }
-
-    // did not find a packet which stores this channel.
-    // coding error, this was not an ignored channel so it must be in a packet somewhere
-    FW_ASSERT(0, static_cast<FwAssertArgType>(entryToUse->id));
-    // TPP (tim paranoia principle)
-    val.resetSer();
-    return Fw::TlmValid::INVALID;
+    // copy chan val from the first packet which stores this channel into the tlm buf
+    const PacketPlacement& placement = this->m_placements[entryToUse->firstPlacement];
+    this->m_lock.lock();
+    timeTag = this->m_fillBuffers[placement.packet].latestTime;
+    U8* ptr = &this->m_fillBuffers[placement.packet].buffer.getBuffAddr()[placement.offset];
+    (void)memcpy(val.getBuffAddr(), ptr, static_cast<size_t>(entryToUse->channelSize));
+    // set buf len to the channelSize. keep in mind, this is the MAX serialized size of the channel.
+    // so we may actually be filling val with some junk after the value of the channel.
+    FW_ASSERT(val.setBuffLen(entryToUse->channelSize) == Fw::SerializeStatus::FW_SERIALIZE_OK);
+    this->m_lock.unLock();
+    return Fw::TlmValid::VALID;
 }
 
 void TlmPacketizer ::Run_handler(const FwIndexType portNum, U32 context) {
@@ -104,17 +104,25 @@ class TlmPacketizer final : public TlmPacketizerComponentBase {
     // buffers for sending - will be copied from fill buffers
     BufferEntry m_sendBuffers[MAX_PACKETIZER_PACKETS];
 
+    //! Location of a channel value in a packet buffer
+    struct PacketPlacement {
+        FwChanIdType packet;  //!< index of the packet holding the channel
+        FwSizeType offset;    //!< offset of the channel value in the packet buffer
+    };
+
+    //! Placements of all packetized channels. The placements of each channel are stored contiguously.
+    PacketPlacement m_placements[TLMPACKETIZER_MAX_CHANNEL_PLACEMENTS];
+
     struct TlmEntry {
-        FwChanIdType id;  //!< telemetry id stored in slot
-        // Offsets into packet buffers.
-        // -1 means that channel is not in that packet
-        FwSignedSizeType packetOffset[MAX_PACKETIZER_PACKETS];
-        FwSizeType channelSize;  //!< max serialized size of the channel in bytes
-        TlmEntry* next;          //!< pointer to next bucket in table
-        bool used;               //!< if entry has been used
-        bool ignored;            //!< ignored packet id
-        bool hasValue;           //!< if the entry has received a value at least once
-        FwChanIdType bucketNo;   //!< for testing
+        FwChanIdType id;              //!< telemetry id stored in slot
+        FwChanIdType firstPlacement;  //!< index of the first placement of the channel in m_placements
+        FwChanIdType numPlacements;   //!< number of packets holding the channel
+        FwSizeType channelSize;       //!< max serialized size of the channel in bytes
+        TlmEntry* next;               //!< pointer to next bucket in table
+        bool used;                    //!< if entry has been used
+        bool ignored;                 //!< ignored packet id
+        bool hasValue;                //!< if the entry has received a value at least once
+        FwChanIdType bucketNo;        //!< for testing
     };
 
     struct TlmSet {
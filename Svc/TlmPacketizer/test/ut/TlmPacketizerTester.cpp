@@ -940,6 +940,101 @@ void TlmPacketizerTester ::getChannelValueTest() {
     ASSERT_EQ(valid, Fw::TlmValid::INVALID);
 }
 
+// Channel 10 is placed in three packets, at a different offset in each
+TlmPacketizerChannelEntry multiPacket1List[] = {{10, 4}, {100, 2}};
+
+TlmPacketizerChannelEntry multiPacket2List[] = {{13, 8}, {10, 4}};
+
+TlmPacketizerChannelEntry multiPacket3List[] = {{10, 4}};
+
+TlmPacketizerChannelEntry multiPacket4List[] = {{100, 2}};
+
+TlmPacketizerPacket multiPacket1 = {multiPacket1List, 20, 1, FW_NUM_ARRAY_ELEMENTS(multiPacket1List)};
+
+TlmPacketizerPacket multiPacket2 = {multiPacket2List, 21, 1, FW_NUM_ARRAY_ELEMENTS(multiPacket2List)};
+
+TlmPacketizerPacket multiPacket3 = {multiPacket3List, 22, 1, FW_NUM_ARRAY_ELEMENTS(multiPacket3List)};
+
+TlmPacketizerPacket multiPacket4 = {multiPacket4List, 23, 1, FW_NUM_ARRAY_ELEMENTS(multiPacket4List)};
+
+TlmPacketizerPacketList multiPacketList = {{&multiPacket1, &multiPacket2, &multiPacket3, &multiPacket4}, 4};
+
+void TlmPacketizerTester ::multiPacketChannelTest() {
+    this->component.setPacketList(multiPacketList, ignore, 1);
+    Fw::Time ts;
+    Fw::TlmBuffer buff;
+    Fw::ComBuffer comBuff;
+
+    // each update of the channel is written to every packet that holds it
+    for (U32 value = 20; value <= 21; value++) {
+        ts.set(100 + value, 0);
+        buff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, buff.serializeFrom(value));
+        this->invoke_to_TlmRecv(0, 10, ts, buff);
+
+        this->clearFromPortHistory();
+        this->invoke_to_Run(0, 0);
+        this->component.doDispatch();
+
+        // the three packets holding the channel are sent, the one that doesn't isn't
+        ASSERT_from_PktSend_SIZE(3);
+
+        comBuff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwPacketDescriptorType>(
+                                           Fw::ComPacketType::FW_PACKET_PACKETIZED_TLM)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwTlmPacketizeIdType>(20)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(ts));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(value));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<U16>(0)));
+        ASSERT_from_PktSend(0, comBuff, static_cast<U32>(0));
+
+        comBuff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwPacketDescriptorType>(
+                                           Fw::ComPacketType::FW_PACKET_PACKETIZED_TLM)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwTlmPacketizeIdType>(21)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(ts));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<U64>(0)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(value));
+        ASSERT_from_PktSend(1, comBuff, static_cast<U32>(0));
+
+        comBuff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwPacketDescriptorType>(
+                                           Fw::ComPacketType::FW_PACKET_PACKETIZED_TLM)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwTlmPacketizeIdType>(22)));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(ts));
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(value));
+        ASSERT_from_PktSend(2, comBuff, static_cast<U32>(0));
+    }
+
+    // another channel sharing a packet leaves the multi-packet channel's value in place
+    ts.add(1, 0);
+    buff.resetSer();
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, buff.serializeFrom(static_cast<U16>(15)));
+    this->invoke_to_TlmRecv(0, 100, ts, buff);
+
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    this->component.doDispatch();
+    ASSERT_from_PktSend_SIZE(2);
+
+    comBuff.resetSer();
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK,
+              comBuff.serializeFrom(static_cast<FwPacketDescriptorType>(Fw::ComPacketType::FW_PACKET_PACKETIZED_TLM)));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwTlmPacketizeIdType>(20)));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(ts));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<U32>(21)));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<U16>(15)));
+    ASSERT_from_PktSend(0, comBuff, static_cast<U32>(0));
+
+    comBuff.resetSer();
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK,
+              comBuff.serializeFrom(static_cast<FwPacketDescriptorType>(Fw::ComPacketType::FW_PACKET_PACKETIZED_TLM)));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<FwTlmPacketizeIdType>(23)));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(ts));
+    ASSERT_EQ(Fw::FW_SERIALIZE_OK, comBuff.serializeFrom(static_cast<U16>(15)));
+    ASSERT_from_PktSend(1, comBuff, static_cast<U32>(0));
+}
+
 // ----------------------------------------------------------------------
 // Handlers for typed from ports
 // ----------------------------------------------------------------------
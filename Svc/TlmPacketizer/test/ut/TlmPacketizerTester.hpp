@@ -79,6 +79,10 @@ class TlmPacketizerTester : public TlmPacketizerGTestBase {
     //!
     void getChannelValueTest(void);
 
+    //! channel in multiple packets test
+    //!
+    void multiPacketChannelTest(void);
+
   private:
     // ----------------------------------------------------------------------
     // Handlers for typed from ports
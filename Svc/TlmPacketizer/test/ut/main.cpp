@@ -75,6 +75,12 @@ TEST(TestNominal, TlmGetTest) {
     tester.getChannelValueTest();
 }
 
+TEST(TestNominal, MultiPacketChannelTest) {
+    TEST_CASE(100.1.9, "Channel in multiple packets");
+    Svc::TlmPacketizerTester tester;
+    tester.multiPacketChannelTest();
+}
+
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -11,6 +11,7 @@
 // ======================================================================
 
 #include <Utils/Hash/Hash.hpp>
+#include <Utils/Hash/libcrc/CRC32Engine.hpp>
 
 static_assert(sizeof(unsigned long) >= sizeof(U32), "CRC32 cannot fit in CRC32 library chosen types");
 
@@ -26,11 +27,7 @@ void Hash ::hash(const void* const data, const FwSizeType len, HashBuffer& buffe
     HASH_HANDLE_TYPE local_hash_handle;
     local_hash_handle = 0xffffffffL;
     FW_ASSERT(data);
-    char c;
-    for (FwSizeType index = 0; index < len; index++) {
-        c = static_cast<const char*>(data)[index];
-        local_hash_handle = static_cast<HASH_HANDLE_TYPE>(update_crc_32(local_hash_handle, c));
-    }
+    local_hash_handle = CRC32Engine::update(local_hash_handle, data, len);
     HashBuffer bufferOut;
     // For CRC32 we need to return the one's complement of the result:
     Fw::SerializeStatus status = bufferOut.serializeFrom(~(local_hash_handle));
@@ -44,11 +41,7 @@ void Hash ::init() {
 
 void Hash ::update(const void* const data, FwSizeType len) {
     FW_ASSERT(data);
-    char c;
-    for (FwSizeType index = 0; index < len; index++) {
-        c = static_cast<const char*>(data)[index];
-        this->hash_handle = static_cast<HASH_HANDLE_TYPE>(update_crc_32(this->hash_handle, c));
-    }
+    this->hash_handle = CRC32Engine::update(this->hash_handle, data, len);
 }
 
 void Hash ::final(HashBuffer& buffer) {
@@ -0,0 +1,234 @@
+// ======================================================================
+// \title  CRC32Engine.cpp
+// \brief  cpp file for the block CRC32 engine used by the CRC32 Hash
+// ======================================================================
+
+#include <Utils/Hash/libcrc/CRC32Engine.hpp>
+#include <atomic>
+#include <cstring>
+#include "Fw/Types/Assert.hpp"
+
+#if UTILS_CRC32_HARDWARE && defined(__GNUC__) && defined(__x86_64__)
+#define UTILS_CRC32_PCLMUL (1)
+#include <immintrin.h>
+#elif UTILS_CRC32_HARDWARE && defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#define UTILS_CRC32_ARM (1)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#endif
+
+namespace Utils {
+
+namespace {
+
+//! Reflected CRC32 polynomial, as P_32 in lib_crc
+constexpr U32 POLYNOMIAL = 0xEDB88320;
+
+//! Slice-by-8 tables. Entry [0][b] is the CRC of byte b; entry [k][b] is the CRC of byte b followed by k zero bytes.
+struct SliceTables {
+    U32 entries[8][256];
+};
+
+constexpr SliceTables makeSliceTables() {
+    SliceTables tables = {};
+    for (U32 byte = 0; byte < 256; byte++) {
+        U32 crc = byte;
+        for (U32 bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ POLYNOMIAL) : (crc >> 1);
+        }
+        tables.entries[0][byte] = crc;
+    }
+    for (U32 slice = 1; slice < 8; slice++) {
+        for (U32 byte = 0; byte < 256; byte++) {
+            const U32 previous = tables.entries[slice - 1][byte];
+            tables.entries[slice][byte] = (previous >> 8) ^ tables.entries[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr SliceTables SLICE_TABLES = makeSliceTables();
+static_assert(SLICE_TABLES.entries[0][1] == 0x77073096, "Unexpected CRC32 table");
+static_assert(SLICE_TABLES.entries[0][255] == 0x2D02EF8D, "Unexpected CRC32 table");
+
+//! Read a little endian U32, the byte order in which the reflected CRC consumes data
+inline U32 readLittleEndian(const U8* data) {
+    return static_cast<U32>(data[0]) | (static_cast<U32>(data[1]) << 8) | (static_cast<U32>(data[2]) << 16) |
+           (static_cast<U32>(data[3]) << 24);
+}
+
+U32 sliceBy8(U32 crc, const U8* data, FwSizeType len) {
+    const U32(&table)[8][256] = SLICE_TABLES.entries;
+    while (len >= 8) {
+        const U32 low = readLittleEndian(data) ^ crc;
+        const U32 high = readLittleEndian(data + 4);
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^
+              table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^ table[1][(high >> 16) & 0xFF] ^
+              table[0][high >> 24];
+        data += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data) & 0xFF];
+        data++;
+        len--;
+    }
+    return crc;
+}
+
+#if UTILS_CRC32_PCLMUL
+//! Smallest block handed to the folding implementation, which folds four 16-byte lanes
+constexpr FwSizeType PCLMUL_MINIMUM = 64;
+
+//! Fold 16-byte multiples of data into the CRC register using carry-less multiplication, following Intel's "Fast CRC
+//! Computation for Generic Polynomials Using PCLMULQDQ Instruction" with the bit-reflected constants for CRC32.
+//! \param len: length of the data, at least PCLMUL_MINIMUM and a multiple of 16
+__attribute__((target("pclmul,sse4.1"))) U32 foldPclmul(U32 crc, const U8* data, FwSizeType len) {
+    alignas(16) static const U64 K1K2[2] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const U64 K3K4[2] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const U64 K5K0[2] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const U64 POLY[2] = {0x01db710641, 0x01f7011641};
+
+    // Load the first 64 bytes into four lanes, with the register folded into the first
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(K1K2));
+    data += 64;
+    len -= 64;
+
+    // Fold 64 bytes at a time into the four lanes
+    while (len >= 64) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        const __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        const __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+        data += 64;
+        len -= 64;
+    }
+
+    // Fold the four lanes into one
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(K3K4));
+    const __m128i lanes[3] = {x2, x3, x4};
+    for (const __m128i& lane : lanes) {
+        const __m128i low = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), lane), low);
+    }
+
+    // Fold the remaining 16 byte blocks
+    while (len >= 16) {
+        const __m128i low = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))),
+                           low);
+        data += 16;
+        len -= 16;
+    }
+    FW_ASSERT(len == 0, static_cast<FwAssertArgType>(len));
+
+    // Fold 128 bits down to 64 bits
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x0 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x0);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(K5K0));
+    x0 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00), x0);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(POLY));
+    x0 = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10), mask);
+    x1 = _mm_xor_si128(x1, _mm_clmulepi64_si128(x0, k, 0x00));
+    return static_cast<U32>(_mm_extract_epi32(x1, 1));
+}
+#endif
+
+#if UTILS_CRC32_ARM
+#if defined(__clang__)
+#define UTILS_CRC32_ARM_TARGET "crc"
+#else
+#define UTILS_CRC32_ARM_TARGET "+crc"
+#endif
+
+//! Update the CRC register with the ARMv8 CRC32 instructions, eight bytes at a time
+__attribute__((target(UTILS_CRC32_ARM_TARGET))) U32 updateArm(U32 crc, const U8* data, FwSizeType len) {
+    while (len >= 8) {
+        // The instruction consumes the value least significant byte first, which is memory order on AArch64 Linux
+        U64 value = 0;
+        (void)::memcpy(&value, data, sizeof value);
+        crc = __crc32d(crc, value);
+        data += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        crc = __crc32b(crc, *data);
+        data++;
+        len--;
+    }
+    return crc;
+}
+#endif
+
+CRC32Engine::Implementation detectImplementation() {
+#if UTILS_CRC32_PCLMUL
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+        return CRC32Engine::PCLMUL;
+    }
+#elif UTILS_CRC32_ARM
+    if ((::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) {
+        return CRC32Engine::ARM_CRC;
+    }
+#endif
+    return CRC32Engine::SLICE_BY_8;
+}
+
+//! Implementation detected on first use. Detection always gives the same answer, so concurrent first uses are benign.
+constexpr U8 IMPLEMENTATION_UNKNOWN = 0xFF;
+std::atomic<U8> s_implementation(IMPLEMENTATION_UNKNOWN);
+
+}  // namespace
+
+CRC32Engine::Implementation CRC32Engine::implementation() {
+    U8 implementation = s_implementation.load(std::memory_order_relaxed);
+    if (implementation == IMPLEMENTATION_UNKNOWN) {
+        implementation = static_cast<U8>(detectImplementation());
+        s_implementation.store(implementation, std::memory_order_relaxed);
+    }
+    return static_cast<Implementation>(implementation);
+}
+
+U32 CRC32Engine::updateSliceBy8(U32 crc, const void* data, FwSizeType len) {
+    FW_ASSERT(data != nullptr);
+    return sliceBy8(crc, static_cast<const U8*>(data), len);
+}
+
+U32 CRC32Engine::update(U32 crc, const void* data, FwSizeType len) {
+    FW_ASSERT(data != nullptr);
+    const U8* bytes = static_cast<const U8*>(data);
+#if UTILS_CRC32_PCLMUL
+    if ((len >= PCLMUL_MINIMUM) && (implementation() == PCLMUL)) {
+        // Fold whole 16 byte blocks and finish the tail with the tables
+        const FwSizeType folded = len & ~static_cast<FwSizeType>(0xF);
+        crc = foldPclmul(crc, bytes, folded);
+        bytes += folded;
+        len -= folded;
+    }
+#elif UTILS_CRC32_ARM
+    if (implementation() == ARM_CRC) {
+        return updateArm(crc, bytes, len);
+    }
+#endif
+    return sliceBy8(crc, bytes, len);
+}
+
+}  // namespace Utils
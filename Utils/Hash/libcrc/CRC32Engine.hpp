@@ -0,0 +1,60 @@
+// ======================================================================
+// \title  CRC32Engine.hpp
+// \brief  hpp file for the block CRC32 engine used by the CRC32 Hash
+// ======================================================================
+
+#ifndef UTILS_CRC32_ENGINE_HPP
+#define UTILS_CRC32_ENGINE_HPP
+
+#include "Fw/FPrimeBasicTypes.hpp"
+
+//! Set to 0 to build the CRC32 engine without the processor specific CRC instructions. The portable slice-by-8
+//! implementation is then always used.
+#ifndef UTILS_CRC32_HARDWARE
+#define UTILS_CRC32_HARDWARE (1)
+#endif
+
+namespace Utils {
+
+//! \class CRC32Engine
+//! \brief CRC32 (IEEE 802.3, reflected polynomial 0xEDB88320) over blocks of data
+//!
+//! The engine updates the CRC register used by the CRC32 Hash implementation and by lib_crc's `update_crc_32`: the
+//! register starts at 0xFFFFFFFF and the final CRC is its one's complement. Each implementation gives the same result
+//! as updating the register one byte at a time.
+//!
+//! The portable implementation processes eight bytes per step using eight 256-entry tables built at compile time.
+//! When `UTILS_CRC32_HARDWARE` is set, `update` checks once at run time whether the processor offers carry-less
+//! multiplication (x86-64 PCLMULQDQ) or CRC32 instructions (ARMv8 CRC extension on Linux) and uses them for the
+//! data they cover.
+class CRC32Engine {
+  public:
+    //! Implementation selected by `update`
+    enum Implementation {
+        SLICE_BY_8,  //!< Portable table implementation
+        PCLMUL,      //!< x86-64 carry-less multiplication folding
+        ARM_CRC,     //!< ARMv8 CRC32 instructions
+    };
+
+    //! Update a CRC register with data using the fastest implementation available
+    //! \param crc: CRC register value
+    //! \param data: pointer to start of data
+    //! \param len: length of the data
+    //! \return updated CRC register value
+    static U32 update(U32 crc, const void* data, FwSizeType len);
+
+    //! Update a CRC register with data using the portable implementation
+    //! \param crc: CRC register value
+    //! \param data: pointer to start of data
+    //! \param len: length of the data
+    //! \return updated CRC register value
+    static U32 updateSliceBy8(U32 crc, const void* data, FwSizeType len);
+
+    //! Get the implementation selected by `update` on this processor
+    //! \return selected implementation
+    static Implementation implementation();
+};
+
+}  // namespace Utils
+
+#endif
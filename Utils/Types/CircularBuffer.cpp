@@ -15,14 +15,27 @@
 #include <Fw/FPrimeBasicTypes.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <Utils/Types/CircularBuffer.hpp>
+#include <cstring>
 
 namespace Types {
 
 CircularBuffer ::CircularBuffer()
-    : m_store(nullptr), m_store_size(0), m_head_idx(0), m_allocated_size(0), m_high_water_mark(0) {}
+    : m_store(nullptr),
+      m_store_size(0),
+      m_idx_mask(0),
+      m_masked(false),
+      m_head_idx(0),
+      m_allocated_size(0),
+      m_high_water_mark(0) {}
 
 CircularBuffer ::CircularBuffer(U8* const buffer, const FwSizeType size)
-    : m_store(nullptr), m_store_size(0), m_head_idx(0), m_allocated_size(0), m_high_water_mark(0) {
+    : m_store(nullptr),
+      m_store_size(0),
+      m_idx_mask(0),
+      m_masked(false),
+      m_head_idx(0),
+      m_allocated_size(0),
+      m_high_water_mark(0) {
     setup(buffer, size);
 }
 
@@ -34,6 +47,8 @@ void CircularBuffer ::setup(U8* const buffer, const FwSizeType size) {
     // Initialize buffer data
     m_store = buffer;
     m_store_size = size;
+    m_masked = (size & (size - 1)) == 0;
+    m_idx_mask = size - 1;
     m_head_idx = 0;
     m_allocated_size = 0;
     m_high_water_mark = 0;
@@ -51,7 +66,31 @@ FwSizeType CircularBuffer ::get_free_size() const {
 
 FwSizeType CircularBuffer ::advance_idx(FwSizeType idx, FwSizeType amount) const {
     FW_ASSERT(idx < m_store_size, static_cast<FwAssertArgType>(idx));
-    return (idx + amount) % m_store_size;
+    FW_ASSERT(amount <= m_store_size, static_cast<FwAssertArgType>(amount));
+    if (m_masked) {
+        return (idx + amount) & m_idx_mask;
+    }
+    // Written to avoid overflow of idx + amount
+    const FwSizeType to_end = m_store_size - idx;
+    return (amount < to_end) ? (idx + amount) : (amount - to_end);
+}
+
+void CircularBuffer ::copy_in(FwSizeType idx, const U8* source, FwSizeType size) {
+    FW_ASSERT(idx < m_store_size, static_cast<FwAssertArgType>(idx));
+    FW_ASSERT(size <= m_store_size, static_cast<FwAssertArgType>(size));
+    const FwSizeType to_end = m_store_size - idx;
+    const FwSizeType first = (size < to_end) ? size : to_end;
+    (void)::memcpy(&m_store[idx], source, static_cast<size_t>(first));
+    (void)::memcpy(m_store, source + first, static_cast<size_t>(size - first));
+}
+
+void CircularBuffer ::copy_out(FwSizeType idx, U8* destination, FwSizeType size) const {
+    FW_ASSERT(idx < m_store_size, static_cast<FwAssertArgType>(idx));
+    FW_ASSERT(size <= m_store_size, static_cast<FwAssertArgType>(size));
+    const FwSizeType to_end = m_store_size - idx;
+    const FwSizeType first = (size < to_end) ? size : to_end;
+    (void)::memcpy(destination, &m_store[idx], static_cast<size_t>(first));
+    (void)::memcpy(destination + first, m_store, static_cast<size_t>(size - first));
 }
 
 Fw::SerializeStatus CircularBuffer ::serialize(const U8* const buffer, const FwSizeType size) {
@@ -62,16 +101,8 @@ Fw::SerializeStatus CircularBuffer ::serialize(const U8* const buffer, const FwS
         return Fw::FW_SERIALIZE_NO_ROOM_LEFT;
     }
     // Copy in all the supplied data
-    FwSizeType idx = advance_idx(m_head_idx, m_allocated_size);
-    for (U32 i = 0; i < size; i++) {
-        FW_ASSERT(idx < m_store_size, static_cast<FwAssertArgType>(idx));
-        m_store[idx] = buffer[i];
-        idx = advance_idx(idx);
-    }
-    m_allocated_size += size;
-    FW_ASSERT(m_allocated_size <= this->get_capacity(), static_cast<FwAssertArgType>(m_allocated_size));
-    m_high_water_mark = (m_high_water_mark > m_allocated_size) ? m_high_water_mark : m_allocated_size;
-    return Fw::FW_SERIALIZE_OK;
+    copy_in(advance_idx(m_head_idx, m_allocated_size), buffer, size);
+    return commit_write(size);
 }
 
 Fw::SerializeStatus CircularBuffer ::peek(char& value, FwSizeType offset) const {
@@ -93,18 +124,15 @@ Fw::SerializeStatus CircularBuffer ::peek(U8& value, FwSizeType offset) const {
 
 Fw::SerializeStatus CircularBuffer ::peek(U32& value, FwSizeType offset) const {
     FW_ASSERT(m_store != nullptr && m_store_size != 0);  // setup method was called
-    // Check there is sufficient data
-    if ((sizeof(U32) + offset) > m_allocated_size) {
-        return Fw::FW_DESERIALIZE_BUFFER_EMPTY;
+    U8 bytes[sizeof(U32)];
+    const Fw::SerializeStatus status = peek(bytes, sizeof(bytes), offset);
+    if (status != Fw::FW_SERIALIZE_OK) {
+        return status;
     }
     value = 0;
-    FwSizeType idx = advance_idx(m_head_idx, offset);
-
     // Deserialize all the bytes from network format
     for (FwSizeType i = 0; i < sizeof(U32); i++) {
-        FW_ASSERT(idx < m_store_size, static_cast<FwAssertArgType>(idx));
-        value = (value << 8) | static_cast<U32>(m_store[idx]);
-        idx = advance_idx(idx);
+        value = (value << 8) | static_cast<U32>(bytes[i]);
     }
     return Fw::FW_SERIALIZE_OK;
 }
@@ -116,13 +144,37 @@ Fw::SerializeStatus CircularBuffer ::peek(U8* buffer, FwSizeType size, FwSizeTyp
     if ((size + offset) > m_allocated_size) {
         return Fw::FW_DESERIALIZE_BUFFER_EMPTY;
     }
-    FwSizeType idx = advance_idx(m_head_idx, offset);
-    // Deserialize all the bytes from network format
-    for (FwSizeType i = 0; i < size; i++) {
-        FW_ASSERT(idx < m_store_size, static_cast<FwAssertArgType>(idx));
-        buffer[i] = m_store[idx];
-        idx = advance_idx(idx);
+    copy_out(advance_idx(m_head_idx, offset), buffer, size);
+    return Fw::FW_SERIALIZE_OK;
+}
+
+const U8* CircularBuffer ::contiguous_read_span(FwSizeType& size, FwSizeType offset) const {
+    FW_ASSERT(m_store != nullptr && m_store_size != 0);  // setup method was called
+    const FwSizeType available = (offset < m_allocated_size) ? (m_allocated_size - offset) : 0;
+    const FwSizeType idx = advance_idx(m_head_idx, (available > 0) ? offset : m_allocated_size);
+    const FwSizeType to_end = m_store_size - idx;
+    size = (available < to_end) ? available : to_end;
+    return &m_store[idx];
+}
+
+U8* CircularBuffer ::contiguous_write_span(FwSizeType& size) {
+    FW_ASSERT(m_store != nullptr && m_store_size != 0);  // setup method was called
+    const FwSizeType idx = advance_idx(m_head_idx, m_allocated_size);
+    const FwSizeType free_size = get_free_size();
+    const FwSizeType to_end = m_store_size - idx;
+    size = (free_size < to_end) ? free_size : to_end;
+    return &m_store[idx];
+}
+
+Fw::SerializeStatus CircularBuffer ::commit_write(FwSizeType amount) {
+    FW_ASSERT(m_store != nullptr && m_store_size != 0);  // setup method was called
+    // Check there is sufficient space
+    if (amount > get_free_size()) {
+        return Fw::FW_SERIALIZE_NO_ROOM_LEFT;
     }
+    m_allocated_size += amount;
+    FW_ASSERT(m_allocated_size <= this->get_capacity(), static_cast<FwAssertArgType>(m_allocated_size));
+    m_high_water_mark = (m_high_water_mark > m_allocated_size) ? m_high_water_mark : m_allocated_size;
     return Fw::FW_SERIALIZE_OK;
 }
 
@@ -5,8 +5,9 @@
  * data store as the backing for this buffer. Thus it is dependent on receiving sole ownership
  * of the supplied buffer.
  *
- * Note: this given implementation loses one byte of the data store in order to ensure that a
- * separate wrap-around tracking variable is not needed.
+ * Data is copied in and out with at most two memcpy calls, one on each side of the wrap point.
+ * When the size of the data store is a power of two, indices wrap with a mask instead of a
+ * compare and subtract.
  *
  *  Created on: Apr 4, 2019
  *      Author: lestarch
@@ -97,6 +98,33 @@ class CircularBuffer {
      */
     Fw::SerializeStatus peek(U8* buffer, FwSizeType size, FwSizeType offset = 0) const;
 
+    /**
+     * Get the longest run of allocated data that starts at an offset from the head and is contiguous
+     * in the data store. Reading allocated data in place is done by reading this span, rotating by the
+     * amount consumed (or advancing the offset), and repeating, which takes at most two spans.
+     * \param size: (output) number of contiguous allocated bytes at the returned address, 0 when offset
+     *        is not less than the allocated size
+     * \param offset: offset from head of the first byte of the span. Default: 0
+     * \return address of the data at the offset
+     */
+    const U8* contiguous_read_span(FwSizeType& size, FwSizeType offset = 0) const;
+
+    /**
+     * Get the longest run of free space that starts after the allocated data and is contiguous in
+     * the data store. This allows a driver to read directly into the circular buffer, then call
+     * commit_write with the number of bytes written.
+     * \param size: (output) number of contiguous free bytes at the returned address, 0 when full
+     * \return address of the free space after the allocated data
+     */
+    U8* contiguous_write_span(FwSizeType& size);
+
+    /**
+     * Add bytes written into the span returned by contiguous_write_span to the allocated data.
+     * \param amount: number of bytes written, at most the size of the span
+     * \return Fw::FW_SERIALIZE_OK on success or something else on error
+     */
+    Fw::SerializeStatus commit_write(FwSizeType amount);
+
     /**
      * Rotate the head index, deleting data from the circular buffer and making
      * space. Cannot rotate more than the available space.
@@ -138,14 +166,32 @@ class CircularBuffer {
     /**
      * Returns a wrap-advanced index into the store.
      * \param idx: index to advance and wrap.
-     * \param amount: amount to advance
+     * \param amount: amount to advance, at most the size of the store
      * \return: new index value
      */
     FwSizeType advance_idx(FwSizeType idx, FwSizeType amount = 1) const;
+    /**
+     * Copy data into the store starting at an index, wrapping around the end of the store.
+     * \param idx: store index of the first byte to write
+     * \param source: data to copy in
+     * \param size: number of bytes to copy, at most the size of the store
+     */
+    void copy_in(FwSizeType idx, const U8* source, FwSizeType size);
+    /**
+     * Copy data out of the store starting at an index, wrapping around the end of the store.
+     * \param idx: store index of the first byte to read
+     * \param destination: buffer to fill
+     * \param size: number of bytes to copy, at most the size of the store
+     */
+    void copy_out(FwSizeType idx, U8* destination, FwSizeType size) const;
     //! Physical store backing this circular buffer
     U8* m_store;
     //! Size of the physical store
     FwSizeType m_store_size;
+    //! m_store_size - 1 when m_store_size is a power of two, used to wrap indices with a mask
+    FwSizeType m_idx_mask;
+    //! True when m_store_size is a power of two
+    bool m_masked;
     //! Index into m_store of byte zero in the logical store.
     //! When memory is deallocated, this index moves forward and wraps around.
     FwSizeType m_head_idx;
@@ -6,9 +6,9 @@
 // it relies on two restrictions to achieve these properties:
 //
 //    1. There may only be one producer thread, which is the thread
-//       that may call produce.
+//       that may call produce and produceBulk.
 //    2. There may only be one consumer thread, which is the thread
-//       that may call consume and peek.
+//       that may call consume, consumeBulk, and peek.
 //
 // For the purposes of this algorithm, an ISR can be considered to be a
 // thread. In addition, multiple threads could share the responsibility of
@@ -33,12 +33,32 @@
 // In addition, this algorithm does not dynamically allocate memory, making
 // it robust for hard-real-time environments.
 //
+// Performance notes:
+//
+//    1. The indices run freely and are mapped onto a power-of-two number of
+//       element slots with a mask. When CAPACITY is not a power of two, the
+//       slot array is rounded up to the next power of two and the queue still
+//       holds at most CAPACITY elements.
+//    2. The state written by the producer and the state written by the
+//       consumer are separated by FW_CACHE_LINE_SIZE bytes of padding, so the
+//       two threads do not contend for a cache line when touching their own
+//       index.
+//    3. Each side keeps a snapshot of the other side's index and only reloads
+//       it when the snapshot says the queue is full (producer) or empty
+//       (consumer), so most operations do not touch the other side's line.
+//    4. An index is published with a release store and read by the other side
+//       with an acquire load, which orders the element copy without a full
+//       fence.
+//
 // ======================================================================
 
 #ifndef UTILS_TYPES_SPSC_QUEUE_HPP
 #define UTILS_TYPES_SPSC_QUEUE_HPP
 
+#include <Fw/FPrimeBasicTypes.hpp>
+#include <Fw/Types/Assert.hpp>
 #include <atomic>
+#include <limits>
 
 namespace Types {
 
@@ -47,59 +67,102 @@ namespace Types {
 // and it's guaranteed to be unsigned, which is crucial.
 template <class E, FwSizeType CAPACITY>
 class SpscQueue {
-  public:
-    static_assert(CAPACITY * 2 <= std::numeric_limits<FwSizeType>::max(),
-                  "This implementation distinguishes full and empty queues by using indices modulo CAPACITY * 2, "
-                  "so CAPACITY * 2 must fit in the index type");
+  private:
+    //! Smallest power of two that is at least the capacity
+    static constexpr FwSizeType slotCount(FwSizeType capacity) {
+        FwSizeType slots = 1;
+        while (slots < capacity) {
+            slots *= 2;
+        }
+        return slots;
+    }
 
-    SpscQueue() : m_elements{}, m_nextProduceIdx(0), m_nextConsumeIdx(0) {
+  public:
+    static_assert(CAPACITY > 0, "SpscQueue must have a non-zero capacity");
+    static_assert(CAPACITY <= (std::numeric_limits<FwSizeType>::max() / 2) + 1,
+                  "The slot count is CAPACITY rounded up to a power of two, which must fit in the index type");
+
+    //! Number of element slots. The free-running indices wrap at a multiple of this value,
+    //! so masking them with SLOTS - 1 stays consistent across the wrap.
+    static constexpr FwSizeType SLOTS = slotCount(CAPACITY);
+
+    SpscQueue()
+        : m_nextProduceIdx(0),
+          m_cachedConsumeIdx(0),
+          m_producerPad{},
+          m_nextConsumeIdx(0),
+          m_cachedProduceIdx(0),
+          m_consumerPad{},
+          m_elements{} {
         FW_ASSERT(this->m_nextProduceIdx.is_lock_free() && this->m_nextConsumeIdx.is_lock_free());
     }
 
     bool isFull() const {
-        return countElements(this->m_nextProduceIdx.load(), this->m_nextConsumeIdx.load()) == CAPACITY;
+        return countElements(this->m_nextProduceIdx.load(std::memory_order_acquire),
+                             this->m_nextConsumeIdx.load(std::memory_order_acquire)) == CAPACITY;
     }
 
-    bool isEmpty() const { return countElements(this->m_nextProduceIdx.load(), this->m_nextConsumeIdx.load()) == 0; }
+    bool isEmpty() const {
+        return countElements(this->m_nextProduceIdx.load(std::memory_order_acquire),
+                             this->m_nextConsumeIdx.load(std::memory_order_acquire)) == 0;
+    }
 
     // May only be called by the single producer thread.
-    bool produce(const E& element) {
-        FwSizeType nextProduceIdx = this->m_nextProduceIdx.load();
-        FwSizeType nextConsumeIdx = this->m_nextConsumeIdx.load();
+    bool produce(const E& element) { return this->produceBulk(&element, 1) == 1; }
 
-        if (countElements(nextProduceIdx, nextConsumeIdx) == CAPACITY) {
-            return false;
+    // May only be called by the single producer thread.
+    // Copies up to count elements into the queue, in order, and returns the number copied.
+    FwSizeType produceBulk(const E* elements, FwSizeType count) {
+        FW_ASSERT((elements != nullptr) || (count == 0));
+        const FwSizeType nextProduceIdx = this->m_nextProduceIdx.load(std::memory_order_relaxed);
+        FwSizeType space = CAPACITY - countElements(nextProduceIdx, this->m_cachedConsumeIdx);
+        if (space < count) {
+            // the snapshot may be stale, so pick up the elements consumed since
+            this->m_cachedConsumeIdx = this->m_nextConsumeIdx.load(std::memory_order_acquire);
+            space = CAPACITY - countElements(nextProduceIdx, this->m_cachedConsumeIdx);
         }
-
-        this->m_elements[nextProduceIdx % CAPACITY] = element;
-        this->m_nextProduceIdx.store((nextProduceIdx + 1) % (CAPACITY * 2));
-        return true;
+        const FwSizeType produced = (count < space) ? count : space;
+        for (FwSizeType i = 0; i < produced; i++) {
+            this->m_elements[(nextProduceIdx + i) & (SLOTS - 1)] = elements[i];
+        }
+        if (produced > 0) {
+            this->m_nextProduceIdx.store(nextProduceIdx + produced, std::memory_order_release);
+        }
+        return produced;
     }
 
     // May only be called by the single consumer thread.
-    bool consume(E& elementOut) {
-        FwSizeType nextProduceIdx = this->m_nextProduceIdx.load();
-        FwSizeType nextConsumeIdx = this->m_nextConsumeIdx.load();
+    bool consume(E& elementOut) { return this->consumeBulk(&elementOut, 1) == 1; }
 
-        if (countElements(nextProduceIdx, nextConsumeIdx) == 0) {
-            return false;
+    // May only be called by the single consumer thread.
+    // Copies up to maxCount elements out of the queue, in order, and returns the number copied.
+    FwSizeType consumeBulk(E* elementsOut, FwSizeType maxCount) {
+        FW_ASSERT((elementsOut != nullptr) || (maxCount == 0));
+        const FwSizeType nextConsumeIdx = this->m_nextConsumeIdx.load(std::memory_order_relaxed);
+        FwSizeType available = countElements(this->m_cachedProduceIdx, nextConsumeIdx);
+        if (available < maxCount) {
+            // the snapshot may be stale, so pick up the elements produced since
+            this->m_cachedProduceIdx = this->m_nextProduceIdx.load(std::memory_order_acquire);
+            available = countElements(this->m_cachedProduceIdx, nextConsumeIdx);
         }
-
-        elementOut = this->m_elements[nextConsumeIdx % CAPACITY];
-        this->m_nextConsumeIdx.store((nextConsumeIdx + 1) % (CAPACITY * 2));
-        return true;
+        const FwSizeType consumed = (maxCount < available) ? maxCount : available;
+        for (FwSizeType i = 0; i < consumed; i++) {
+            elementsOut[i] = this->m_elements[(nextConsumeIdx + i) & (SLOTS - 1)];
+        }
+        if (consumed > 0) {
+            this->m_nextConsumeIdx.store(nextConsumeIdx + consumed, std::memory_order_release);
+        }
+        return consumed;
     }
 
     // May only be called by the single consumer thread.
     bool peek(E& elementOut) const {
-        FwSizeType nextProduceIdx = this->m_nextProduceIdx.load();
-        FwSizeType nextConsumeIdx = this->m_nextConsumeIdx.load();
-
-        if (countElements(nextProduceIdx, nextConsumeIdx) == 0) {
+        const FwSizeType nextConsumeIdx = this->m_nextConsumeIdx.load(std::memory_order_relaxed);
+        if (countElements(this->m_nextProduceIdx.load(std::memory_order_acquire), nextConsumeIdx) == 0) {
             return false;
         }
 
-        elementOut = this->m_elements[nextConsumeIdx % CAPACITY];
+        elementOut = this->m_elements[nextConsumeIdx & (SLOTS - 1)];
         return true;
     }
 
@@ -110,13 +173,24 @@ class SpscQueue {
     }
 
   private:
-    E m_elements[CAPACITY];
+    // Written by the producer
     std::atomic<FwSizeType> m_nextProduceIdx;
+    FwSizeType m_cachedConsumeIdx;  //!< producer's snapshot of m_nextConsumeIdx
+    U8 m_producerPad[FW_CACHE_LINE_SIZE];
+
+    // Written by the consumer
     std::atomic<FwSizeType> m_nextConsumeIdx;
+    FwSizeType m_cachedProduceIdx;  //!< consumer's snapshot of m_nextProduceIdx
+    U8 m_consumerPad[FW_CACHE_LINE_SIZE];
+
+    E m_elements[SLOTS];
 
     static FwSizeType countElements(FwSizeType nextProduceIdx, FwSizeType nextConsumeIdx) {
-        FwSizeType count = (nextProduceIdx - nextConsumeIdx + CAPACITY * 2) % (CAPACITY * 2);
-        FW_ASSERT(count <= CAPACITY, nextProduceIdx, nextConsumeIdx, count, CAPACITY);
+        // unsigned subtraction gives the distance even after the indices wrap
+        FwSizeType count = nextProduceIdx - nextConsumeIdx;
+        FW_ASSERT(count <= CAPACITY, static_cast<FwAssertArgType>(nextProduceIdx),
+                  static_cast<FwAssertArgType>(nextConsumeIdx), static_cast<FwAssertArgType>(count),
+                  static_cast<FwAssertArgType>(CAPACITY));
         return count;
     }
 };
@@ -6,16 +6,21 @@
  *  Created on: May 23, 2019
  *      Author: mstarch
  */
+#include <STest/Pick/Pick.hpp>
 #include <STest/Scenario/BoundedScenario.hpp>
 #include <STest/Scenario/RandomScenario.hpp>
 #include <STest/Scenario/Scenario.hpp>
 
 #include <gtest/gtest.h>
 #include <Fw/Test/UnitTest.hpp>
+#include <Fw/Types/Assert.hpp>
 #include <Utils/Types/test/ut/CircularBuffer/CircularRules.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <vector>
 
 #define STEP_COUNT 1000
 
@@ -177,6 +182,208 @@ TEST(CircularBufferTests, BoundaryCases) {
     serializeOk.apply(state);
 }
 
+/**
+ * Test that spans expose the allocated data and free space on each side of the wrap point
+ */
+TEST(CircularBufferTests, ContiguousSpans) {
+    // Cover both the masked (power of two) and unmasked index wrap
+    const FwSizeType store_sizes[] = {16, 13};
+    for (const FwSizeType store_size : store_sizes) {
+        U8 store[16];
+        Types::CircularBuffer circular_buffer(store, store_size);
+        U8 expected = 0;
+        U8 next = 0;
+        for (U32 round = 0; round < 100; round++) {
+            // Fill the free space through write spans, which takes at most two spans
+            FwSizeType spans = 0;
+            FwSizeType span_size = 0;
+            U8* write_span = circular_buffer.contiguous_write_span(span_size);
+            while (span_size > 0) {
+                for (FwSizeType i = 0; i < span_size; i++) {
+                    write_span[i] = next++;
+                }
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK, circular_buffer.commit_write(span_size));
+                spans++;
+                write_span = circular_buffer.contiguous_write_span(span_size);
+            }
+            ASSERT_LE(spans, 2U);
+            ASSERT_EQ(0U, circular_buffer.get_free_size());
+            ASSERT_EQ(Fw::FW_SERIALIZE_NO_ROOM_LEFT, circular_buffer.commit_write(1));
+
+            // Read spans starting at an offset cover the data past the offset, in at most two spans
+            const FwSizeType offset = round % (store_size + 1);
+            FwSizeType offset_spans = 0;
+            U8 offset_expected = static_cast<U8>(expected + offset);
+            for (FwSizeType read = offset; read < store_size; read += span_size) {
+                const U8* read_span = circular_buffer.contiguous_read_span(span_size, read);
+                ASSERT_GT(span_size, 0U);
+                for (FwSizeType i = 0; i < span_size; i++) {
+                    ASSERT_EQ(offset_expected++, read_span[i]);
+                }
+                offset_spans++;
+            }
+            ASSERT_LE(offset_spans, 2U);
+            (void)circular_buffer.contiguous_read_span(span_size, store_size);
+            ASSERT_EQ(0U, span_size);
+
+            // Drain a varying amount through read spans so the head lands everywhere in the store
+            FwSizeType drain = 1 + (round % store_size);
+            while (drain > 0) {
+                const U8* read_span = circular_buffer.contiguous_read_span(span_size);
+                ASSERT_GT(span_size, 0U);
+                const FwSizeType amount = FW_MIN(span_size, drain);
+                for (FwSizeType i = 0; i < amount; i++) {
+                    ASSERT_EQ(expected++, read_span[i]);
+                }
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK, circular_buffer.rotate(amount));
+                drain -= amount;
+            }
+        }
+    }
+}
+
+namespace {
+
+// Stream shape for the stream tests
+const FwSizeType STREAM_CHUNK = 1024;
+const FwSizeType STREAM_STORE = 4096;
+
+/**
+ * Reference ring using the per-byte copy loop CircularBuffer used before the memcpy implementation
+ */
+class ByteLoopRing {
+  public:
+    ByteLoopRing(U8* store, FwSizeType size) : m_store(store), m_size(size), m_head(0), m_allocated(0) {}
+
+    bool serialize(const U8* buffer, FwSizeType size) {
+        if (size > m_size - m_allocated) {
+            return false;
+        }
+        FwSizeType idx = advance(m_head, m_allocated);
+        for (FwSizeType i = 0; i < size; i++) {
+            FW_ASSERT(idx < m_size, static_cast<FwAssertArgType>(idx));
+            m_store[idx] = buffer[i];
+            idx = advance(idx);
+        }
+        m_allocated += size;
+        return true;
+    }
+
+    bool peek(U8* buffer, FwSizeType size) const {
+        if (size > m_allocated) {
+            return false;
+        }
+        FwSizeType idx = m_head;
+        for (FwSizeType i = 0; i < size; i++) {
+            FW_ASSERT(idx < m_size, static_cast<FwAssertArgType>(idx));
+            buffer[i] = m_store[idx];
+            idx = advance(idx);
+        }
+        return true;
+    }
+
+    void rotate(FwSizeType amount) {
+        m_head = advance(m_head, amount);
+        m_allocated -= amount;
+    }
+
+  private:
+    FwSizeType advance(FwSizeType idx, FwSizeType amount = 1) const {
+        FW_ASSERT(idx < m_size, static_cast<FwAssertArgType>(idx));
+        return (idx + amount) % m_size;
+    }
+    U8* m_store;
+    FwSizeType m_size;
+    FwSizeType m_head;
+    FwSizeType m_allocated;
+};
+
+/**
+ * Push a stream through a ring in chunks that do not divide the store size, so copies regularly straddle the wrap
+ * point, and return the throughput in MB/s
+ */
+template <class Ring>
+F64 stream_through(Ring& ring, const std::vector<U8>& stream, std::vector<U8>& output) {
+    const FwSizeType write_chunk = STREAM_CHUNK + 3;
+    FwSizeType written = 0;
+    FwSizeType read = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (read < stream.size()) {
+        const FwSizeType write_size = FW_MIN(write_chunk, stream.size() - written);
+        if ((write_size > 0) && ring.serialize(&stream[written], write_size)) {
+            written += write_size;
+        }
+        const FwSizeType read_size = FW_MIN(STREAM_CHUNK, written - read);
+        if (ring.peek(&output[read], read_size)) {
+            ring.rotate(read_size);
+            read += read_size;
+        }
+    }
+    const std::chrono::duration<F64> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<F64>(stream.size()) / elapsed.count() / (1024.0 * 1024.0);
+}
+
+/**
+ * Adapts CircularBuffer to the bool interface used by stream_through
+ */
+class CircularRing {
+  public:
+    CircularRing(U8* store, FwSizeType size) : m_buffer(store, size) {}
+    bool serialize(const U8* buffer, FwSizeType size) {
+        return m_buffer.serialize(buffer, size) == Fw::FW_SERIALIZE_OK;
+    }
+    bool peek(U8* buffer, FwSizeType size) const { return m_buffer.peek(buffer, size) == Fw::FW_SERIALIZE_OK; }
+    void rotate(FwSizeType amount) { ASSERT_EQ(Fw::FW_SERIALIZE_OK, m_buffer.rotate(amount)); }
+
+  private:
+    Types::CircularBuffer m_buffer;
+};
+
+/**
+ * Stream random data through the per-byte copy loop and CircularBuffer, checking both deliver it intact, and
+ * optionally print their throughput
+ */
+void stream_compare(FwSizeType stream_size, bool report) {
+    std::vector<U8> stream(stream_size);
+    for (FwSizeType i = 0; i < stream.size(); i++) {
+        stream[i] = static_cast<U8>(STest::Pick::lowerUpper(0, 0xFF));
+    }
+    // Cover both the masked (power of two) and unmasked index wrap
+    const FwSizeType store_sizes[] = {STREAM_STORE, STREAM_STORE - 1};
+    for (const FwSizeType store_size : store_sizes) {
+        std::vector<U8> store(store_size);
+        std::vector<U8> output(stream_size);
+
+        ByteLoopRing byte_loop(store.data(), store_size);
+        const F64 byte_loop_rate = stream_through(byte_loop, stream, output);
+        ASSERT_EQ(stream, output);
+
+        std::fill(output.begin(), output.end(), 0);
+        CircularRing circular(store.data(), store_size);
+        const F64 circular_rate = stream_through(circular, stream, output);
+        ASSERT_EQ(stream, output);
+
+        if (report) {
+            printf("CircularBuffer store %" PRI_FwSizeType ": byte loop %.1f MB/s, memcpy %.1f MB/s\n", store_size,
+                   byte_loop_rate, circular_rate);
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * Check serialize/peek against the per-byte copy loop on a stream that wraps the store many times
+ */
+TEST(CircularBufferTests, StreamRoundTrip) {
+    stream_compare(256 * 1024, false);
+}
+
+// Throughput benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(CircularBufferTests, DISABLED_StreamThroughput) {
+    stream_compare(16 * 1024 * 1024, true);
+}
+
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     STest::Random::seed();
@@ -0,0 +1,233 @@
+// ======================================================================
+// \title  SpscQueueTest.cpp
+// \brief  Unit tests and throughput benchmark for Types::SpscQueue
+// ======================================================================
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Task.hpp>
+#include <STest/Pick/Pick.hpp>
+#include <STest/Random/Random.hpp>
+#include <Utils/Types/SpscQueue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+// Queue shape for the concurrent tests and the benchmark
+static const FwSizeType BENCH_CAPACITY = 1024;
+static const FwSizeType BENCH_BATCH = 32;
+// Messages passed by the concurrent tests in the default suite and by the opt-in benchmark
+static const U32 CONCURRENT_MESSAGES = 100000;
+static const U32 BENCH_MESSAGES = 10000000;
+
+typedef Types::SpscQueue<U32, BENCH_CAPACITY> BenchQueue;
+
+//! State shared between the benchmark tasks
+struct BenchData {
+    BenchQueue queue;
+    bool bulk;       //!< use produceBulk/consumeBulk rather than produce/consume
+    U32 messages;    //!< number of messages to pass through the queue
+    U32 outOfOrder;  //!< number of messages the consumer received out of sequence
+};
+
+void producerTask(void* arg) {
+    BenchData& data = *static_cast<BenchData*>(arg);
+    U32 next = 0;
+    if (data.bulk) {
+        U32 batch[BENCH_BATCH];
+        while (next < data.messages) {
+            FwSizeType count = 0;
+            while ((count < BENCH_BATCH) and (next + count < data.messages)) {
+                batch[count] = next + static_cast<U32>(count);
+                count++;
+            }
+            const FwSizeType produced = data.queue.produceBulk(batch, count);
+            if (produced == 0) {
+                // queue is full; let the consumer run if it shares the CPU
+                std::this_thread::yield();
+            }
+            next += static_cast<U32>(produced);
+        }
+    } else {
+        while (next < data.messages) {
+            if (data.queue.produce(next)) {
+                next++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+void consumerTask(void* arg) {
+    BenchData& data = *static_cast<BenchData*>(arg);
+    U32 expected = 0;
+    if (data.bulk) {
+        U32 batch[BENCH_BATCH];
+        while (expected < data.messages) {
+            const FwSizeType count = data.queue.consumeBulk(batch, BENCH_BATCH);
+            if (count == 0) {
+                // queue is empty; let the producer run if it shares the CPU
+                std::this_thread::yield();
+            }
+            for (FwSizeType i = 0; i < count; i++) {
+                data.outOfOrder += (batch[i] != expected) ? 1 : 0;
+                expected++;
+            }
+        }
+    } else {
+        U32 value = 0;
+        while (expected < data.messages) {
+            if (data.queue.consume(value)) {
+                data.outOfOrder += (value != expected) ? 1 : 0;
+                expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+//! Run producer and consumer tasks and check that every message arrives in order. When pinned, the tasks run on
+//! different CPUs, falling back to unpinned tasks when the process lacks permission.
+//! \return elapsed time in seconds
+double runTasks(bool bulk, U32 messages, bool pinned) {
+    // the queue is larger than a task stack should hold, so keep it off the stack
+    static BenchData data;
+    data.bulk = bulk;
+    data.messages = messages;
+    data.outOfOrder = 0;
+    EXPECT_TRUE(data.queue.isEmpty());
+
+    Os::Task consumer;
+    Os::Task producer;
+    Os::Task::Arguments consumerArgs(Fw::String("SpscConsumer"), consumerTask, &data, Os::Task::TASK_PRIORITY_DEFAULT,
+                                     Os::Task::TASK_DEFAULT, pinned ? 0 : Os::Task::TASK_DEFAULT);
+    Os::Task::Arguments producerArgs(Fw::String("SpscProducer"), producerTask, &data, Os::Task::TASK_PRIORITY_DEFAULT,
+                                     Os::Task::TASK_DEFAULT, pinned ? 1 : Os::Task::TASK_DEFAULT);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(Os::Task::OP_OK, consumer.start(consumerArgs));
+    EXPECT_EQ(Os::Task::OP_OK, producer.start(producerArgs));
+    EXPECT_EQ(Os::Task::OP_OK, producer.join());
+    EXPECT_EQ(Os::Task::OP_OK, consumer.join());
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(0U, data.outOfOrder);
+    EXPECT_TRUE(data.queue.isEmpty());
+    return elapsed.count();
+}
+
+//! Report messages per second between producer and consumer tasks pinned to different CPUs
+void runBenchmark(bool bulk) {
+    const double elapsed = runTasks(bulk, BENCH_MESSAGES, true);
+    (void)printf("SpscQueue %s: %u messages in %.3f s, %.1f million messages/s\n", bulk ? "bulk" : "single",
+                 static_cast<unsigned int>(BENCH_MESSAGES), elapsed,
+                 static_cast<double>(BENCH_MESSAGES) / elapsed / 1.0e6);
+}
+
+}  // namespace
+
+TEST(SpscQueueTest, ProduceConsume) {
+    Types::SpscQueue<U32, 4> queue;
+    U32 value = 0;
+    ASSERT_TRUE(queue.isEmpty());
+    ASSERT_FALSE(queue.consume(value));
+    ASSERT_FALSE(queue.peek(value));
+    for (U32 i = 0; i < 4; i++) {
+        ASSERT_FALSE(queue.isFull());
+        ASSERT_TRUE(queue.produce(i));
+    }
+    ASSERT_TRUE(queue.isFull());
+    ASSERT_FALSE(queue.produce(99));
+    ASSERT_TRUE(queue.peek(value));
+    ASSERT_EQ(0U, value);
+    for (U32 i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.consume(value));
+        ASSERT_EQ(i, value);
+    }
+    ASSERT_TRUE(queue.isEmpty());
+    ASSERT_FALSE(queue.consume());
+}
+
+TEST(SpscQueueTest, NonPowerOfTwoCapacity) {
+    // capacity 5 uses 8 slots but must still hold exactly 5 elements across many wraps
+    Types::SpscQueue<U32, 5> queue;
+    static_assert(Types::SpscQueue<U32, 5>::SLOTS == 8, "slots should round up to a power of two");
+    U32 next = 0;
+    U32 expected = 0;
+    for (U32 round = 0; round < 100; round++) {
+        while (queue.produce(next)) {
+            next++;
+        }
+        ASSERT_EQ(5U, next - expected);
+        ASSERT_TRUE(queue.isFull());
+        // drain a varying amount so the indices land everywhere in the slot array
+        const U32 drain = 1 + (round % 5);
+        for (U32 i = 0; i < drain; i++) {
+            U32 value = 0;
+            ASSERT_TRUE(queue.consume(value));
+            ASSERT_EQ(expected, value);
+            expected++;
+        }
+    }
+}
+
+TEST(SpscQueueTest, Bulk) {
+    static const FwSizeType CAPACITY = 16;
+    Types::SpscQueue<U32, CAPACITY> queue;
+    U32 in[CAPACITY + 4];
+    U32 out[CAPACITY + 4];
+    U32 next = 0;
+    U32 expected = 0;
+    FwSizeType held = 0;
+    for (U32 iteration = 0; iteration < 10000; iteration++) {
+        const FwSizeType count = STest::Pick::lowerUpper(0, CAPACITY + 4);
+        if (STest::Pick::lowerUpper(0, 1) == 0) {
+            for (FwSizeType i = 0; i < count; i++) {
+                in[i] = next + static_cast<U32>(i);
+            }
+            // a bulk produce copies as many elements as fit
+            const FwSizeType produced = queue.produceBulk(in, count);
+            ASSERT_EQ(std::min(count, CAPACITY - held), produced);
+            next += static_cast<U32>(produced);
+            held += produced;
+        } else {
+            const FwSizeType consumed = queue.consumeBulk(out, count);
+            ASSERT_EQ(std::min(count, held), consumed);
+            for (FwSizeType i = 0; i < consumed; i++) {
+                ASSERT_EQ(expected, out[i]);
+                expected++;
+            }
+            held -= consumed;
+        }
+        ASSERT_EQ(held == CAPACITY, queue.isFull());
+        ASSERT_EQ(held == 0, queue.isEmpty());
+    }
+}
+
+TEST(SpscQueueTest, ConcurrentSingle) {
+    (void)runTasks(false, CONCURRENT_MESSAGES, false);
+}
+
+TEST(SpscQueueTest, ConcurrentBulk) {
+    (void)runTasks(true, CONCURRENT_MESSAGES, false);
+}
+
+// Throughput benchmarks, run on request with --gtest_also_run_disabled_tests
+TEST(SpscQueueTest, DISABLED_ThroughputSingle) {
+    runBenchmark(false);
+}
+
+TEST(SpscQueueTest, DISABLED_ThroughputBulk) {
+    runBenchmark(true);
+}
+
+int main(int argc, char** argv) {
+    STest::Random::seed();
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------
+// CRC32EngineTests.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <STest/Random/Random.hpp>
+#include <Utils/Hash/Hash.hpp>
+#include <Utils/Hash/libcrc/CRC32Engine.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+#include <Utils/Hash/libcrc/lib_crc.h>
+}
+
+namespace {
+
+// Data shape for the chunked comparison in the default suite and the opt-in throughput benchmark
+const FwSizeType CHECK_SIZE = 1024 * 1024;
+const FwSizeType BENCH_SIZE = 64 * 1024 * 1024;
+const FwSizeType BENCH_CHUNK = 1024;
+
+//! Reference CRC register update, one byte at a time through lib_crc
+U32 byteLoop(U32 crc, const U8* data, FwSizeType len) {
+    for (FwSizeType i = 0; i < len; i++) {
+        crc = static_cast<U32>(update_crc_32(crc, static_cast<char>(data[i])));
+    }
+    return crc;
+}
+
+std::vector<U8> randomData(FwSizeType size) {
+    std::vector<U8> data(size);
+    for (FwSizeType i = 0; i < size; i++) {
+        data[i] = static_cast<U8>(STest::Random::lowerUpper(0, 0xFF));
+    }
+    return data;
+}
+
+//! Hash the data in BENCH_CHUNK chunks, as the framework hashes frames and files
+template <typename Update>
+U32 hashChunks(const std::vector<U8>& data, Update update) {
+    U32 crc = 0xFFFFFFFF;
+    for (FwSizeType offset = 0; offset < data.size(); offset += BENCH_CHUNK) {
+        crc = update(crc, &data[offset], BENCH_CHUNK);
+    }
+    return crc;
+}
+
+//! Hash the data in BENCH_CHUNK chunks and report MB/s
+template <typename Update>
+F64 throughput(const std::vector<U8>& data, U32& crc, Update update) {
+    const auto start = std::chrono::steady_clock::now();
+    crc = hashChunks(data, update);
+    const std::chrono::duration<F64> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<F64>(data.size()) / elapsed.count() / 1.0e6;
+}
+
+}  // namespace
+
+TEST(CRC32EngineTest, CheckValue) {
+    // Standard CRC32 check value of "123456789"
+    const char check[] = "123456789";
+    U32 value = 0;
+    Utils::Hash hash;
+    hash.update(check, sizeof(check) - 1);
+    hash.final(value);
+    ASSERT_EQ(0xCBF43926U, value);
+    Utils::HashBuffer buffer;
+    Utils::Hash::hash(check, sizeof(check) - 1, buffer);
+    ASSERT_EQ(0xCBF43926U, buffer.asBigEndianU32());
+}
+
+TEST(CRC32EngineTest, MatchesByteLoop) {
+    // Cover every length and alignment around the block sizes of each implementation
+    const std::vector<U8> data = randomData(4096 + 16);
+    for (FwSizeType len = 0; len <= 300; len++) {
+        for (FwSizeType offset = 0; offset < 16; offset++) {
+            const U32 crc = STest::Random::lowerUpper(0, 0xFFFFFFFF);
+            const U32 expected = byteLoop(crc, &data[offset], len);
+            ASSERT_EQ(expected, Utils::CRC32Engine::updateSliceBy8(crc, &data[offset], len)) << len << " " << offset;
+            ASSERT_EQ(expected, Utils::CRC32Engine::update(crc, &data[offset], len)) << len << " " << offset;
+        }
+    }
+    // Large blocks split into random pieces give the same CRC as a single pass
+    for (U32 iteration = 0; iteration < 100; iteration++) {
+        const FwSizeType len = STest::Random::lowerUpper(0, 4096);
+        const U32 expected = byteLoop(0xFFFFFFFF, data.data(), len);
+        U32 crc = 0xFFFFFFFF;
+        FwSizeType done = 0;
+        while (done < len) {
+            const FwSizeType pick = STest::Random::lowerUpper(1, 1024);
+            const FwSizeType piece = FW_MIN(len - done, pick);
+            crc = Utils::CRC32Engine::update(crc, &data[done], piece);
+            done += piece;
+        }
+        ASSERT_EQ(expected, crc) << len;
+    }
+}
+
+TEST(CRC32EngineTest, MatchesByteLoopInChunks) {
+    const std::vector<U8> data = randomData(CHECK_SIZE);
+    const U32 expected = hashChunks(data, byteLoop);
+    ASSERT_EQ(expected, hashChunks(data, Utils::CRC32Engine::updateSliceBy8));
+    ASSERT_EQ(expected, hashChunks(data, Utils::CRC32Engine::update));
+}
+
+// Throughput benchmark, run on request with --gtest_also_run_disabled_tests
+TEST(CRC32EngineTest, DISABLED_Throughput) {
+    const std::vector<U8> data = randomData(BENCH_SIZE);
+    U32 byte_loop_crc = 0;
+    U32 slice_crc = 0;
+    U32 engine_crc = 0;
+    const F64 byte_loop_rate = throughput(data, byte_loop_crc, byteLoop);
+    const F64 slice_rate = throughput(data, slice_crc, Utils::CRC32Engine::updateSliceBy8);
+    const F64 engine_rate = throughput(data, engine_crc, Utils::CRC32Engine::update);
+    ASSERT_EQ(byte_loop_crc, slice_crc);
+    ASSERT_EQ(byte_loop_crc, engine_crc);
+
+    static const char* const NAMES[] = {"slice-by-8", "pclmul", "arm crc"};
+    (void)printf("CRC32 %u MB in %u byte chunks: byte loop %.1f MB/s, slice-by-8 %.1f MB/s, %s %.1f MB/s\n",
+                 static_cast<unsigned int>(BENCH_SIZE / (1024 * 1024)), static_cast<unsigned int>(BENCH_CHUNK),
+                 byte_loop_rate, slice_rate, NAMES[Utils::CRC32Engine::implementation()], engine_rate);
+}
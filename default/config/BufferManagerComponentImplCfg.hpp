@@ -2,9 +2,11 @@
 #define __BUFFERMANAGERCOMPONENTIMPLCFG_HPP__
 
 #include <Fw/FPrimeBasicTypes.hpp>
+#include <config/FppConstantsAc.hpp>
 
 namespace Svc {
-static const U16 BUFFERMGR_MAX_NUM_BINS = 10;
+// Set by BufferManagerMaxNumBins in AcConstants.fpp so it also sizes the per-bin telemetry
+static const U16 BUFFERMGR_MAX_NUM_BINS = BufferManagerMaxNumBins;
 }
 
 #endif  // __BUFFERMANAGERCOMPONENTIMPLCFG_HPP__
@@ -15,6 +15,9 @@ namespace Svc {
 // this size.
 static const FwIndexType DP_MAX_DIRECTORIES = 2;
 static const FwIndexType DP_MAX_FILES = 127;
+// Number of tasks that read data product file headers in parallel during
+// a catalog build once DpCatalog::startScanTasks() is called
+static const FwIndexType DP_SCAN_TASKS = 4;
 }  // namespace Svc
 
 #endif /* SVC_DPCATALOG_CONFIG_HPP_ */
@@ -22,6 +22,17 @@ static const bool FILEDOWNLINK_COMMAND_FAILURES_DISABLED = true;
 // Size of the internal file downlink buffer. This must now be static as
 // file down maintains its own internal buffer.
 static const U32 FILEDOWNLINK_INTERNAL_BUFFER_SIZE = FW_FILE_BUFFER_MAX_SIZE;
+// Number of file packets that may be sent before their buffers are returned. Each packet in flight
+// uses its own internal buffer, so the component holds this many buffers of the size above. A window
+// of 1 sends one packet per round trip through the downstream components.
+static const U32 FILEDOWNLINK_WINDOW_SIZE = 4;
+// Time (in ms) to wait in IDLE for buffers still in flight from a failed downlink before starting the next file.
+// Buffers not returned in that time stay out of service, shrinking the window, until they are returned.
+static const U32 FILEDOWNLINK_BUFFER_RETURN_TIMEOUT = 10000;
+// Size of each of the two blocks read ahead of packetization. Files are read in blocks of this size
+// aligned to this size, so that data packets are copied from memory instead of each costing a read.
+// The component holds two blocks so that a packet spanning a block boundary needs no second read.
+static const U32 FILEDOWNLINK_READ_AHEAD_BLOCK_SIZE = 4096;
 
 }  // namespace Svc
 
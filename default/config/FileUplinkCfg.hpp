@@ -0,0 +1,27 @@
+/*
+ * FileUplinkCfg.hpp:
+ *
+ * Configuration settings for file uplink component.
+ */
+
+#ifndef SVC_FILEUPLINK_FILEUPLINKCFG_HPP_
+#define SVC_FILEUPLINK_FILEUPLINKCFG_HPP_
+#include <Fw/FPrimeBasicTypes.hpp>
+
+namespace Svc {
+
+// Maximum number of disjoint byte ranges of the file being uplinked that are tracked as received. Packets may
+// arrive in any order; a packet that would open a new range when this many are tracked is dropped and left as a
+// gap, which the ground must resend when FileUplink::setWaitForResend is on. Each range costs two file offsets of
+// storage.
+static const U32 FILEUPLINK_MAX_EXTENTS = 32;
+// Number of received data packets that may wait in the write-behind queue once the write-behind task is started.
+// Each queued packet is copied into the staging arena below, so its buffer is returned before the data reaches the
+// file. Packets wait for space only when the queue or the arena is full.
+static const U32 FILEUPLINK_WRITE_BEHIND_QUEUE_DEPTH = 16;
+// Size in bytes of the write-behind staging arena. It must hold at least the data of one packet.
+static const U32 FILEUPLINK_WRITE_BEHIND_ARENA_SIZE = 16 * FW_FILE_BUFFER_MAX_SIZE;
+
+}  // namespace Svc
+
+#endif /* SVC_FILEUPLINK_FILEUPLINKCFG_HPP_ */
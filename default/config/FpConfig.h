@@ -154,6 +154,12 @@ extern "C" {
 #define POSIX_THREADS_ENABLE_NAMES (1)  //!< Enable/Disable assigning names to threads
 #endif
 
+// Size in bytes of a data cache line on the target. Data written by different threads can be
+// separated by this many bytes so that the threads do not contend for the same line.
+#ifndef FW_CACHE_LINE_SIZE
+#define FW_CACHE_LINE_SIZE (64)  //!< Data cache line size in bytes
+#endif
+
 // *** NOTE configuration checks are in Fw/Cfg/ConfigCheck.cpp in order to have
 // the type definitions in Fw/Types/BasicTypes available.
 #ifdef __cplusplus
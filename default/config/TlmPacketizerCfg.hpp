@@ -27,6 +27,10 @@ static const FwChanIdType TLMPACKETIZER_HASH_MOD_VALUE = 99;  // !< The modulo v
 // Buckets must be >= number of telemetry channels in system
 static const FwChanIdType TLMPACKETIZER_HASH_BUCKETS = 1000;  // !< Buckets assignable to a hash slot.
 
+// Placements must be >= total number of channel entries in all packets. A channel
+// that is in more than one packet uses one placement per packet.
+static const FwChanIdType TLMPACKETIZER_MAX_CHANNEL_PLACEMENTS = 2000;  // !< Channel placements in packets
+
 static const FwChanIdType TLMPACKETIZER_MAX_MISSING_TLM_CHECK = 25;  // !< Max number of missing channel checks
 
 // packet update mode